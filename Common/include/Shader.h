@@ -7,6 +7,8 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 
 //GLAD
 #include <glad/glad.h>
@@ -20,6 +22,8 @@ class Shader
 {
 public:
 	GLuint ID;
+	// Locations of the active uniforms, read once after linking (see reflectUniforms())
+	std::unordered_map<std::string, GLint> uniformLocations;
 	// Constructor generates the shader on the fly
 	Shader(const GLchar* vertexPath, const GLchar* fragmentPath)
 	{
@@ -95,6 +99,38 @@ public:
 		glDeleteShader(vertex);
 		glDeleteShader(fragment);
 
+		reflectUniforms();
+	}
+	// Reads every active uniform with glGetActiveUniform and stores its location, so the
+	// setters below never ask the driver. Array uniforms are stored without the "[0]" suffix
+	void reflectUniforms()
+	{
+		uniformLocations.clear();
+		GLint count = 0, maxLength = 0;
+		glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		std::vector<GLchar> name(maxLength > 0 ? maxLength : 1);
+		for (GLint i = 0; i < count; ++i)
+		{
+			GLsizei length = 0;
+			GLint size;
+			GLenum type;
+			glGetActiveUniform(this->ID, (GLuint)i, maxLength, &length, &size, &type, name.data());
+			std::string uniformName(name.data(), length);
+			GLint location = glGetUniformLocation(this->ID, uniformName.c_str());
+			if (location < 0)
+				continue; // Member of a uniform block
+			if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+				uniformName.resize(uniformName.size() - 3);
+			uniformLocations[uniformName] = location;
+		}
+	}
+	// Cached location of a uniform (-1 if it is not active: glUniform* ignores it).
+	// Hot loops should keep the returned location and use the GLint overloads below
+	GLint getUniformLocation(const std::string& name) const
+	{
+		auto it = uniformLocations.find(name);
+		return it != uniformLocations.end() ? it->second : -1;
 	}
 	// Uses the current shader
 	void Use()
@@ -104,32 +140,58 @@ public:
 
 	void setBool(const std::string& name, bool value) const
 	{
-		glUniform1i(glGetUniformLocation(this->ID, name.c_str()), (int)value);
+		setBool(getUniformLocation(name), value);
 	}
 	// ------------------------------------------------------------------------
 	void setInt(const std::string& name, int value) const
 	{
-		glUniform1i(glGetUniformLocation(this->ID, name.c_str()), value);
+		setInt(getUniformLocation(name), value);
 	}
 	// ------------------------------------------------------------------------
 	void setFloat(const std::string& name, float value) const
 	{
-		glUniform1f(glGetUniformLocation(this->ID, name.c_str()), value);
+		setFloat(getUniformLocation(name), value);
 	}
 	// ------------------------------------------------------------------------
 	void setVec3(const std::string& name, float v1, float v2, float v3) const
 	{
-		glUniform3f(glGetUniformLocation(this->ID, name.c_str()), v1, v2, v3);
+		setVec3(getUniformLocation(name), v1, v2, v3);
 	}
 
 	void setVec4(const std::string& name, float v1, float v2, float v3, float v4) const
 	{
-		glUniform4f(glGetUniformLocation(this->ID, name.c_str()), v1, v2, v3,v4);
+		setVec4(getUniformLocation(name), v1, v2, v3, v4);
 	}
 
 	void setMat4(const std::string& name, float *v) const
 	{
-		glUniformMatrix4fv(glGetUniformLocation(this->ID, name.c_str()), 1, GL_FALSE, v);
+		setMat4(getUniformLocation(name), v);
+	}
+
+	// Same setters taking a location from getUniformLocation(): no lookup at all
+	void setBool(GLint location, bool value) const
+	{
+		glUniform1i(location, (int)value);
+	}
+	void setInt(GLint location, int value) const
+	{
+		glUniform1i(location, value);
+	}
+	void setFloat(GLint location, float value) const
+	{
+		glUniform1f(location, value);
+	}
+	void setVec3(GLint location, float v1, float v2, float v3) const
+	{
+		glUniform3f(location, v1, v2, v3);
+	}
+	void setVec4(GLint location, float v1, float v2, float v3, float v4) const
+	{
+		glUniform4f(location, v1, v2, v3, v4);
+	}
+	void setMat4(GLint location, float *v) const
+	{
+		glUniformMatrix4fv(location, 1, GL_FALSE, v);
 	}
 };
 
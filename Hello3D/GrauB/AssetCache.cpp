@@ -0,0 +1,534 @@
+// AssetCache.cpp
+#include "AssetCache.h" // Inclui o arquivo de cabeçalho do cache de assets
+
+#include <atomic>			// Estatísticas e nomes temporários (carga em várias threads)
+#include <cstddef>		// offsetof
+#include <cstdio>			// std::snprintf
+#include <cstring>		// memcpy
+#include <filesystem> // create_directories / rename / weakly_canonical
+#include <fstream>		// Gravação das entradas
+#include <iostream>		// Saída de dados no console
+
+#include "MeshOptimizer.h"			// optimizeMesh
+#include "ObjLoader.h"					// parseObj / indexObj
+#include "TextureCompressor.h" // compressTexture
+
+bool assetCacheEnabled = true;
+
+// Cabeçalho comum a todas as entradas
+struct AssetHeader
+{
+	char magic[4];									// "GEOM", "MTRL" ou "TEXR"
+	unsigned int version;						// ASSET_CACHE_VERSION de quem gravou
+	unsigned long long sourceHash;	// Hash do arquivo de origem (também é o nome da entrada)
+	unsigned long long payloadSize; // Bytes após o cabeçalho
+};
+
+struct GeometryHeader
+{
+	unsigned int vertexCount, indexCount, indexSize;
+	unsigned int vertexLayout; // MeshVertexLayout::signature() de quem gravou
+	VertexBounds bounds;
+	BoundingSphere sphere;
+	unsigned int lodCount;
+	MeshLod lods[MESH_LOD_MAX];
+	unsigned int meshletCount; // Meshlet[] logo depois do cabeçalho
+};
+
+struct TextureHeader
+{
+	unsigned int width, height, channels, levelCount;
+	TextureFormat format;	 // Raw, BC1 ou BC3
+	unsigned int reserved; // Mantém TextureLevel[] alinhado em 8 bytes
+};
+
+struct MaterialHeader
+{
+	float values[10];				 // Ka, Kd, Ks (RGB) e Ns
+	unsigned int nameLength; // Tamanho de textureName (bytes logo em seguida)
+};
+
+/* Estatísticas da execução atual (os carregadores podem rodar em threads de trabalho) */
+static std::atomic<unsigned int> cacheHits{0}, cacheMisses{0};
+
+/*****************************************************************************************
+ *  hashBytes()
+ *  --------------------------------------------------------------------------------------
+ *  Hash de 64 bits no estilo xxHash: quatro acumuladores independentes consomem 32 bytes
+ *  por iteração (bom paralelismo de instruções), depois o resto byte a byte. Usado só
+ *  para identificar conteúdo, não para segurança.
+ *****************************************************************************************/
+static inline unsigned long long rotl64(unsigned long long x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline unsigned long long read64(const unsigned char *p)
+{
+	unsigned long long v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+unsigned long long hashBytes(const void *data, size_t size, unsigned long long seed)
+{
+	const unsigned long long P1 = 0x9E3779B185EBCA87ull, P2 = 0xC2B2AE3D27D4EB4Full, P3 = 0x165667B19E3779F9ull;
+	const unsigned char *p = static_cast<const unsigned char *>(data);
+	const unsigned char *end = p + size;
+	unsigned long long h;
+
+	if (size >= 32)
+	{
+		unsigned long long a = seed + P1 + P2, b = seed + P2, c = seed, d = seed - P1;
+		for (; p + 32 <= end; p += 32)
+		{
+			a = rotl64(a + read64(p) * P2, 31) * P1;
+			b = rotl64(b + read64(p + 8) * P2, 31) * P1;
+			c = rotl64(c + read64(p + 16) * P2, 31) * P1;
+			d = rotl64(d + read64(p + 24) * P2, 31) * P1;
+		}
+		h = rotl64(a, 1) + rotl64(b, 7) + rotl64(c, 12) + rotl64(d, 18);
+	}
+	else
+		h = seed + P3;
+
+	h += static_cast<unsigned long long>(size);
+	for (; p + 8 <= end; p += 8)
+		h = rotl64(h ^ (rotl64(read64(p) * P2, 31) * P1), 27) * P1 + P3;
+	for (; p < end; ++p)
+		h = rotl64(h ^ (*p * P3), 11) * P1;
+
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	h *= P3;
+	h ^= h >> 32;
+	return h;
+}
+
+/* A versão entra como semente: mudar o formato muda todas as chaves */
+unsigned long long hashAsset(const MappedFile &source)
+{
+	return hashBytes(source.data(), source.size(), ASSET_CACHE_VERSION);
+}
+
+unsigned long long hashTexturePixels(const TextureView &view)
+{
+	unsigned int shape[3] = {view.width, view.height, view.channels};
+	return hashBytes(view.pixels + view.levels[0].offset, view.levels[0].size, hashBytes(shape, sizeof(shape)));
+}
+
+/*****************************************************************************************
+ *  canonicalPath()
+ *  --------------------------------------------------------------------------------------
+ *  Normaliza o caminho ("../a/../b.obj", barras invertidas, links) para que referências
+ *  diferentes ao mesmo arquivo caiam na mesma entrada.
+ *****************************************************************************************/
+std::string canonicalPath(const std::string &path)
+{
+	std::error_code ec;
+	std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+	if (ec)
+		canonical = std::filesystem::path(path).lexically_normal();
+	return canonical.generic_string();
+}
+
+/*****************************************************************************************
+ *  AssetBlob
+ *****************************************************************************************/
+bool AssetBlob::map(const std::string &path)
+{
+	bytes.clear();
+	file.reset(new MappedFile(path));
+	if (!file->isOpen())
+	{
+		file.reset();
+		return false;
+	}
+	return true;
+}
+
+void AssetBlob::assign(std::vector<unsigned char> &&data)
+{
+	file.reset();
+	bytes = std::move(data);
+}
+
+const unsigned char *AssetBlob::data() const
+{
+	return file ? reinterpret_cast<const unsigned char *>(file->data()) : bytes.data();
+}
+
+size_t AssetBlob::size() const
+{
+	return file ? file->size() : bytes.size();
+}
+
+/*****************************************************************************************
+ *  Funções auxiliares de leitura/gravação de entradas
+ *****************************************************************************************/
+static std::string entryPath(unsigned long long hash, const char *extension)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx", hash);
+	return ASSET_CACHE_DIR + name + extension;
+}
+
+/* Acrescenta "count" elementos POD ao final de "out" */
+template <typename T>
+static void appendPod(std::vector<unsigned char> &out, const T *data, size_t count)
+{
+	const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+	out.insert(out.end(), p, p + count * sizeof(T));
+}
+
+/* Cria o cabeçalho comum; payloadSize é ajustado por finishBlob() */
+static std::vector<unsigned char> beginBlob(const char *magic, unsigned long long hash)
+{
+	AssetHeader header{};
+	std::memcpy(header.magic, magic, 4);
+	header.version = ASSET_CACHE_VERSION;
+	header.sourceHash = hash;
+	std::vector<unsigned char> out;
+	appendPod(out, &header, 1);
+	return out;
+}
+
+static void finishBlob(std::vector<unsigned char> &out)
+{
+	unsigned long long payload = out.size() - sizeof(AssetHeader);
+	std::memcpy(out.data() + offsetof(AssetHeader, payloadSize), &payload, sizeof(payload));
+}
+
+/* Confere cabeçalho e tamanho; devolve o início do payload ou nullptr */
+static const unsigned char *checkBlob(const AssetBlob &blob, const char *magic, unsigned long long hash)
+{
+	if (blob.size() < sizeof(AssetHeader))
+		return nullptr;
+	AssetHeader header;
+	std::memcpy(&header, blob.data(), sizeof(header));
+	if (std::memcmp(header.magic, magic, 4) != 0 || header.version != ASSET_CACHE_VERSION ||
+			header.sourceHash != hash || header.payloadSize != blob.size() - sizeof(AssetHeader))
+		return nullptr;
+	return blob.data() + sizeof(AssetHeader);
+}
+
+/* Grava a entrada em um arquivo temporário e renomeia: leitores nunca veem entradas pela metade */
+static void writeEntry(const std::string &path, const AssetBlob &blob)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(ASSET_CACHE_DIR, ec);
+
+	/* Nome temporário único: duas threads podem gerar a mesma entrada ao mesmo tempo */
+	static std::atomic<unsigned int> tempCounter{0};
+	std::string temp = path + "." + std::to_string(tempCounter++) + ".tmp";
+	{
+		std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+		if (!out.write(reinterpret_cast<const char *>(blob.data()), blob.size()))
+		{
+			std::cerr << "Falha ao gravar o cache " << path << std::endl;
+			return;
+		}
+	}
+	std::filesystem::rename(temp, path, ec);
+	if (ec)
+		std::filesystem::remove(temp, ec);
+}
+
+/* Mapeia a entrada do cache, se existir e estiver habilitado */
+static bool mapEntry(const std::string &path, AssetBlob &blob)
+{
+	return assetCacheEnabled && blob.map(path);
+}
+
+/*****************************************************************************************
+ *  loadGeometryAsset()
+ *  --------------------------------------------------------------------------------------
+ *  1. Mapeia o .obj e calcula o hash do conteúdo (semente = versão do carregador).
+ *  2. Se existir uma entrada válida com esse hash, devolve uma view sobre o mapeamento:
+ *     nenhuma interpretação de texto, nenhuma cópia.
+ *  3. Caso contrário, interpreta e solda o .obj, reordena triângulos e vértices e gera
+ *     os LODs (optimizeMesh), empacota os vértices em MeshVertexLayout, converte os índices para
+ *     16 bits quando couberem e grava o resultado no cache.
+ *  Layout: AssetHeader | GeometryHeader | Meshlet[meshletCount] | vértices[vertexCount * stride]
+ *          | índices[indexCount]
+ *****************************************************************************************/
+bool validLods(const MeshLod *lods, unsigned int lodCount, unsigned int indexCount,
+							 const Meshlet *meshlets, unsigned int meshletCount)
+{
+	if (lodCount == 0 || lodCount > MESH_LOD_MAX)
+		return false;
+	for (unsigned int l = 0; l < lodCount; ++l)
+		if (lods[l].indexCount % 3 != 0 || lods[l].indexOffset > indexCount ||
+				lods[l].indexCount > indexCount - lods[l].indexOffset || lods[l].meshletOffset > meshletCount ||
+				lods[l].meshletCount > meshletCount - lods[l].meshletOffset ||
+				!validMeshlets(meshlets + lods[l].meshletOffset, lods[l].meshletCount, lods[l].indexOffset, lods[l].indexCount))
+			return false;
+	return true;
+}
+
+static bool readGeometryBlob(const AssetBlob &blob, unsigned long long hash, GeometryView &view)
+{
+	const unsigned char *p = checkBlob(blob, "GEOM", hash);
+	if (!p || blob.size() < sizeof(AssetHeader) + sizeof(GeometryHeader))
+		return false;
+
+	GeometryHeader header;
+	std::memcpy(&header, p, sizeof(header));
+	const unsigned char *vertices = p + sizeof(GeometryHeader) + static_cast<size_t>(header.meshletCount) * sizeof(Meshlet);
+	size_t expected = sizeof(AssetHeader) + sizeof(GeometryHeader) + static_cast<size_t>(header.meshletCount) * sizeof(Meshlet) +
+										static_cast<size_t>(header.vertexCount) * MeshVertexLayout::stride +
+										static_cast<size_t>(header.indexCount) * header.indexSize;
+	if ((header.indexSize != 2 && header.indexSize != 4) || header.vertexLayout != MeshVertexLayout::signature() ||
+			expected != blob.size())
+		return false; // Entrada de outro layout: é regenerada e sobrescrita
+	const Meshlet *meshlets = reinterpret_cast<const Meshlet *>(p + sizeof(GeometryHeader));
+	if (!validLods(header.lods, header.lodCount, header.indexCount, meshlets, header.meshletCount))
+		return false;
+
+	view.vertexCount = header.vertexCount;
+	view.indexCount = header.indexCount;
+	view.indexSize = header.indexSize;
+	view.vertices = vertices;
+	view.bounds = header.bounds;
+	view.sphere = header.sphere;
+	view.lodCount = header.lodCount;
+	std::memcpy(view.lods, header.lods, sizeof(view.lods));
+	view.meshlets = meshlets;
+	view.meshletCount = header.meshletCount;
+	view.indices = vertices + static_cast<size_t>(header.vertexCount) * MeshVertexLayout::stride;
+	return true;
+}
+
+bool loadGeometryAsset(const std::string &objPath, AssetBlob &blob, GeometryView &view)
+{
+	MappedFile source(objPath);
+	if (!source.isOpen())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << objPath << std::endl;
+		return false;
+	}
+	return loadGeometryAsset(source, hashAsset(source), objPath, blob, view);
+}
+
+bool loadGeometryAsset(const MappedFile &source, unsigned long long hash, const std::string &objPath,
+											 AssetBlob &blob, GeometryView &view)
+{
+	std::string entry = entryPath(hash, ".geo");
+	if (mapEntry(entry, blob) && readGeometryBlob(blob, hash, view))
+	{
+		++cacheHits;
+		return true;
+	}
+	++cacheMisses;
+
+	IndexedGeometry geometry = indexObj(parseObj(source.data(), source.end(), 0));
+	MeshOptimizationReport report = optimizeMesh(geometry);
+	std::cout << formatOptimizationReport(objPath, report) << std::flush; // Uma escrita só (várias threads)
+
+	GeometryHeader header{};
+	header.vertexCount = static_cast<unsigned int>(geometry.vertices.size());
+	header.indexCount = static_cast<unsigned int>(geometry.indices.size());
+	header.indexSize = geometry.vertices.size() <= 0xFFFF ? 2 : 4;
+	header.vertexLayout = MeshVertexLayout::signature();
+	header.bounds = computeVertexBounds(geometry.vertices.data(), geometry.vertices.size());
+	header.sphere = computeBoundingSphere(geometry.vertices.data(), geometry.vertices.size());
+	header.lodCount = report.lodCount;
+	std::memcpy(header.lods, report.lods, sizeof(header.lods));
+	header.meshletCount = static_cast<unsigned int>(report.meshlets.size());
+
+	std::vector<unsigned char> packed(geometry.vertices.size() * MeshVertexLayout::stride);
+	MeshVertexLayout::pack(geometry.vertices.data(), geometry.vertices.size(), header.bounds, packed.data());
+
+	std::vector<unsigned char> out = beginBlob("GEOM", hash);
+	out.reserve(sizeof(AssetHeader) + sizeof(GeometryHeader) + report.meshlets.size() * sizeof(Meshlet) + packed.size() +
+							geometry.indices.size() * header.indexSize);
+	appendPod(out, &header, 1);
+	appendPod(out, report.meshlets.data(), report.meshlets.size());
+	appendPod(out, packed.data(), packed.size());
+	if (header.indexSize == 2)
+	{
+		std::vector<unsigned short> shortIndices(geometry.indices.begin(), geometry.indices.end());
+		appendPod(out, shortIndices.data(), shortIndices.size());
+	}
+	else
+		appendPod(out, geometry.indices.data(), geometry.indices.size());
+	finishBlob(out);
+
+	blob.assign(std::move(out));
+	if (assetCacheEnabled)
+		writeEntry(entry, blob);
+	return readGeometryBlob(blob, hash, view);
+}
+
+/*****************************************************************************************
+ *  loadMaterialAsset()
+ *  --------------------------------------------------------------------------------------
+ *  Mesmo fluxo de loadGeometryAsset(), para o .mtl.
+ *  Layout: AssetHeader | MaterialHeader | textureName (sem '\0')
+ *****************************************************************************************/
+static bool readMaterialBlob(const AssetBlob &blob, unsigned long long hash, Material &material)
+{
+	const unsigned char *p = checkBlob(blob, "MTRL", hash);
+	if (!p || blob.size() < sizeof(AssetHeader) + sizeof(MaterialHeader))
+		return false;
+
+	MaterialHeader header;
+	std::memcpy(&header, p, sizeof(header));
+	if (sizeof(AssetHeader) + sizeof(MaterialHeader) + header.nameLength != blob.size())
+		return false;
+
+	float *dst[10] = {&material.kaR, &material.kaG, &material.kaB, &material.kdR, &material.kdG,
+										&material.kdB, &material.ksR, &material.ksG, &material.ksB, &material.ns};
+	for (int i = 0; i < 10; ++i)
+		*dst[i] = header.values[i];
+	material.textureName.assign(reinterpret_cast<const char *>(p + sizeof(MaterialHeader)), header.nameLength);
+	return true;
+}
+
+Material loadMaterialAsset(const std::string &mtlPath)
+{
+	MappedFile source(mtlPath);
+	if (!source.isOpen())
+		return setupMtl(mtlPath); // Sem arquivo não há chave: setupMtl() reporta o erro
+
+	Material material{};
+	unsigned long long hash = hashAsset(source);
+	std::string entry = entryPath(hash, ".mat");
+	AssetBlob blob;
+	if (mapEntry(entry, blob) && readMaterialBlob(blob, hash, material))
+	{
+		++cacheHits;
+		return material;
+	}
+	++cacheMisses;
+
+	material = setupMtl(mtlPath);
+
+	MaterialHeader header{{material.kaR, material.kaG, material.kaB, material.kdR, material.kdG,
+												 material.kdB, material.ksR, material.ksG, material.ksB, material.ns},
+												static_cast<unsigned int>(material.textureName.size())};
+	std::vector<unsigned char> out = beginBlob("MTRL", hash);
+	appendPod(out, &header, 1);
+	appendPod(out, material.textureName.data(), material.textureName.size());
+	finishBlob(out);
+
+	blob.assign(std::move(out));
+	if (assetCacheEnabled)
+		writeEntry(entry, blob);
+	return material;
+}
+
+/*****************************************************************************************
+ *  loadTextureAsset()
+ *  --------------------------------------------------------------------------------------
+ *  Mesmo fluxo de loadGeometryAsset(), para imagens: a entrada guarda os pixels já
+ *  decodificados (e invertidos verticalmente) com a cadeia de mipmaps completa.
+ *  Com "compress", os níveis são comprimidos em BC1/BC3 e vão para outra entrada (.btx),
+ *  então as versões crua e comprimida da mesma imagem convivem no cache.
+ *  Layout: AssetHeader | TextureHeader | TextureLevel[levelCount] | pixels (ou blocos)
+ *****************************************************************************************/
+bool validTextureLevels(const TextureLevel *levels, unsigned int levelCount, TextureFormat format,
+												unsigned int width, unsigned int height, unsigned int channels, unsigned long long pixelsSize)
+{
+	if (format != TextureFormat::Raw && format != TextureFormat::BC1 && format != TextureFormat::BC3)
+		return false;
+	if (levelCount == 0 || (channels != 3 && channels != 4) || levels[0].width != width || levels[0].height != height)
+		return false;
+	unsigned long long previous = 0;
+	for (unsigned int level = 0; level < levelCount; ++level)
+	{
+		const TextureLevel &lv = levels[level];
+		if (lv.width == 0 || lv.height == 0 || lv.offset < previous || lv.offset > pixelsSize ||
+				lv.size > pixelsSize - lv.offset || lv.size != levelBytes(format, lv.width, lv.height, channels))
+			return false;
+		previous = lv.offset;
+	}
+	return true;
+}
+
+static bool readTextureBlob(const AssetBlob &blob, unsigned long long hash, bool compressed, TextureView &view)
+{
+	const unsigned char *p = checkBlob(blob, "TEXR", hash);
+	if (!p || blob.size() < sizeof(AssetHeader) + sizeof(TextureHeader))
+		return false;
+
+	TextureHeader header;
+	std::memcpy(&header, p, sizeof(header));
+	size_t levelsSize = static_cast<size_t>(header.levelCount) * sizeof(TextureLevel);
+	size_t pixelsOffset = sizeof(AssetHeader) + sizeof(TextureHeader) + levelsSize;
+	if (header.levelCount == 0 || pixelsOffset > blob.size() || (header.format != TextureFormat::Raw) != compressed)
+		return false;
+
+	/* Todos os níveis, não só o último: um offset ou tamanho corrompido no meio da cadeia
+	   faria o upload ler fora da entrada */
+	const TextureLevel *levels = reinterpret_cast<const TextureLevel *>(p + sizeof(TextureHeader));
+	const unsigned long long pixelsSize = blob.size() - pixelsOffset;
+	const TextureLevel &last = levels[header.levelCount - 1];
+	if (!validTextureLevels(levels, header.levelCount, header.format, header.width, header.height, header.channels,
+													pixelsSize) ||
+			last.offset + last.size != pixelsSize)
+		return false;
+
+	view.width = header.width;
+	view.height = header.height;
+	view.channels = header.channels;
+	view.format = header.format;
+	view.levelCount = header.levelCount;
+	view.levels = levels;
+	view.pixels = blob.data() + pixelsOffset;
+	return true;
+}
+
+bool loadTextureAsset(const std::string &imagePath, AssetBlob &blob, TextureView &view, bool compress)
+{
+	MappedFile source(imagePath);
+	if (!source.isOpen())
+	{
+		std::cerr << "Falha ao carregar a textura " << imagePath << std::endl;
+		return false;
+	}
+	return loadTextureAsset(source, hashAsset(source), imagePath, blob, view, compress);
+}
+
+bool loadTextureAsset(const MappedFile &source, unsigned long long hash, const std::string &imagePath,
+											AssetBlob &blob, TextureView &view, bool compress)
+{
+	std::string entry = entryPath(hash, compress ? ".btx" : ".tex");
+	if (mapEntry(entry, blob) && readTextureBlob(blob, hash, compress, view))
+	{
+		++cacheHits;
+		return true;
+	}
+	++cacheMisses;
+
+	TextureImage image;
+	if (!decodeTexture(reinterpret_cast<const unsigned char *>(source.data()), source.size(), imagePath, image))
+		return false;
+	if (compress)
+		compressTexture(image);
+
+	TextureHeader header{image.width, image.height, image.channels, static_cast<unsigned int>(image.levels.size()),
+											 image.format, 0};
+	std::vector<unsigned char> out = beginBlob("TEXR", hash);
+	out.reserve(sizeof(AssetHeader) + sizeof(TextureHeader) + image.levels.size() * sizeof(TextureLevel) +
+							image.pixels.size());
+	appendPod(out, &header, 1);
+	appendPod(out, image.levels.data(), image.levels.size());
+	appendPod(out, image.pixels.data(), image.pixels.size());
+	finishBlob(out);
+
+	blob.assign(std::move(out));
+	if (assetCacheEnabled)
+		writeEntry(entry, blob);
+	return readTextureBlob(blob, hash, compress, view);
+}
+
+/*****************************************************************************************
+ *  printAssetCacheStats()
+ *****************************************************************************************/
+void printAssetCacheStats()
+{
+	std::cout << "Cache de assets (" << ASSET_CACHE_DIR << "): " << cacheHits << " acerto(s), "
+						<< cacheMisses << " falta(s)" << (assetCacheEnabled ? "" : " [desabilitado]") << std::endl;
+}
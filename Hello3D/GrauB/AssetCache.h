@@ -0,0 +1,107 @@
+// AssetCache.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <memory> // std::unique_ptr
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include "MappedFile.h"		 // Entradas do cache são lidas via mmap
+#include "Culling.h"				 // BoundingSphere
+#include "Material.h"			 // Struct Material
+#include "Meshlet.h"				 // Meshlet
+#include "MeshSimplifier.h" // MeshLod
+#include "TextureLoader.h" // TextureLevel / TextureFormat
+#include "VertexLayout.h"	 // MeshVertexLayout / VertexBounds
+
+// Versão do formato das entradas e dos carregadores que as produzem.
+// Incrementar sempre que o resultado de setupIndexedObj / optimizeMesh / setupMtl / decodeTexture mudar:
+// entradas antigas passam a ter outra chave e são regeneradas automaticamente.
+const unsigned int ASSET_CACHE_VERSION = 10;
+
+// Diretório das entradas, relativo ao diretório de trabalho (o mesmo de "../Scene.txt")
+const std::string ASSET_CACHE_DIR = "../cache/";
+
+// Liga/desliga o cache (ex.: "--no-cache" na linha de comando)
+extern bool assetCacheEnabled;
+
+// Geometria no formato final de upload (vértices em MeshVertexLayout + índices de 16 ou 32 bits)
+struct GeometryView
+{
+	const unsigned char *vertices; // vertexCount * MeshVertexLayout::stride bytes
+	VertexBounds bounds;					 // Decodifica as posições quantizadas (e é a caixa envolvente)
+	BoundingSphere sphere;				 // Esfera envolvente (descarte)
+	unsigned int vertexCount;
+	const void *indices;
+	unsigned int indexCount;
+	unsigned int indexSize; // 2 ou 4 bytes por índice
+	unsigned int lodCount;	// Níveis de detalhe em "lods" (o LOD 0 é a malha original)
+	MeshLod lods[MESH_LOD_MAX];
+	const Meshlet *meshlets; // Clusters de todos os níveis (MeshLod::meshletOffset / meshletCount)
+	unsigned int meshletCount;
+};
+
+// true se os níveis cabem no index buffer e os meshlets de cada um cobrem exatamente o seu
+// trecho (validação de entradas do cache / pacotes)
+bool validLods(const MeshLod *lods, unsigned int lodCount, unsigned int indexCount,
+							 const Meshlet *meshlets, unsigned int meshletCount);
+
+// Textura no formato final de upload (todos os níveis de mipmap)
+struct TextureView
+{
+	unsigned int width, height, channels, levelCount;
+	TextureFormat format; // Raw ou blocos BC1/BC3
+	const TextureLevel *levels;
+	const unsigned char *pixels;
+};
+
+// true se o formato é conhecido e todos os níveis cabem em pixelsSize bytes, em ordem, com o
+// tamanho que o formato e as dimensões exigem (validação de entradas do cache / pacotes)
+bool validTextureLevels(const TextureLevel *levels, unsigned int levelCount, TextureFormat format,
+												unsigned int width, unsigned int height, unsigned int channels, unsigned long long pixelsSize);
+
+// Bytes de uma entrada do cache: mapeados do disco (acerto) ou gerados agora (falta)
+class AssetBlob
+{
+private:
+	std::unique_ptr<MappedFile> file; // Entrada mapeada
+	std::vector<unsigned char> bytes; // Entrada recém-gerada
+
+public:
+	bool map(const std::string &path);
+	void assign(std::vector<unsigned char> &&data);
+	const unsigned char *data() const;
+	size_t size() const;
+};
+
+// Hash de 64 bits do conteúdo de um bloco de memória
+unsigned long long hashBytes(const void *data, size_t size, unsigned long long seed = 0);
+
+// Caminho absoluto e normalizado, para que referências diferentes ao mesmo arquivo coincidam
+std::string canonicalPath(const std::string &path);
+
+// Hash que identifica o conteúdo de um arquivo de origem no cache (inclui a versão)
+unsigned long long hashAsset(const MappedFile &source);
+
+// Hash dos pixels do nível 0, incluindo dimensões e canais (a mesma imagem salva em outro formato coincide)
+unsigned long long hashTexturePixels(const TextureView &view);
+
+// Geometria indexada de um .obj: lida do cache ou carregada, convertida e gravada nele
+bool loadGeometryAsset(const std::string &objPath, AssetBlob &blob, GeometryView &view);
+
+// Igual, para um .obj já mapeado cujo hashAsset() já é conhecido (objPath só aparece no relatório)
+bool loadGeometryAsset(const MappedFile &source, unsigned long long hash, const std::string &objPath,
+											 AssetBlob &blob, GeometryView &view);
+
+// Material de um .mtl: lido do cache ou carregado e gravado nele
+Material loadMaterialAsset(const std::string &mtlPath);
+
+// Textura com mipmaps: lida do cache ou decodificada e gravada nele.
+// compress = true: níveis em BC1 (RGB) ou BC3 (RGBA), guardados em uma entrada separada
+bool loadTextureAsset(const std::string &imagePath, AssetBlob &blob, TextureView &view, bool compress = false);
+
+// Igual, para uma imagem já mapeada cujo hashAsset() já é conhecido
+bool loadTextureAsset(const MappedFile &source, unsigned long long hash, const std::string &imagePath,
+											AssetBlob &blob, TextureView &view, bool compress = false);
+
+// Imprime acertos/faltas do cache desde o início da execução
+void printAssetCacheStats();
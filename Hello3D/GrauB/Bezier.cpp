@@ -0,0 +1,72 @@
+// Bezier.cpp
+#include "Bezier.h" // Inclui o arquivo de cabeçalho das curvas de Bézier
+
+/*****************************************************************************************
+ *  generateCircleControlPoints()
+ *  --------------------------------------------------------------------------------------
+ *  Gera pontos de controle para desenhar um círculo de raio “radius” ao redor de
+ *  referencePoint, usando quatro curvas de Bézier cúbicas.
+ *****************************************************************************************/
+std::vector<glm::vec3> generateCircleControlPoints(glm::vec3 referencePoint, float radius)
+{
+	std::vector<glm::vec3> cps;
+	const float k = 0.552284749831f * radius; // Constante para aproximar círculo
+
+	/* Pontos principais do “quadrado” circunscrito */
+	glm::vec3 P0 = referencePoint + glm::vec3(radius, 0, radius);		// Topo
+	glm::vec3 P1 = referencePoint + glm::vec3(radius, 0, -radius);	// Lado direito
+	glm::vec3 P2 = referencePoint + glm::vec3(-radius, 0, -radius); // Base
+	glm::vec3 P3 = referencePoint + glm::vec3(-radius, 0, radius);	// Lado esquerdo
+
+	/* Pontos auxiliares (tangentes) */
+	glm::vec3 P0a = P0 + glm::vec3(k, 0, -k);
+	glm::vec3 P0b = P0 + glm::vec3(-k, 0, k);
+	glm::vec3 P1a = P1 + glm::vec3(-k, 0, -k);
+	glm::vec3 P1b = P1 + glm::vec3(k, 0, k);
+	glm::vec3 P2a = P2 + glm::vec3(-k, 0, k);
+	glm::vec3 P2b = P2 + glm::vec3(k, 0, -k);
+	glm::vec3 P3a = P3 + glm::vec3(k, 0, k);
+	glm::vec3 P3b = P3 + glm::vec3(-k, 0, -k);
+
+	/* Quatro segmentos Bézier (cada 4 pontos) */
+	cps.insert(cps.end(), {P0, P0a, P1b, P1,
+												 P1a, P2b, P2,
+												 P2a, P3b, P3,
+												 P3a, P0b, P0});
+	return cps;
+}
+
+/*****************************************************************************************
+ *  tessellateBezier()
+ *  --------------------------------------------------------------------------------------
+ *  Constrói pontos de uma ou mais curvas de Bézier cúbicas usando matriz de base (M).
+ *  Só CPU: o envio para a GPU fica com quem chama (a cena ou o compilador de pacotes).
+ *****************************************************************************************/
+std::vector<glm::vec3> tessellateBezier(const std::vector<glm::vec3> &controlPoints, int pointsPerSegment)
+{
+	/* Matriz de base de Bézier cúbica */
+	const glm::mat4 M(
+			-1, 3, -3, 1,
+			3, -6, 3, 0,
+			-3, 3, 0, 0,
+			1, 0, 0, 0);
+
+	std::vector<glm::vec3> curvePoints;
+	float step = 1.0f / static_cast<float>(pointsPerSegment);
+
+	/* Para cada segmento de 4 pontos (P0..P3) */
+	for (size_t i = 0; i + 3 < controlPoints.size(); i += 3)
+	{
+		for (float t = 0.0f; t <= 1.0f; t += step)
+		{
+			glm::vec4 T(t * t * t, t * t, t, 1.0f);
+			glm::mat4x3 G(controlPoints[i],
+										controlPoints[i + 1],
+										controlPoints[i + 2],
+										controlPoints[i + 3]);
+			curvePoints.push_back(G * M * T);
+		}
+	}
+
+	return curvePoints;
+}
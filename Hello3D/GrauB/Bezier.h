@@ -0,0 +1,12 @@
+// Bezier.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <vector> // Necessário para usar std::vector
+
+#include <glm/glm.hpp> // Tipo glm::vec3
+
+// Pontos de controle de um círculo de raio "radius" ao redor de referencePoint (quatro cúbicas, plano XZ)
+std::vector<glm::vec3> generateCircleControlPoints(glm::vec3 referencePoint, float radius);
+
+// Discretiza uma curva composta de cúbicas (P0..P3, P3..P6, ...) com pointsPerSegment passos por segmento
+std::vector<glm::vec3> tessellateBezier(const std::vector<glm::vec3> &controlPoints, int pointsPerSegment);
@@ -0,0 +1,103 @@
+// BufferArena.cpp
+#include "BufferArena.h" // Inclui o arquivo de cabeçalho do buffer repartido
+
+#include <algorithm> // std::max
+#include <iterator>	 // std::prev
+
+// Tamanho inicial, em elementos (o buffer dobra a partir daí)
+static const size_t ARENA_INITIAL_ELEMENTS = 64 * 1024;
+
+/*****************************************************************************************
+ *  BufferArena::allocate()
+ *  --------------------------------------------------------------------------------------
+ *  As escritas usam GL_COPY_WRITE_BUFFER: vincular o buffer como GL_ELEMENT_ARRAY_BUFFER
+ *  mudaria o index buffer do VAO que estiver vinculado.
+ *****************************************************************************************/
+size_t BufferArena::allocate(size_t count, const void *data)
+{
+	auto range = freeRanges.begin();
+	while (range != freeRanges.end() && range->second < count)
+		++range;
+	if (range == freeRanges.end())
+	{
+		grow(count);
+		range = std::prev(freeRanges.end()); // O último trecho livre agora termina no fim do buffer
+	}
+
+	size_t first = range->first, remaining = range->second - count;
+	freeRanges.erase(range);
+	if (remaining > 0)
+		freeRanges.emplace(first + count, remaining);
+	used += count;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * elementSize),
+									static_cast<GLsizeiptr>(count * elementSize), data);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return first;
+}
+
+void BufferArena::free(size_t first, size_t count)
+{
+	if (count == 0)
+		return;
+	used -= count;
+	addFree(first, count);
+}
+
+/* Insere o trecho unindo-o aos livres imediatamente antes e depois */
+void BufferArena::addFree(size_t first, size_t count)
+{
+	auto next = freeRanges.lower_bound(first);
+	if (next != freeRanges.begin())
+	{
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == first)
+		{
+			first = previous->first;
+			count += previous->second;
+			freeRanges.erase(previous);
+		}
+	}
+	if (next != freeRanges.end() && first + count == next->first)
+	{
+		count += next->second;
+		freeRanges.erase(next);
+	}
+	freeRanges.emplace(first, count);
+}
+
+/* Novo buffer com pelo menos "minimum" elementos livres no fim; o conteúdo antigo é copiado
+   sem passar pela CPU */
+void BufferArena::grow(size_t minimum)
+{
+	size_t newCapacity = std::max(capacity, ARENA_INITIAL_ELEMENTS);
+	while (newCapacity < capacity + minimum)
+		newCapacity *= 2;
+
+	GLuint newBuffer;
+	glGenBuffers(1, &newBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity * elementSize), nullptr, GL_STATIC_DRAW);
+	if (buffer != 0)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(capacity * elementSize));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &buffer);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	addFree(capacity, newCapacity - capacity);
+	buffer = newBuffer;
+	capacity = newCapacity;
+}
+
+void BufferArena::release()
+{
+	if (buffer != 0)
+		glDeleteBuffers(1, &buffer);
+	buffer = 0;
+	capacity = used = 0;
+	freeRanges.clear();
+}
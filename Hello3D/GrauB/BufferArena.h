@@ -0,0 +1,40 @@
+// BufferArena.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <map>		 // Trechos livres ordenados pelo início
+
+#include <glad/glad.h> // Tipos OpenGL (GLuint...)
+
+// Um buffer OpenGL grande repartido em trechos de elementos de tamanho fixo (vértices de um
+// layout, índices de 16 ou 32 bits). Alocação pelo primeiro trecho livre que couber; trechos
+// livres vizinhos são unidos na liberação. Sem espaço, o buffer é recriado com o dobro do
+// tamanho e o conteúdo copiado na GPU (glCopyBufferSubData): o id muda, e quem aponta para
+// ele (VAO) precisa ser refeito. Sem destrutor: release() é chamado com o contexto ativo
+class BufferArena
+{
+private:
+	GLuint buffer = 0;
+	size_t elementSize;									 // Bytes por elemento (inícios e tamanhos em elementos)
+	size_t capacity = 0;								 // Elementos no buffer atual
+	size_t used = 0;										 // Elementos alocados
+	std::map<size_t, size_t> freeRanges; // Início -> tamanho, nunca encostados uns nos outros
+
+	void grow(size_t minimum);
+	void addFree(size_t first, size_t count);
+
+public:
+	explicit BufferArena(size_t elementSize) : elementSize(elementSize) {}
+
+	// Reserva count elementos, copia data para eles e devolve o primeiro
+	size_t allocate(size_t count, const void *data);
+
+	// Devolve o trecho [first, first + count) ao espaço livre
+	void free(size_t first, size_t count);
+
+	void release();
+
+	GLuint getId() const { return buffer; }
+	size_t usedBytes() const { return used * elementSize; }
+	size_t capacityBytes() const { return capacity * elementSize; }
+};
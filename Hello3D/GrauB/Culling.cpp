@@ -0,0 +1,224 @@
+// Culling.cpp
+#include "Culling.h" // Inclui o arquivo de cabeçalho do descarte por visibilidade
+
+#include <algorithm> // std::max
+#include <cmath>		 // std::fabs / std::sqrt
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h> // Intrínsecos SSE
+#define CULLING_SSE
+#endif
+
+/*****************************************************************************************
+ *  extractFrustum()
+ *  --------------------------------------------------------------------------------------
+ *  Cada plano é a soma ou a diferença da quarta linha de projection * view com uma das
+ *  outras três (-w <= x, y, z <= w no espaço de recorte). glm guarda as matrizes por
+ *  coluna, então a linha i é (m[0][i], m[1][i], m[2][i], m[3][i]).
+ *****************************************************************************************/
+Frustum extractFrustum(const glm::mat4 &viewProjection)
+{
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; ++i)
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+	Frustum frustum;
+	frustum.planes[0] = rows[3] + rows[0]; // Esquerda
+	frustum.planes[1] = rows[3] - rows[0]; // Direita
+	frustum.planes[2] = rows[3] + rows[1]; // Baixo
+	frustum.planes[3] = rows[3] - rows[1]; // Cima
+	frustum.planes[4] = rows[3] + rows[2]; // Perto
+	frustum.planes[5] = rows[3] - rows[2]; // Longe
+	for (glm::vec4 &plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+	return frustum;
+}
+
+bool sphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius)
+{
+	for (const glm::vec4 &plane : frustum.planes)
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			return false;
+	return true;
+}
+
+/*****************************************************************************************
+ *  computeBoundingSphere()
+ *****************************************************************************************/
+BoundingSphere computeBoundingSphere(const Vertex *vertices, size_t count)
+{
+	BoundingSphere sphere{};
+	if (count == 0)
+		return sphere;
+
+	glm::vec3 lo(vertices[0].x, vertices[0].y, vertices[0].z), hi = lo;
+	for (size_t i = 1; i < count; ++i)
+	{
+		lo = glm::min(lo, glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z));
+		hi = glm::max(hi, glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z));
+	}
+	glm::vec3 center = 0.5f * (lo + hi);
+	float radius2 = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		glm::vec3 d = glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z) - center;
+		radius2 = std::max(radius2, glm::dot(d, d));
+	}
+	sphere.center[0] = center.x;
+	sphere.center[1] = center.y;
+	sphere.center[2] = center.z;
+	sphere.radius = std::sqrt(radius2);
+	return sphere;
+}
+
+/*****************************************************************************************
+ *  CullingBatch
+ *****************************************************************************************/
+void CullingBatch::clear()
+{
+	for (int a = 0; a < 3; ++a)
+	{
+		boxCenter[a].clear();
+		boxExtent[a].clear();
+		sphereCenter[a].clear();
+	}
+	sphereRadius.clear();
+}
+
+/* Caixa transformada: centro por model, meia extensão em cada eixo do mundo = soma dos
+   |model[coluna][eixo]| * meia extensão local. Esfera: raio vezes a maior escala das colunas */
+size_t CullingBatch::add(const VertexBounds &box, const BoundingSphere &sphere, const glm::mat4 &model)
+{
+	glm::vec3 extent = 0.5f * glm::vec3(box.scale[0], box.scale[1], box.scale[2]);
+	glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(box.offset[0], box.offset[1], box.offset[2]) + extent, 1.0f));
+	glm::vec3 sphereWorld = glm::vec3(model * glm::vec4(sphere.center[0], sphere.center[1], sphere.center[2], 1.0f));
+	float maxScale2 = std::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+														 std::max(glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+																			glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))));
+	for (int a = 0; a < 3; ++a)
+	{
+		boxCenter[a].push_back(center[a]);
+		boxExtent[a].push_back(std::fabs(model[0][a]) * extent.x + std::fabs(model[1][a]) * extent.y +
+													 std::fabs(model[2][a]) * extent.z);
+		sphereCenter[a].push_back(sphereWorld[a]);
+	}
+	sphereRadius.push_back(sphere.radius * std::sqrt(maxScale2));
+	return sphereRadius.size() - 1;
+}
+
+size_t CullingBatch::add(const glm::vec3 &boxMin, const glm::vec3 &boxMax)
+{
+	glm::vec3 center = 0.5f * (boxMin + boxMax), extent = 0.5f * (boxMax - boxMin);
+	for (int a = 0; a < 3; ++a)
+	{
+		boxCenter[a].push_back(center[a]);
+		boxExtent[a].push_back(extent[a]);
+		sphereCenter[a].push_back(center[a]);
+	}
+	sphereRadius.push_back(glm::length(extent));
+	return sphereRadius.size() - 1;
+}
+
+/*****************************************************************************************
+ *  CullingBatch::cull()
+ *  --------------------------------------------------------------------------------------
+ *  Para cada plano (n, w), um objeto está fora se
+ *      dot(n, centro da caixa) + w < -dot(|n|, meia extensão)   (caixa)
+ *   ou dot(n, centro da esfera) + w < -raio                     (esfera)
+ *  Com SSE, cada registrador carrega a mesma coordenada de 4 objetos, e os 6 planos são
+ *  testados sem desvios; o resultado sai de _mm_movemask_ps.
+ *****************************************************************************************/
+void CullingBatch::cull(const Frustum &frustum, std::vector<unsigned char> &visible) const
+{
+	const size_t count = size();
+	visible.resize(count);
+	size_t i = 0;
+
+#ifdef CULLING_SSE
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 bx = _mm_loadu_ps(&boxCenter[0][i]), by = _mm_loadu_ps(&boxCenter[1][i]), bz = _mm_loadu_ps(&boxCenter[2][i]);
+		__m128 ex = _mm_loadu_ps(&boxExtent[0][i]), ey = _mm_loadu_ps(&boxExtent[1][i]), ez = _mm_loadu_ps(&boxExtent[2][i]);
+		__m128 sx = _mm_loadu_ps(&sphereCenter[0][i]), sy = _mm_loadu_ps(&sphereCenter[1][i]);
+		__m128 sz = _mm_loadu_ps(&sphereCenter[2][i]), sr = _mm_loadu_ps(&sphereRadius[i]);
+		__m128 outside = zero;
+		for (const glm::vec4 &plane : frustum.planes)
+		{
+			__m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z), w = _mm_set1_ps(plane.w);
+			__m128 ax = _mm_set1_ps(std::fabs(plane.x)), ay = _mm_set1_ps(std::fabs(plane.y)), az = _mm_set1_ps(std::fabs(plane.z));
+
+			__m128 boxDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, bx), _mm_mul_ps(ny, by)), _mm_add_ps(_mm_mul_ps(nz, bz), w));
+			__m128 boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ex), _mm_mul_ps(ay, ey)), _mm_mul_ps(az, ez));
+			__m128 sphereDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, sx), _mm_mul_ps(ny, sy)), _mm_add_ps(_mm_mul_ps(nz, sz), w));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(boxDistance, boxRadius), zero));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(sphereDistance, sr), zero));
+		}
+		int mask = _mm_movemask_ps(outside);
+		for (int k = 0; k < 4; ++k)
+			visible[i + k] = !((mask >> k) & 1);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		bool outside = false;
+		for (const glm::vec4 &plane : frustum.planes)
+		{
+			float boxDistance = plane.x * boxCenter[0][i] + plane.y * boxCenter[1][i] + plane.z * boxCenter[2][i] + plane.w;
+			float boxRadius = std::fabs(plane.x) * boxExtent[0][i] + std::fabs(plane.y) * boxExtent[1][i] +
+												std::fabs(plane.z) * boxExtent[2][i];
+			float sphereDistance = plane.x * sphereCenter[0][i] + plane.y * sphereCenter[1][i] + plane.z * sphereCenter[2][i] + plane.w;
+			outside |= boxDistance + boxRadius < 0.0f || sphereDistance + sphereRadius[i] < 0.0f;
+		}
+		visible[i] = !outside;
+	}
+}
+
+/*****************************************************************************************
+ *  cullMeshlets()
+ *****************************************************************************************/
+void cullMeshlets(const Meshlet *meshlets, unsigned int meshletCount, const Frustum &frustum, const glm::mat4 &model,
+									float maxScale, const glm::vec3 &cameraObject, bool coneCulling,
+									std::vector<GLsizei> &counts, std::vector<GLuint> &firsts, ClusterCullingStats &stats)
+{
+	counts.clear();
+	firsts.clear();
+	unsigned int rangeEnd = ~0u; // Fim do último trecho (para unir meshlets vizinhos)
+
+	for (unsigned int m = 0; m < meshletCount; ++m)
+	{
+		const Meshlet &meshlet = meshlets[m];
+		++stats.meshlets;
+
+		glm::vec3 center = glm::vec3(model * glm::vec4(meshlet.center[0], meshlet.center[1], meshlet.center[2], 1.0f));
+		if (!sphereInFrustum(frustum, center, meshlet.radius * maxScale))
+		{
+			++stats.frustumCulled;
+			continue;
+		}
+
+		if (coneCulling && meshlet.coneCutoff <= 1.0f)
+		{
+			glm::vec3 apex(meshlet.coneApex[0], meshlet.coneApex[1], meshlet.coneApex[2]);
+			glm::vec3 axis(meshlet.coneAxis[0], meshlet.coneAxis[1], meshlet.coneAxis[2]);
+			glm::vec3 view = apex - cameraObject;
+			float distance = glm::length(view);
+			if (glm::dot(view, axis) >= meshlet.coneCutoff * distance)
+			{
+				++stats.backfaceCulled;
+				continue;
+			}
+		}
+
+		if (meshlet.indexOffset == rangeEnd)
+			counts.back() += static_cast<GLsizei>(meshlet.indexCount);
+		else
+		{
+			counts.push_back(static_cast<GLsizei>(meshlet.indexCount));
+			firsts.push_back(meshlet.indexOffset);
+		}
+		rangeEnd = meshlet.indexOffset + meshlet.indexCount;
+	}
+	stats.draws += counts.size();
+}
@@ -0,0 +1,82 @@
+// Culling.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <vector>	 // Necessário para usar std::vector
+
+#include <glad/glad.h> // GLsizei / GLenum
+#include <glm/glm.hpp> // glm::vec3 / glm::vec4 / glm::mat4
+
+#include "Meshlet.h"			// Meshlet
+#include "VertexLayout.h" // VertexBounds (caixa das posições)
+
+// Seis planos (esquerda, direita, baixo, cima, perto, longe) com a normal para dentro e
+// normalizados: dot(plano.xyz, p) + plano.w é a distância de p ao plano
+struct Frustum
+{
+	glm::vec4 planes[6];
+};
+
+// Planos da pirâmide de visão de projection * view (espaço do mundo), método de Gribb e Hartmann
+Frustum extractFrustum(const glm::mat4 &viewProjection);
+
+// false se a esfera está inteiramente fora de algum plano
+bool sphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius);
+
+// Esfera envolvente de uma geometria, no espaço do objeto
+struct BoundingSphere
+{
+	float center[3], radius;
+};
+
+// Centro da caixa dos vértices e a maior distância até ele (mais justa que a meia diagonal)
+BoundingSphere computeBoundingSphere(const Vertex *vertices, size_t count);
+
+// Caixas e esferas de vários objetos já no espaço do mundo, em estrutura de arrays: o teste
+// contra os planos roda em lotes de 4 objetos por instrução SSE (escalar sem SSE e no resto)
+class CullingBatch
+{
+private:
+	std::vector<float> boxCenter[3], boxExtent[3]; // Caixa alinhada aos eixos do mundo (centro e meia extensão)
+	std::vector<float> sphereCenter[3], sphereRadius;
+
+public:
+	void clear();
+	size_t size() const { return sphereRadius.size(); }
+
+	// Caixa e esfera do espaço do objeto transformadas por model (a caixa é recalculada para
+	// os eixos do mundo, método de Arvo); devolve o índice do objeto no lote
+	size_t add(const VertexBounds &box, const BoundingSphere &sphere, const glm::mat4 &model);
+
+	// Caixa já no espaço do mundo (ex.: curvas); a esfera é a que circunscreve a caixa
+	size_t add(const glm::vec3 &boxMin, const glm::vec3 &boxMax);
+
+	// visible[i] = 0 se a caixa ou a esfera do objeto i está inteiramente fora de algum plano
+	void cull(const Frustum &frustum, std::vector<unsigned char> &visible) const;
+};
+
+// Contadores do descarte por objeto (acumulados entre quadros)
+struct ObjectCullingStats
+{
+	size_t objects;		 // Na cena (malhas com geometria e, se exibidas, curvas)
+	size_t candidates; // Entregues pela BVH e testados no lote
+	size_t culled;		 // Fora da pirâmide de visão: nem as chamadas de desenho são feitas
+};
+
+// Contadores do descarte por cluster (acumulados entre quadros)
+struct ClusterCullingStats
+{
+	size_t meshlets;			 // Testados
+	size_t frustumCulled;	 // Fora da pirâmide de visão
+	size_t backfaceCulled; // Com todos os triângulos de costas para a câmera
+	size_t draws;					 // Trechos desenhados (meshlets vizinhos visíveis são unidos)
+};
+
+// Descarta os meshlets fora do frustum (esfera levada ao mundo por model, com o raio
+// multiplicado por maxScale) e, com coneCulling, os de costas para a câmera (teste do cone no
+// espaço do objeto, com cameraObject = câmera nesse espaço; o sinal de "de costas" não muda
+// com transformações afins que não espelham). Os visíveis viram trechos contíguos do index
+// buffer da geometria: counts / firsts (primeiro índice de cada trecho)
+void cullMeshlets(const Meshlet *meshlets, unsigned int meshletCount, const Frustum &frustum, const glm::mat4 &model,
+									float maxScale, const glm::vec3 &cameraObject, bool coneCulling,
+									std::vector<GLsizei> &counts, std::vector<GLuint> &firsts, ClusterCullingStats &stats);
@@ -0,0 +1,680 @@
+// DynamicBvh.cpp
+#include "DynamicBvh.h" // Inclui o arquivo de cabeçalho da BVH dinâmica
+
+#include <chrono>			// Medição de tempo (benchmark)
+#include <functional> // std::greater
+#include <iostream>		// Saída de dados no console
+#include <limits>			// std::numeric_limits
+#include <queue>			// std::priority_queue (k mais próximos)
+#include <random>			// std::mt19937 (cenas sintéticas)
+#include <utility>		// std::pair
+
+#include <glm/gtc/matrix_transform.hpp> // glm::perspective / glm::lookAt (câmeras do benchmark)
+
+static inline Aabb combine(const Aabb &a, const Aabb &b)
+{
+	return Aabb{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+static inline bool contains(const Aabb &outer, const Aabb &inner)
+{
+	return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+static inline float surfaceArea(const Aabb &box)
+{
+	glm::vec3 d = box.max - box.min;
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/* Caixa justa expandida pela folga (a maior meia extensão vezes margin em todos os eixos) */
+static inline Aabb fatten(const Aabb &box, float margin)
+{
+	glm::vec3 extent = 0.5f * (box.max - box.min);
+	glm::vec3 r(std::max(extent.x, std::max(extent.y, extent.z)) * margin);
+	return Aabb{box.min - r, box.max + r};
+}
+
+/*****************************************************************************************
+ *  transformAabb() / rayHitsAabb() / distance2ToAabb()
+ *****************************************************************************************/
+Aabb transformAabb(const glm::vec3 &boxMin, const glm::vec3 &boxMax, const glm::mat4 &model)
+{
+	glm::vec3 center = glm::vec3(model * glm::vec4(0.5f * (boxMin + boxMax), 1.0f));
+	glm::vec3 extent = 0.5f * (boxMax - boxMin), worldExtent;
+	for (int a = 0; a < 3; ++a)
+		worldExtent[a] = std::fabs(model[0][a]) * extent.x + std::fabs(model[1][a]) * extent.y +
+										 std::fabs(model[2][a]) * extent.z;
+	return Aabb{center - worldExtent, center + worldExtent};
+}
+
+/* Método das placas: em cada eixo, o raio está entre os dois planos da caixa em
+   [t1, t2]; o acerto é a interseção desses intervalos com [0, maxDistance] */
+bool rayHitsAabb(const Aabb &box, const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance,
+								 float *distance)
+{
+	float tMin = 0.0f, tMax = maxDistance;
+	for (int a = 0; a < 3; ++a)
+	{
+		float t1 = (box.min[a] - origin[a]) * inverseDirection[a];
+		float t2 = (box.max[a] - origin[a]) * inverseDirection[a];
+		if (t1 != t1 || t2 != t2) // 0 * infinito: origem no plano da face, paralela a ele
+		{
+			if (origin[a] < box.min[a] || origin[a] > box.max[a])
+				return false;
+			continue;
+		}
+		tMin = std::max(tMin, std::min(t1, t2));
+		tMax = std::min(tMax, std::max(t1, t2));
+		if (tMin > tMax)
+			return false;
+	}
+	if (distance)
+		*distance = tMin;
+	return true;
+}
+
+/* Cada canto resolve n1.x = -w1, n2.x = -w2, n3.x = -w3 (regra de Cramer com produtos
+   vetoriais). Planos quase paralelos (projeção degenerada): caixa infinita, sem corte */
+Aabb frustumBounds(const Frustum &frustum)
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+	Aabb bounds{glm::vec3(infinity), glm::vec3(-infinity)};
+	for (int x = 0; x < 2; ++x)
+		for (int y = 2; y < 4; ++y)
+			for (int z = 4; z < 6; ++z)
+			{
+				glm::vec3 n1(frustum.planes[x]), n2(frustum.planes[y]), n3(frustum.planes[z]);
+				float determinant = glm::dot(n1, glm::cross(n2, n3));
+				if (std::fabs(determinant) < 1e-6f)
+					return Aabb{glm::vec3(-infinity), glm::vec3(infinity)};
+				glm::vec3 corner = (-frustum.planes[x].w * glm::cross(n2, n3) - frustum.planes[y].w * glm::cross(n3, n1) -
+														frustum.planes[z].w * glm::cross(n1, n2)) /
+													 determinant;
+				bounds.min = glm::min(bounds.min, corner);
+				bounds.max = glm::max(bounds.max, corner);
+			}
+	return bounds;
+}
+
+float distance2ToAabb(const Aabb &box, const glm::vec3 &point)
+{
+	glm::vec3 d = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+	return glm::dot(d, d);
+}
+
+/*****************************************************************************************
+ *  DynamicBvh – nós
+ *****************************************************************************************/
+int DynamicBvh::allocateNode()
+{
+	if (freeList == BVH_NULL_NODE)
+	{
+		nodes.push_back(BvhNode{});
+		nodes.back().height = -1;
+		nodes.back().parent = BVH_NULL_NODE;
+		freeList = static_cast<int>(nodes.size()) - 1;
+	}
+	int node = freeList;
+	freeList = nodes[node].parent;
+	nodes[node] = BvhNode{};
+	nodes[node].parent = nodes[node].child1 = nodes[node].child2 = BVH_NULL_NODE;
+	nodes[node].height = 0;
+	return node;
+}
+
+void DynamicBvh::freeNode(int node)
+{
+	nodes[node].parent = freeList;
+	nodes[node].height = -1;
+	freeList = node;
+}
+
+void DynamicBvh::refit(int node)
+{
+	BvhNode &n = nodes[node];
+	const BvhNode &a = nodes[n.child1], &b = nodes[n.child2];
+	n.aabb = combine(a.aabb, b.aabb);
+	n.height = 1 + std::max(a.height, b.height);
+	n.category = a.category | b.category;
+}
+
+/*****************************************************************************************
+ *  DynamicBvh::findBestSibling()
+ *  --------------------------------------------------------------------------------------
+ *  Custo de pendurar a folha como irmã de um nó = área da nova caixa pai + o quanto crescem
+ *  as caixas de todos os ancestrais (custo herdado). Desce por um único caminho, sempre
+ *  pelo filho de menor limite inferior de custo, e para quando nenhum filho pode melhorar
+ *  o melhor custo já visto (ramificar e limitar, como na Box2D 3).
+ *****************************************************************************************/
+int DynamicBvh::findBestSibling(const Aabb &leafBox) const
+{
+	const float leafArea = surfaceArea(leafBox);
+	int index = root;
+	float area = surfaceArea(nodes[root].aabb);
+	float directCost = surfaceArea(combine(nodes[root].aabb, leafBox));
+	float inheritedCost = 0.0f;
+	int bestSibling = root;
+	float bestCost = directCost;
+
+	while (nodes[index].height > 0)
+	{
+		float cost = directCost + inheritedCost;
+		if (cost < bestCost)
+		{
+			bestSibling = index;
+			bestCost = cost;
+		}
+		inheritedCost += directCost - area; // Este nó cresce se a folha descer por ele
+
+		const int children[2] = {nodes[index].child1, nodes[index].child2};
+		float childDirect[2], childArea[2], lowerCost[2];
+		for (int c = 0; c < 2; ++c)
+		{
+			const BvhNode &child = nodes[children[c]];
+			childDirect[c] = surfaceArea(combine(child.aabb, leafBox));
+			childArea[c] = surfaceArea(child.aabb);
+			lowerCost[c] = std::numeric_limits<float>::max();
+			if (child.height == 0)
+			{
+				if (childDirect[c] + inheritedCost < bestCost)
+				{
+					bestSibling = children[c];
+					bestCost = childDirect[c] + inheritedCost;
+				}
+			}
+			else
+				lowerCost[c] = inheritedCost + childDirect[c] + std::min(leafArea - childArea[c], 0.0f);
+		}
+		if (bestCost <= lowerCost[0] && bestCost <= lowerCost[1])
+			break;
+
+		int next = lowerCost[0] < lowerCost[1] ? 0 : 1;
+		if (lowerCost[0] == lowerCost[1]) // Empate: o filho com o centro mais perto
+		{
+			glm::vec3 center = 0.5f * (leafBox.min + leafBox.max);
+			glm::vec3 d0 = 0.5f * (nodes[children[0]].aabb.min + nodes[children[0]].aabb.max) - center;
+			glm::vec3 d1 = 0.5f * (nodes[children[1]].aabb.min + nodes[children[1]].aabb.max) - center;
+			next = glm::dot(d0, d0) <= glm::dot(d1, d1) ? 0 : 1;
+		}
+		index = children[next];
+		area = childArea[next];
+		directCost = childDirect[next];
+	}
+	return bestSibling;
+}
+
+void DynamicBvh::insertLeaf(int leaf)
+{
+	if (root == BVH_NULL_NODE)
+	{
+		root = leaf;
+		nodes[root].parent = BVH_NULL_NODE;
+		return;
+	}
+
+	int index = findBestSibling(nodes[leaf].aabb);
+
+	/* Novo pai para a irmã escolhida e a folha */
+	int sibling = index;
+	int oldParent = nodes[sibling].parent;
+	int newParent = allocateNode(); // Pode realocar "nodes"
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+	if (oldParent == BVH_NULL_NODE)
+		root = newParent;
+	else if (nodes[oldParent].child1 == sibling)
+		nodes[oldParent].child1 = newParent;
+	else
+		nodes[oldParent].child2 = newParent;
+
+	for (index = newParent; index != BVH_NULL_NODE; index = nodes[index].parent)
+	{
+		refit(index);
+		rotate(index);
+	}
+}
+
+void DynamicBvh::removeLeaf(int leaf)
+{
+	if (leaf == root)
+	{
+		root = BVH_NULL_NODE;
+		return;
+	}
+
+	int parent = nodes[leaf].parent;
+	int grandParent = nodes[parent].parent;
+	int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+	freeNode(parent);
+	nodes[sibling].parent = grandParent;
+	if (grandParent == BVH_NULL_NODE)
+	{
+		root = sibling;
+		return;
+	}
+	if (nodes[grandParent].child1 == parent)
+		nodes[grandParent].child1 = sibling;
+	else
+		nodes[grandParent].child2 = sibling;
+
+	for (int index = grandParent; index != BVH_NULL_NODE; index = nodes[index].parent)
+	{
+		refit(index);
+		rotate(index);
+	}
+}
+
+/*****************************************************************************************
+ *  DynamicBvh::rotate()
+ *  --------------------------------------------------------------------------------------
+ *  Troca um filho X de A por um neto Y do outro filho P quando isso diminui a caixa de P
+ *  (P passa a ter X e o irmão de Y). A e a soma das outras caixas não mudam, então a área
+ *  total cai exatamente nessa diferença. Das 4 trocas possíveis, faz a melhor.
+ *****************************************************************************************/
+void DynamicBvh::rotate(int a)
+{
+	if (nodes[a].height < 2)
+		return;
+
+	float bestGain = 0.0f;
+	int bestX = BVH_NULL_NODE, bestY = BVH_NULL_NODE;
+	const int children[2] = {nodes[a].child1, nodes[a].child2};
+	for (int side = 0; side < 2; ++side)
+	{
+		int x = children[side], p = children[1 - side];
+		if (nodes[p].height == 0)
+			continue;
+		float area = surfaceArea(nodes[p].aabb);
+		for (int g = 0; g < 2; ++g)
+		{
+			int y = g == 0 ? nodes[p].child1 : nodes[p].child2;
+			int kept = g == 0 ? nodes[p].child2 : nodes[p].child1;
+			float gain = area - surfaceArea(combine(nodes[x].aabb, nodes[kept].aabb));
+			if (gain > bestGain)
+			{
+				bestGain = gain;
+				bestX = x;
+				bestY = y;
+			}
+		}
+	}
+	if (bestX == BVH_NULL_NODE)
+		return;
+
+	int p = nodes[bestY].parent;
+	if (nodes[a].child1 == bestX)
+		nodes[a].child1 = bestY;
+	else
+		nodes[a].child2 = bestY;
+	if (nodes[p].child1 == bestY)
+		nodes[p].child1 = bestX;
+	else
+		nodes[p].child2 = bestX;
+	nodes[bestY].parent = a;
+	nodes[bestX].parent = p;
+	refit(p);
+	refit(a);
+}
+
+/*****************************************************************************************
+ *  DynamicBvh – proxies
+ *****************************************************************************************/
+int DynamicBvh::createProxy(const Aabb &box, void *userData, unsigned int category)
+{
+	int proxy = allocateNode();
+	nodes[proxy].aabb = fatten(box, BVH_FAT_MARGIN);
+	nodes[proxy].tight = box;
+	nodes[proxy].userData = userData;
+	nodes[proxy].category = category;
+	insertLeaf(proxy);
+	++proxies;
+	return proxy;
+}
+
+void DynamicBvh::destroyProxy(int proxyId)
+{
+	removeLeaf(proxyId);
+	freeNode(proxyId);
+	--proxies;
+}
+
+/* Reinsere também quando a caixa gorda atual cabe folgada em uma 4 vezes mais gorda que a
+   nova: objeto que encolheu (ou parou de crescer) não fica com uma caixa inflada para sempre */
+bool DynamicBvh::moveProxy(int proxyId, const Aabb &box)
+{
+	nodes[proxyId].tight = box;
+	const Aabb &fat = nodes[proxyId].aabb;
+	if (contains(fat, box) && contains(fatten(box, 4.0f * BVH_FAT_MARGIN), fat))
+		return false;
+
+	removeLeaf(proxyId);
+	nodes[proxyId].aabb = fatten(box, BVH_FAT_MARGIN);
+	insertLeaf(proxyId);
+	return true;
+}
+
+void DynamicBvh::clear()
+{
+	nodes.clear();
+	root = freeList = BVH_NULL_NODE;
+	proxies = 0;
+}
+
+/*****************************************************************************************
+ *  DynamicBvh::areaRatio() / validate()
+ *****************************************************************************************/
+float DynamicBvh::areaRatio() const
+{
+	if (root == BVH_NULL_NODE)
+		return 0.0f;
+	float rootArea = surfaceArea(nodes[root].aabb), total = 0.0f;
+	for (const BvhNode &node : nodes)
+		if (node.height >= 0)
+			total += surfaceArea(node.aabb);
+	return rootArea > 0.0f ? total / rootArea : 0.0f;
+}
+
+bool DynamicBvh::validate() const
+{
+	if (root == BVH_NULL_NODE)
+		return proxies == 0;
+	if (nodes[root].parent != BVH_NULL_NODE)
+		return false;
+
+	int leaves = 0;
+	Stack stack;
+	stack.push(root);
+	while (!stack.empty())
+	{
+		int index = stack.pop();
+		const BvhNode &node = nodes[index];
+		if (node.height == 0)
+		{
+			++leaves;
+			if (node.child1 != BVH_NULL_NODE || node.child2 != BVH_NULL_NODE || !contains(node.aabb, node.tight))
+				return false;
+			continue;
+		}
+		const BvhNode &a = nodes[node.child1], &b = nodes[node.child2];
+		if (a.parent != index || b.parent != index || node.height != 1 + std::max(a.height, b.height) ||
+				node.category != (a.category | b.category) ||
+				!contains(node.aabb, combine(a.aabb, b.aabb)) || !contains(combine(a.aabb, b.aabb), node.aabb))
+			return false;
+		stack.push(node.child1);
+		stack.push(node.child2);
+	}
+	return leaves == proxies;
+}
+
+/*****************************************************************************************
+ *  DynamicBvh::nearest()
+ *  --------------------------------------------------------------------------------------
+ *  Fila de prioridade pela distância: nós internos e folhas entram pela caixa gorda (limite
+ *  inferior); uma folha retirada volta com a distância da caixa justa, e só é aceita quando
+ *  sai da fila com essa distância exata, antes de qualquer coisa mais próxima.
+ *****************************************************************************************/
+void DynamicBvh::nearest(const glm::vec3 &point, unsigned int k, unsigned int mask, std::vector<int> &result) const
+{
+	result.clear();
+	if (root == BVH_NULL_NODE || k == 0)
+		return;
+
+	/* (distância², nó * 2 + exata) */
+	typedef std::pair<float, int> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	queue.push(Entry(distance2ToAabb(nodes[root].aabb, point), root * 2));
+	while (!queue.empty() && result.size() < k)
+	{
+		Entry entry = queue.top();
+		queue.pop();
+		int index = entry.second >> 1;
+		const BvhNode &node = nodes[index];
+		if (entry.second & 1)
+			result.push_back(index);
+		else if (!(node.category & mask))
+			continue;
+		else if (node.height == 0)
+			queue.push(Entry(distance2ToAabb(node.tight, point), index * 2 + 1));
+		else
+		{
+			queue.push(Entry(distance2ToAabb(nodes[node.child1].aabb, point), node.child1 * 2));
+			queue.push(Entry(distance2ToAabb(nodes[node.child2].aabb, point), node.child2 * 2));
+		}
+	}
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+static inline bool overlaps(const Aabb &a, const Aabb &b)
+{
+	return glm::all(glm::lessThanEqual(a.min, b.max)) && glm::all(glm::greaterThanEqual(a.max, b.min));
+}
+
+/* Caixa inteiramente fora de algum plano (o teste de caixa de CullingBatch) */
+static bool outsideFrustum(const Frustum &frustum, const Aabb &box)
+{
+	glm::vec3 center = 0.5f * (box.min + box.max), extent = 0.5f * (box.max - box.min);
+	for (const glm::vec4 &plane : frustum.planes)
+		if (glm::dot(glm::vec3(plane), center) + plane.w +
+						glm::dot(glm::abs(glm::vec3(plane)), extent) < 0.0f)
+			return true;
+	return false;
+}
+
+/* Melhor tempo (s) de "repetitions" execuções de run() */
+template <typename Run>
+static double bestOf(int repetitions, Run &&run)
+{
+	double best = 0.0;
+	for (int r = 0; r < repetitions; ++r)
+	{
+		auto start = std::chrono::steady_clock::now();
+		run();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (r == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+	return best;
+}
+
+/*****************************************************************************************
+ *  benchmarkBvh()
+ *  --------------------------------------------------------------------------------------
+ *  Para 10.000, 100.000, ... até "maxObjects" caixas espalhadas em um cubo (densidade
+ *  constante), mede o melhor de "repetitions":
+ *   - construção (inserções uma a uma) e quadros com 10% dos objetos em movimento;
+ *   - BENCH_QUERIES consultas de frustum, raio (acerto mais próximo), esfera e 8 mais
+ *     próximos, pela BVH e por força bruta (o frustum pela força bruta é o CullingBatch
+ *     em SSE, como no laço de renderização).
+ *  Os resultados das duas formas são comparados; qualquer diferença é impressa.
+ *****************************************************************************************/
+int benchmarkBvh(unsigned int maxObjects, int repetitions)
+{
+	const int BENCH_QUERIES = 100;
+	const unsigned int K = 8;
+	int status = 0;
+	for (unsigned int objects = 10000;; objects = (objects * 10 > maxObjects && objects != maxObjects) ? maxObjects : objects * 10)
+	{
+		if (objects > maxObjects)
+			objects = maxObjects;
+
+		/* Cena: caixas de 0,4 a 2 unidades, ~1 objeto a cada 4³ unidades */
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		const float side = 4.0f * std::cbrt(static_cast<float>(objects));
+		std::vector<Aabb> boxes(objects);
+		std::vector<glm::vec3> velocities(objects);
+		for (Aabb &box : boxes)
+		{
+			glm::vec3 center(unit(random) * side, unit(random) * side, unit(random) * side);
+			glm::vec3 extent(0.2f + 0.8f * unit(random), 0.2f + 0.8f * unit(random), 0.2f + 0.8f * unit(random));
+			box = Aabb{center - extent, center + extent};
+		}
+		for (glm::vec3 &velocity : velocities)
+			velocity = 0.02f * glm::vec3(unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f);
+
+		/* Consultas: câmeras de 60 graus com alcance de 1/4 do cubo, raios, esferas e pontos */
+		std::vector<Frustum> frustums;
+		std::vector<glm::vec3> origins, directions;
+		for (int q = 0; q < BENCH_QUERIES; ++q)
+		{
+			glm::vec3 origin(unit(random) * side, unit(random) * side, unit(random) * side);
+			glm::vec3 direction = glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) - 0.5f);
+			glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 0.25f * side);
+			frustums.push_back(extractFrustum(projection * glm::lookAt(origin, origin + direction, glm::vec3(0.0f, 1.0f, 0.0f))));
+			origins.push_back(origin);
+			directions.push_back(direction);
+		}
+		const float sphereRadius = 8.0f;
+
+		DynamicBvh bvh;
+		std::vector<int> proxyIds(objects);
+		double build = bestOf(repetitions, [&]()
+													{
+			bvh.clear();
+			for (unsigned int o = 0; o < objects; ++o)
+				proxyIds[o] = bvh.createProxy(boxes[o], &boxes[o], BVH_MESH); });
+
+		/* BENCH_FRAMES quadros em que 10% dos objetos andam (sempre os mesmos, sempre adiante) */
+		const int BENCH_FRAMES = 10;
+		size_t reinserted = 0;
+		double move = bestOf(repetitions, [&]()
+												 {
+			reinserted = 0;
+			for (int frame = 0; frame < BENCH_FRAMES; ++frame)
+				for (unsigned int o = 0; o < objects; o += 10)
+				{
+					boxes[o].min += velocities[o];
+					boxes[o].max += velocities[o];
+					reinserted += bvh.moveProxy(proxyIds[o], boxes[o]);
+				} }) / BENCH_FRAMES;
+		bool valid = bvh.validate();
+
+		/* Frustum: BVH (caixas gordas) + teste exato das candidatas, contra o lote SSE inteiro */
+		size_t bvhVisible = 0, bruteVisible = 0, candidates = 0;
+		double frustumBvh = bestOf(repetitions, [&]()
+															 {
+			bvhVisible = candidates = 0;
+			for (const Frustum &frustum : frustums)
+			{
+				Aabb bounds = frustumBounds(frustum);
+				bvh.queryFrustum(frustum, BVH_ALL, [&](int proxy)
+												 {
+					++candidates;
+					bvhVisible += overlaps(bvh.tightAabb(proxy), bounds) && !outsideFrustum(frustum, bvh.tightAabb(proxy));
+					return true; });
+			} });
+		CullingBatch batch;
+		std::vector<unsigned char> visible;
+		for (const Aabb &box : boxes)
+			batch.add(box.min, box.max);
+		double frustumBrute = bestOf(repetitions, [&]()
+																 {
+			bruteVisible = 0;
+			for (const Frustum &frustum : frustums)
+			{
+				batch.cull(frustum, visible);
+				Aabb bounds = frustumBounds(frustum); // A BVH também corta pela caixa da pirâmide
+				for (size_t o = 0; o < visible.size(); ++o)
+					bruteVisible += visible[o] && overlaps(boxes[o], bounds);
+			} });
+
+		/* Raios: acerto mais próximo nas caixas justas, até a aresta do cubo */
+		std::vector<float> bvhHits(BENCH_QUERIES), bruteHits(BENCH_QUERIES);
+		double rayBvh = bestOf(repetitions, [&]()
+													 {
+			for (int q = 0; q < BENCH_QUERIES; ++q)
+			{
+				glm::vec3 inverse = 1.0f / directions[q];
+				bvhHits[q] = side;
+				bvh.rayCast(origins[q], directions[q], side, BVH_ALL, [&](int proxy, float maxDistance)
+										{
+					float distance;
+					if (!rayHitsAabb(bvh.tightAabb(proxy), origins[q], inverse, maxDistance, &distance))
+						return -1.0f;
+					bvhHits[q] = distance;
+					return distance > 0.0f ? distance : 0.0f; });
+			} });
+		double rayBrute = bestOf(repetitions, [&]()
+														 {
+			for (int q = 0; q < BENCH_QUERIES; ++q)
+			{
+				glm::vec3 inverse = 1.0f / directions[q];
+				bruteHits[q] = side;
+				for (const Aabb &box : boxes)
+				{
+					float distance;
+					if (rayHitsAabb(box, origins[q], inverse, bruteHits[q], &distance))
+						bruteHits[q] = distance;
+				}
+			} });
+
+		/* Esferas: quantas caixas justas cada uma toca */
+		size_t bvhOverlaps = 0, bruteOverlaps = 0;
+		double sphereBvh = bestOf(repetitions, [&]()
+															{
+			bvhOverlaps = 0;
+			for (const glm::vec3 &center : origins)
+				bvh.querySphere(center, sphereRadius, BVH_ALL, [&](int proxy)
+												{
+					bvhOverlaps += distance2ToAabb(bvh.tightAabb(proxy), center) <= sphereRadius * sphereRadius;
+					return true; }); });
+		double sphereBrute = bestOf(repetitions, [&]()
+																{
+			bruteOverlaps = 0;
+			for (const glm::vec3 &center : origins)
+				for (const Aabb &box : boxes)
+					bruteOverlaps += distance2ToAabb(box, center) <= sphereRadius * sphereRadius; });
+
+		/* K mais próximos: compara as distâncias (empates podem trocar a ordem dos ids) */
+		std::vector<float> bvhNearest, bruteNearest;
+		std::vector<int> found;
+		double nearestBvh = bestOf(repetitions, [&]()
+															 {
+			bvhNearest.clear();
+			for (const glm::vec3 &point : origins)
+			{
+				bvh.nearest(point, K, BVH_ALL, found);
+				for (int proxy : found)
+					bvhNearest.push_back(distance2ToAabb(bvh.tightAabb(proxy), point));
+			} });
+		std::vector<float> distances(objects);
+		double nearestBrute = bestOf(repetitions, [&]()
+																 {
+			bruteNearest.clear();
+			for (const glm::vec3 &point : origins)
+			{
+				for (unsigned int o = 0; o < objects; ++o)
+					distances[o] = distance2ToAabb(boxes[o], point);
+				std::partial_sort(distances.begin(), distances.begin() + K, distances.end());
+				bruteNearest.insert(bruteNearest.end(), distances.begin(), distances.begin() + K);
+			} });
+
+		bool same = valid && bvhVisible == bruteVisible && bvhHits == bruteHits && bvhOverlaps == bruteOverlaps &&
+								bvhNearest == bruteNearest;
+		if (!same)
+			status = -1;
+
+		const double perQuery = 1e6 / BENCH_QUERIES; // s -> us por consulta
+		std::cout << "BVH: " << objects << " objetos, altura " << bvh.height() << ", area " << bvh.areaRatio()
+							<< "x a raiz, melhor de " << repetitions << ": construcao " << build * 1000.0 << " ms, quadro com "
+							<< (objects + 9) / 10 << " em movimento " << move * 1000.0 << " ms (" << reinserted / BENCH_FRAMES
+							<< " reinserido(s))\n"
+							<< "  frustum: " << frustumBvh * perQuery << " us (" << candidates / BENCH_QUERIES << " candidato(s), "
+							<< bvhVisible / BENCH_QUERIES << " visivel(is)) x forca bruta SSE " << frustumBrute * perQuery << " us\n"
+							<< "  raio: " << rayBvh * perQuery << " us x forca bruta " << rayBrute * perQuery << " us\n"
+							<< "  esfera (raio " << sphereRadius << "): " << sphereBvh * perQuery << " us ("
+							<< bvhOverlaps / BENCH_QUERIES << " objeto(s)) x forca bruta " << sphereBrute * perQuery << " us\n"
+							<< "  " << K << " mais proximos: " << nearestBvh * perQuery << " us x forca bruta "
+							<< nearestBrute * perQuery << " us" << (same ? "" : "  RESULTADOS DIFERENTES") << std::endl;
+		if (objects == maxObjects)
+			break;
+	}
+	return status;
+}
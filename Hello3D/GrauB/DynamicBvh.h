@@ -0,0 +1,299 @@
+// DynamicBvh.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <algorithm> // std::min / std::max
+#include <cmath>		 // std::fabs
+#include <vector>		 // Necessário para usar std::vector
+
+#include <glm/glm.hpp> // glm::vec3 / glm::mat4
+
+#include "Culling.h" // Frustum
+
+// Nó inexistente (filho de folha, pai da raiz, fim da lista livre, proxy ainda não criado)
+const int BVH_NULL_NODE = -1;
+
+// Folga das caixas gordas, relativa à maior meia extensão do objeto: enquanto a caixa justa
+// couber na gorda, mover o objeto não mexe na árvore
+const float BVH_FAT_MARGIN = 0.1f;
+
+// Categorias das folhas (máscaras das consultas)
+const unsigned int BVH_MESH = 1u;
+const unsigned int BVH_CURVE = 2u;
+const unsigned int BVH_ALL = ~0u;
+
+// Caixa alinhada aos eixos do mundo
+struct Aabb
+{
+	glm::vec3 min, max;
+};
+
+// Caixa de [boxMin, boxMax] transformada por model, recalculada para os eixos do mundo (Arvo)
+Aabb transformAabb(const glm::vec3 &boxMin, const glm::vec3 &boxMax, const glm::mat4 &model);
+
+// Distância até uma caixa ao longo de um raio (direção com componentes nulas aceitas);
+// false se o raio não a atinge em [0, maxDistance]
+bool rayHitsAabb(const Aabb &box, const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance,
+								 float *distance = nullptr);
+
+// Caixa dos 8 cantos da pirâmide de visão (interseções de 3 planos); corta na travessia os
+// nós que ficam fora dela sem estar inteiramente atrás de nenhum plano (perto das arestas)
+Aabb frustumBounds(const Frustum &frustum);
+
+// Quadrado da distância de um ponto até uma caixa (0 dentro dela)
+float distance2ToAabb(const Aabb &box, const glm::vec3 &point);
+
+struct BvhNode
+{
+	Aabb aabb;						 // Folha: caixa gorda; interno: união dos filhos
+	Aabb tight;						 // Folha: caixa justa (k mais próximos); interno: não usado
+	void *userData;				 // Objeto da folha
+	unsigned int category; // Folha: categoria; interno: OU das categorias dos filhos
+	int parent;						 // Nó livre: próximo da lista livre
+	int child1, child2;		 // BVH_NULL_NODE nas folhas
+	int height;						 // Folha = 0; livre = -1
+};
+
+// Árvore de caixas dinâmica (no estilo da b2DynamicTree da Box2D, em 3D): cada objeto é uma
+// folha com uma caixa gorda. A inserção procura a irmã de menor custo de área de superfície,
+// e cada ancestral refeito tenta uma rotação que diminua a área total, então a árvore se
+// mantém boa sem reconstruções. Os nós ficam em um vetor com lista livre (ids estáveis)
+class DynamicBvh
+{
+private:
+	std::vector<BvhNode> nodes;
+	int root = BVH_NULL_NODE;
+	int freeList = BVH_NULL_NODE;
+	int proxies = 0;
+
+	int allocateNode();
+	void freeNode(int node);
+	void insertLeaf(int leaf);
+	void removeLeaf(int leaf);
+	void refit(int node); // Caixa, altura e categorias a partir dos filhos
+	int findBestSibling(const Aabb &leafBox) const;
+	void rotate(int node);
+
+	// Pilha da travessia (nunca passa da altura + 1): 64 entradas locais, o resto no heap
+	class Stack
+	{
+	private:
+		int local[64];
+		std::vector<int> spill;
+		int count = 0;
+
+	public:
+		void push(int node)
+		{
+			if (count < 64)
+				local[count] = node;
+			else
+				spill.push_back(node);
+			++count;
+		}
+		int pop()
+		{
+			--count;
+			if (count < 64)
+				return local[count];
+			int node = spill.back();
+			spill.pop_back();
+			return node;
+		}
+		bool empty() const { return count == 0; }
+	};
+
+public:
+	// Cria uma folha para a caixa justa box; devolve o id do proxy
+	int createProxy(const Aabb &box, void *userData, unsigned int category);
+	void destroyProxy(int proxyId);
+
+	// Nova caixa justa. Só reinsere a folha se ela saiu da caixa gorda (ou se a gorda ficou
+	// grande demais para ela); devolve true nesse caso
+	bool moveProxy(int proxyId, const Aabb &box);
+
+	void clear();
+
+	void *userData(int proxyId) const { return nodes[proxyId].userData; }
+	unsigned int category(int proxyId) const { return nodes[proxyId].category; }
+	const Aabb &fatAabb(int proxyId) const { return nodes[proxyId].aabb; }
+	const Aabb &tightAabb(int proxyId) const { return nodes[proxyId].tight; }
+	int proxyCount() const { return proxies; }
+	int height() const { return root == BVH_NULL_NODE ? 0 : nodes[root].height; }
+
+	// Soma das áreas de todos os nós dividida pela área da raiz (qualidade da árvore)
+	float areaRatio() const;
+
+	// Verifica pais, alturas, caixas e categorias (depuração)
+	bool validate() const;
+
+	// callback(proxyId) para cada folha de categoria em mask cuja caixa gorda toca box;
+	// devolver false interrompe a consulta
+	template <typename Callback>
+	void queryAabb(const Aabb &box, unsigned int mask, Callback &&callback) const;
+
+	// Idem, com a esfera (teste exato esfera x caixa gorda)
+	template <typename Callback>
+	void querySphere(const glm::vec3 &center, float radius, unsigned int mask, Callback &&callback) const;
+
+	// Folhas cuja caixa gorda não está inteiramente fora de algum plano. Subárvores inteiras
+	// dentro da pirâmide são entregues sem mais testes
+	template <typename Callback>
+	void queryFrustum(const Frustum &frustum, unsigned int mask, Callback &&callback) const;
+
+	// Raio origin + t * direction, t em [0, maxDistance]. callback(proxyId, maxDistance) devolve
+	// < 0 para ignorar a folha, 0 para parar, ou o novo maxDistance (ex.: a distância do acerto
+	// exato, para achar o mais próximo)
+	template <typename Callback>
+	void rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, unsigned int mask,
+							 Callback &&callback) const;
+
+	// Os k proxies de categoria em mask com a caixa justa mais próxima de point, do mais
+	// próximo ao mais distante (busca best-first: as caixas gordas limitam por baixo)
+	void nearest(const glm::vec3 &point, unsigned int k, unsigned int mask, std::vector<int> &result) const;
+};
+
+template <typename Callback>
+void DynamicBvh::queryAabb(const Aabb &box, unsigned int mask, Callback &&callback) const
+{
+	Stack stack;
+	if (root != BVH_NULL_NODE)
+		stack.push(root);
+	while (!stack.empty())
+	{
+		int index = stack.pop();
+		const BvhNode &node = nodes[index];
+		if (!(node.category & mask) || glm::any(glm::lessThan(node.aabb.max, box.min)) ||
+				glm::any(glm::greaterThan(node.aabb.min, box.max)))
+			continue;
+		if (node.height == 0)
+		{
+			if (!callback(index))
+				return;
+		}
+		else
+		{
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+template <typename Callback>
+void DynamicBvh::querySphere(const glm::vec3 &center, float radius, unsigned int mask, Callback &&callback) const
+{
+	Stack stack;
+	if (root != BVH_NULL_NODE)
+		stack.push(root);
+	while (!stack.empty())
+	{
+		int index = stack.pop();
+		const BvhNode &node = nodes[index];
+		if (!(node.category & mask) || distance2ToAabb(node.aabb, center) > radius * radius)
+			continue;
+		if (node.height == 0)
+		{
+			if (!callback(index))
+				return;
+		}
+		else
+		{
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+/* Cada entrada da pilha leva os planos que ainda precisam ser testados (bit i = plano i):
+   um plano do qual o nó está inteiramente dentro também contém todos os descendentes */
+template <typename Callback>
+void DynamicBvh::queryFrustum(const Frustum &frustum, unsigned int mask, Callback &&callback) const
+{
+	const Aabb bounds = frustumBounds(frustum);
+	Stack stack;
+	if (root != BVH_NULL_NODE)
+		stack.push(root << 6 | 0x3F);
+	while (!stack.empty())
+	{
+		int entry = stack.pop();
+		int index = entry >> 6;
+		unsigned int planes = entry & 0x3F;
+		const BvhNode &node = nodes[index];
+		if (!(node.category & mask) || glm::any(glm::lessThan(node.aabb.max, bounds.min)) ||
+				glm::any(glm::greaterThan(node.aabb.min, bounds.max)))
+			continue;
+
+		glm::vec3 center = 0.5f * (node.aabb.min + node.aabb.max), extent = 0.5f * (node.aabb.max - node.aabb.min);
+		bool outside = false;
+		for (int p = 0; p < 6 && !outside; ++p)
+		{
+			if (!(planes & (1u << p)))
+				continue;
+			const glm::vec4 &plane = frustum.planes[p];
+			float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			float radius = std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y + std::fabs(plane.z) * extent.z;
+			if (distance + radius < 0.0f)
+				outside = true;
+			else if (distance - radius >= 0.0f)
+				planes &= ~(1u << p);
+		}
+		if (outside)
+			continue;
+
+		if (node.height == 0)
+		{
+			if (!callback(index))
+				return;
+		}
+		else
+		{
+			stack.push(node.child1 << 6 | static_cast<int>(planes));
+			stack.push(node.child2 << 6 | static_cast<int>(planes));
+		}
+	}
+}
+
+template <typename Callback>
+void DynamicBvh::rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, unsigned int mask,
+												 Callback &&callback) const
+{
+	glm::vec3 inverseDirection = 1.0f / direction; // ±infinito nos eixos paralelos ao raio
+	Stack stack;
+	if (root != BVH_NULL_NODE)
+		stack.push(root);
+	while (!stack.empty())
+	{
+		int index = stack.pop();
+		const BvhNode &node = nodes[index];
+		if (!(node.category & mask) || !rayHitsAabb(node.aabb, origin, inverseDirection, maxDistance))
+			continue;
+		if (node.height == 0)
+		{
+			float value = callback(index, maxDistance);
+			if (value == 0.0f)
+				return;
+			if (value > 0.0f)
+				maxDistance = std::min(maxDistance, value);
+		}
+		else
+		{
+			/* O filho mais próximo por último na pilha: sai primeiro e encurta o raio antes */
+			float distance1, distance2;
+			bool hit1 = rayHitsAabb(nodes[node.child1].aabb, origin, inverseDirection, maxDistance, &distance1);
+			bool hit2 = rayHitsAabb(nodes[node.child2].aabb, origin, inverseDirection, maxDistance, &distance2);
+			if (hit1 && hit2)
+			{
+				stack.push(distance1 < distance2 ? node.child2 : node.child1);
+				stack.push(distance1 < distance2 ? node.child1 : node.child2);
+			}
+			else if (hit1)
+				stack.push(node.child1);
+			else if (hit2)
+				stack.push(node.child2);
+		}
+	}
+}
+
+// Constrói árvores sintéticas de 10.000 até "maxObjects" objetos e compara as consultas da
+// BVH com a força bruta: construção, objetos em movimento, frustum, raios, esferas e k mais
+// próximos (tempos e resultados). Uso: Hello3D --bench-bvh [objetos] [repetições]
+int benchmarkBvh(unsigned int maxObjects, int repetitions);
@@ -0,0 +1,148 @@
+// FileWatcher.cpp
+#include "FileWatcher.h"
+
+#include <algorithm> // std::sort / std::unique
+
+#include "AssetCache.h" // canonicalPath
+
+#ifdef __linux__
+#include <sys/inotify.h> // inotify_init1 / inotify_add_watch
+#include <unistd.h>			 // read / close
+#endif
+
+FileWatcher::FileWatcher() : lastScan(std::chrono::steady_clock::now())
+{
+#ifdef __linux__
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+	if (inotifyFd >= 0)
+		close(inotifyFd); // Remove todas as observações
+#endif
+}
+
+bool FileWatcher::isNative() const
+{
+#ifdef __linux__
+	return inotifyFd >= 0;
+#else
+	return false;
+#endif
+}
+
+/* Data de modificação e tamanho atuais (exists = false se o arquivo não existir) */
+FileWatcher::FileState FileWatcher::stateOf(const std::string &path)
+{
+	std::error_code ec;
+	FileState state{false, {}, 0};
+	state.time = std::filesystem::last_write_time(path, ec);
+	if (ec)
+		return state;
+	state.size = std::filesystem::file_size(path, ec);
+	state.exists = !ec;
+	return state;
+}
+
+/*****************************************************************************************
+ *  watch()
+ *  --------------------------------------------------------------------------------------
+ *  Registra o arquivo. Com inotify, observa o diretório dele (um descritor por diretório,
+ *  compartilhado por todos os arquivos que estão lá).
+ *****************************************************************************************/
+void FileWatcher::watch(const std::string &path)
+{
+	std::string canonical = canonicalPath(path);
+	if (!files.emplace(canonical, stateOf(canonical)).second)
+		return;
+
+#ifdef __linux__
+	if (inotifyFd < 0)
+		return;
+	std::string directory = std::filesystem::path(canonical).parent_path().generic_string();
+	if (watchedDirs.count(directory))
+		return;
+	int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (wd >= 0)
+	{
+		watchedDirs[directory] = wd;
+		directories[wd] = directory;
+	}
+#endif
+}
+
+/*****************************************************************************************
+ *  scan()
+ *  --------------------------------------------------------------------------------------
+ *  Compara o estado de cada arquivo com o da última varredura.
+ *****************************************************************************************/
+void FileWatcher::scan(std::vector<std::string> &changed)
+{
+	for (auto &pair : files)
+	{
+		FileState state = stateOf(pair.first);
+		if (state.exists != pair.second.exists || state.time != pair.second.time || state.size != pair.second.size)
+		{
+			pair.second = state;
+			if (state.exists) // Apagado: espera ele voltar
+				changed.push_back(pair.first);
+		}
+	}
+}
+
+/*****************************************************************************************
+ *  poll()
+ *  --------------------------------------------------------------------------------------
+ *  inotify: lê todos os eventos pendentes (o descritor não bloqueia) e mantém só os dos
+ *  arquivos registrados, sem repetições. Sem inotify: varredura a cada FILE_WATCH_POLL_MS.
+ *****************************************************************************************/
+void FileWatcher::poll(std::vector<std::string> &changed)
+{
+	size_t first = changed.size();
+
+#ifdef __linux__
+	if (inotifyFd >= 0)
+	{
+		alignas(inotify_event) char buffer[4096];
+		bool overflow = false;
+		ssize_t length;
+		while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+			for (char *p = buffer; p < buffer + length;)
+			{
+				const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+				p += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+					overflow = true;
+				auto directory = directories.find(event->wd);
+				if (event->len == 0 || directory == directories.end())
+					continue;
+				auto file = files.find(directory->second + "/" + event->name);
+				if (file != files.end())
+				{
+					file->second = stateOf(file->first); // Base para uma eventual varredura
+					changed.push_back(file->first);
+				}
+			}
+
+		/* Eventos perdidos: descobre o que mudou comparando datas */
+		if (overflow)
+			scan(changed);
+	}
+	else
+#endif
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastScan < std::chrono::milliseconds(FILE_WATCH_POLL_MS))
+			return;
+		lastScan = now;
+		scan(changed);
+	}
+
+	/* Um arquivo salvo várias vezes desde a última chamada aparece uma vez só */
+	std::sort(changed.begin() + first, changed.end());
+	changed.erase(std::unique(changed.begin() + first, changed.end()), changed.end());
+}
@@ -0,0 +1,54 @@
+// FileWatcher.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <chrono>				 // Intervalo da varredura
+#include <cstdint>			 // std::uintmax_t
+#include <filesystem>		 // Data de modificação dos arquivos
+#include <string>				 // Necessário para usar std::string
+#include <unordered_map> // Arquivos e diretórios observados
+#include <vector>				 // Necessário para usar std::vector
+
+// Intervalo (ms) entre varreduras quando o inotify não está disponível
+const int FILE_WATCH_POLL_MS = 250;
+
+// Observa arquivos e informa quais foram alterados desde a última consulta.
+// No Linux usa inotify sobre os diretórios dos arquivos (pega também editores que salvam
+// em um arquivo temporário e o renomeiam); nas outras plataformas, ou se o inotify falhar,
+// compara a data de modificação e o tamanho a cada FILE_WATCH_POLL_MS.
+class FileWatcher
+{
+private:
+	struct FileState
+	{
+		bool exists;
+		std::filesystem::file_time_type time;
+		std::uintmax_t size;
+	};
+
+	std::unordered_map<std::string, FileState> files; // Caminho canônico -> último estado visto
+	std::chrono::steady_clock::time_point lastScan;
+#ifdef __linux__
+	int inotifyFd = -1;
+	std::unordered_map<int, std::string> directories;	 // Descritor do inotify -> diretório
+	std::unordered_map<std::string, int> watchedDirs;	 // Diretório -> descritor do inotify
+#endif
+
+	static FileState stateOf(const std::string &path);
+	void scan(std::vector<std::string> &changed);
+
+public:
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher &) = delete;
+	FileWatcher &operator=(const FileWatcher &) = delete;
+
+	// Passa a observar o arquivo (o caminho pode ser relativo; chamadas repetidas são ignoradas)
+	void watch(const std::string &path);
+
+	// Não bloqueia: acrescenta a "changed" os caminhos canônicos alterados desde a última chamada
+	void poll(std::vector<std::string> &changed);
+
+	// true se as alterações chegam pelo inotify (false = varredura periódica)
+	bool isNative() const;
+};
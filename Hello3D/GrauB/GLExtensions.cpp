@@ -0,0 +1,44 @@
+// GLExtensions.cpp
+#include "GLExtensions.h" // Inclui o arquivo de cabeçalho das extensões OpenGL
+
+#include <cstring> // strcmp
+
+PFNGLTEXSTORAGE2DEXTPROC ext_glTexStorage2D = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTEXTPROC ext_glMultiDrawElementsIndirect = nullptr;
+
+/*****************************************************************************************
+ *  loadGLExtensions()
+ *  --------------------------------------------------------------------------------------
+ *  Cada ponteiro só é carregado se a versão do contexto ou a extensão correspondente
+ *  garantir a função; caso contrário fica nulo e o chamador usa o caminho antigo.
+ *****************************************************************************************/
+void loadGLExtensions(GLADloadproc load)
+{
+	bool gl42 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 2);
+	if (gl42 || hasGLExtension("GL_ARB_texture_storage"))
+		ext_glTexStorage2D = reinterpret_cast<PFNGLTEXSTORAGE2DEXTPROC>(load("glTexStorage2D"));
+
+	// Os comandos indiretos usam baseInstance (ARB_base_instance, núcleo no 4.2)
+	bool gl43 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+	if (gl43 || (hasGLExtension("GL_ARB_multi_draw_indirect") && (gl42 || hasGLExtension("GL_ARB_base_instance"))))
+		ext_glMultiDrawElementsIndirect =
+				reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTEXTPROC>(load("glMultiDrawElementsIndirect"));
+}
+
+/*****************************************************************************************
+ *  hasGLExtension()
+ *  --------------------------------------------------------------------------------------
+ *  No perfil core a lista de extensões é lida uma a uma com glGetStringi.
+ *****************************************************************************************/
+bool hasGLExtension(const char *name)
+{
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; ++i)
+	{
+		const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+		if (extension && std::strcmp(extension, name) == 0)
+			return true;
+	}
+	return false;
+}
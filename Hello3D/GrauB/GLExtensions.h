@@ -0,0 +1,44 @@
+// GLExtensions.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <glad/glad.h> // Inclui a biblioteca GLAD para funcionalidades OpenGL
+
+// O GLAD do projeto foi gerado para OpenGL 3.3 core sem extensões: as constantes e funções
+// usadas além disso são declaradas aqui e consultadas em tempo de execução.
+
+// --- GL_EXT_texture_compression_s3tc (BC1 / BC3) ----------------------------
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// --- GL_ARB_texture_storage (núcleo no 4.2) ----------------------------------
+#ifndef GL_TEXTURE_IMMUTABLE_FORMAT
+#define GL_TEXTURE_IMMUTABLE_FORMAT 0x912F
+#endif
+typedef void(APIENTRYP PFNGLTEXSTORAGE2DEXTPROC)(GLenum target, GLsizei levels, GLenum internalformat,
+																								 GLsizei width, GLsizei height);
+extern PFNGLTEXSTORAGE2DEXTPROC ext_glTexStorage2D; // nullptr se o driver não suportar
+
+// --- GL_ARB_multi_draw_indirect (núcleo no 4.3) ----------------------------
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+typedef void(APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTEXTPROC)(GLenum mode, GLenum type, const void *indirect,
+																															 GLsizei drawcount, GLsizei stride);
+extern PFNGLMULTIDRAWELEMENTSINDIRECTEXTPROC ext_glMultiDrawElementsIndirect; // nullptr se o driver não suportar
+
+// --- GL_ARB_shader_storage_buffer_object (núcleo no 4.3) ---------------------
+// Só a constante: glBindBufferBase já é do 3.0 e o binding vem do layout no GLSL
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+
+// Carrega os ponteiros das funções acima (chamar logo após gladLoadGLLoader, com o mesmo loader)
+void loadGLExtensions(GLADloadproc load);
+
+// true se o contexto atual anuncia a extensão (ex.: "GL_EXT_texture_compression_s3tc").
+// Requer um contexto OpenGL ativo e o GLAD já carregado
+bool hasGLExtension(const char *name);
@@ -0,0 +1,221 @@
+// GeometryRegistry.cpp
+#include "GeometryRegistry.h" // Inclui o arquivo de cabeçalho do registro de geometrias
+
+#include <cstring>	// std::memcpy
+#include <iostream> // Saída de dados no console
+
+#include "MappedFile.h" // Leitura do .obj para calcular o hash
+
+/*****************************************************************************************
+ *  GeometryRegistry::setupGeometry()
+ *  --------------------------------------------------------------------------------------
+ *  Copia vértices e índices para trechos dos buffers compartilhados e preenche os
+ *  deslocamentos em "geometry". Os índices já vêm do cache em 16 bits quando todos cabem
+ *  (metade da memória); caso contrário, em 32 bits. Como são relativos ao primeiro vértice
+ *  da geometria (baseVertex no desenho), os de 16 bits continuam valendo no buffer grande.
+ *  Se o buffer de vértices foi recriado para crescer, os atributos de MeshVertexLayout são
+ *  apontados para o novo.
+ *****************************************************************************************/
+void GeometryRegistry::setupGeometry(const GeometryView &view, SharedGeometry &geometry)
+{
+	GLuint previousVertices = vertices.getId();
+	BufferArena &indices = (view.indexSize == 2) ? indices16 : indices32;
+	geometry.baseVertex = static_cast<GLint>(vertices.allocate(view.vertexCount, view.vertices));
+	geometry.vertexCount = static_cast<GLsizei>(view.vertexCount);
+	geometry.firstIndex = static_cast<GLuint>(indices.allocate(view.indexCount, view.indices));
+
+	if (vertexArray == 0 || vertices.getId() != previousVertices)
+	{
+		if (vertexArray == 0)
+			glGenVertexArrays(1, &vertexArray);
+		glBindVertexArray(vertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, vertices.getId());
+		MeshVertexLayout::enable();
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	geometry.indexCount = static_cast<GLsizei>(view.indexCount);
+	geometry.indexType = (view.indexSize == 2) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	geometry.bounds = view.bounds;
+	geometry.sphere = view.sphere;
+	geometry.lodCount = view.lodCount;
+	std::memcpy(geometry.lods, view.lods, sizeof(geometry.lods));
+	geometry.meshlets.assign(view.meshlets, view.meshlets + view.meshletCount);
+	geometry.gpuBytes = view.vertexCount * MeshVertexLayout::stride + static_cast<size_t>(view.indexCount) * view.indexSize;
+}
+
+void GeometryRegistry::freeGeometry(SharedGeometry &geometry)
+{
+	vertices.free(static_cast<size_t>(geometry.baseVertex), static_cast<size_t>(geometry.vertexCount));
+	(geometry.indexType == GL_UNSIGNED_SHORT ? indices16 : indices32).free(geometry.firstIndex, static_cast<size_t>(geometry.indexCount));
+}
+
+/*****************************************************************************************
+ *  GeometryRegistry::acquire()
+ *  --------------------------------------------------------------------------------------
+ *  1. Procura o caminho canônico: acerto = só incrementa refCount (nem abre o arquivo).
+ *  2. Mapeia o .obj e procura pelo hash do conteúdo (cópias do mesmo modelo com outro nome).
+ *  3. Só então carrega a geometria (cache de assets ou parser) e a copia para a GPU.
+ *****************************************************************************************/
+GeometryId GeometryRegistry::acquire(const std::string &objPath)
+{
+	++requests;
+	std::string path = canonicalPath(objPath);
+
+	auto pathIt = byPath.find(path);
+	if (pathIt != byPath.end())
+	{
+		++entries[pathIt->second].refCount;
+		return pathIt->second;
+	}
+
+	MappedFile source(objPath);
+	if (!source.isOpen())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << objPath << std::endl;
+		return INVALID_GEOMETRY;
+	}
+	unsigned long long hash = hashAsset(source);
+
+	auto hashIt = byHash.find(hash);
+	if (hashIt != byHash.end())
+	{
+		byPath[path] = hashIt->second; // Próximas referências a este caminho nem mapeiam o arquivo
+		++entries[hashIt->second].refCount;
+		return hashIt->second;
+	}
+
+	AssetBlob blob;
+	GeometryView view{};
+	if (!loadGeometryAsset(source, hash, objPath, blob, view))
+		return INVALID_GEOMETRY;
+	return upload(path, hash, view);
+}
+
+/* Versão para geometria já pronta (ex.: pacote de cena): mesmas buscas, sem abrir o .obj */
+GeometryId GeometryRegistry::acquire(const std::string &objPath, unsigned long long sourceHash,
+																		 const GeometryView &view)
+{
+	++requests;
+	std::string path = canonicalPath(objPath);
+
+	auto pathIt = byPath.find(path);
+	if (pathIt != byPath.end())
+	{
+		++entries[pathIt->second].refCount;
+		return pathIt->second;
+	}
+
+	auto hashIt = byHash.find(sourceHash);
+	if (hashIt != byHash.end())
+	{
+		byPath[path] = hashIt->second;
+		++entries[hashIt->second].refCount;
+		return hashIt->second;
+	}
+	return upload(path, sourceHash, view);
+}
+
+/* Copia a geometria para um slot livre e indexa por caminho e por hash */
+GeometryId GeometryRegistry::upload(const std::string &path, unsigned long long hash, const GeometryView &view)
+{
+	/* Reaproveita um slot liberado, se houver */
+	GeometryId id = 0;
+	while (id < entries.size() && entries[id].refCount != 0)
+		++id;
+	if (id == entries.size())
+		entries.emplace_back();
+
+	SharedGeometry &geometry = entries[id];
+	geometry.path = path;
+	geometry.sourceHash = hash;
+	geometry.refCount = 1;
+	setupGeometry(view, geometry);
+	++uploads;
+
+	byPath[path] = id;
+	byHash[hash] = id;
+	return id;
+}
+
+/*****************************************************************************************
+ *  GeometryRegistry::release()
+ *****************************************************************************************/
+void GeometryRegistry::release(GeometryId id)
+{
+	if (id >= entries.size() || entries[id].refCount == 0)
+		return;
+
+	SharedGeometry &geometry = entries[id];
+	if (--geometry.refCount != 0)
+		return;
+
+	freeGeometry(geometry);
+
+	/* Remove todos os caminhos que apontavam para este slot */
+	for (auto it = byPath.begin(); it != byPath.end();)
+		it = (it->second == id) ? byPath.erase(it) : std::next(it);
+	byHash.erase(geometry.sourceHash);
+	geometry = SharedGeometry{};
+}
+
+/*****************************************************************************************
+ *  GeometryRegistry::invalidate()
+ *****************************************************************************************/
+void GeometryRegistry::invalidate(const std::string &objPath)
+{
+	byPath.erase(canonicalPath(objPath));
+}
+
+void GeometryRegistry::clear()
+{
+	if (vertexArray != 0)
+		glDeleteVertexArrays(1, &vertexArray);
+	vertexArray = 0;
+	entries.clear();
+	byPath.clear();
+	byHash.clear();
+	vertices.release();
+	indices16.release();
+	indices32.release();
+}
+
+/*****************************************************************************************
+ *  selectLod()
+ *  --------------------------------------------------------------------------------------
+ *  O erro de cada nível é relativo ao raio da geometria, então em pixels ele vale
+ *  error * screenRadius. Refina enquanto o nível atual passar do limite e só simplifica
+ *  enquanto o próximo ficar abaixo do limite com a margem de histerese.
+ *****************************************************************************************/
+unsigned int selectLod(const MeshLod *lods, unsigned int lodCount, float screenRadius, unsigned int current)
+{
+	if (lodCount == 0)
+		return 0;
+	unsigned int lod = (current < lodCount) ? current : lodCount - 1;
+	while (lod > 0 && lods[lod].error * screenRadius > LOD_PIXEL_ERROR)
+		--lod;
+	while (lod + 1 < lodCount && lods[lod + 1].error * screenRadius <= LOD_PIXEL_ERROR * (1.0f - LOD_HYSTERESIS))
+		++lod;
+	return lod;
+}
+
+/*****************************************************************************************
+ *  GeometryRegistry::printStats()
+ *****************************************************************************************/
+void GeometryRegistry::printStats() const
+{
+	unsigned int unique = 0;
+	size_t bytes = 0;
+	for (const SharedGeometry &geometry : entries)
+		if (geometry.refCount != 0)
+		{
+			++unique;
+			bytes += geometry.gpuBytes;
+		}
+
+	size_t capacity = vertices.capacityBytes() + indices16.capacityBytes() + indices32.capacityBytes();
+	std::cout << "Geometrias: " << requests << " referencia(s), " << unique << " unica(s), "
+						<< uploads << " envio(s) para a GPU, " << bytes / 1024.0 << " KB de VBO/EBO em "
+						<< capacity / 1024.0 << " KB de buffers compartilhados" << std::endl;
+}
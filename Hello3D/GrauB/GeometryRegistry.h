@@ -0,0 +1,105 @@
+// GeometryRegistry.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string>				 // Necessário para usar std::string
+#include <unordered_map> // Índices por caminho e por conteúdo
+#include <vector>				 // Necessário para usar std::vector
+
+#include <glad/glad.h> // Tipos OpenGL (GLuint, GLenum...)
+
+#include "AssetCache.h"	 // GeometryView
+#include "BufferArena.h" // Vértices e índices de todas as geometrias em poucos buffers
+
+// Geometria já enviada para a GPU, compartilhada por todas as malhas que usam o mesmo .obj
+struct SharedGeometry
+{
+	std::string path;							 // Caminho canônico do .obj
+	unsigned long long sourceHash; // Hash do conteúdo do .obj
+	GLint baseVertex;							 // Primeiro vértice no buffer de vértices compartilhado
+	GLsizei vertexCount;
+	GLuint firstIndex;						 // Primeiro índice no buffer de índices do indexType
+	GLsizei indexCount;						 // Número de índices (3 por triângulo)
+	GLenum indexType;							 // GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT (relativos a baseVertex)
+	VertexBounds bounds;					 // Uniformes positionOffset / positionScale do shader
+	BoundingSphere sphere;				 // Esfera envolvente no espaço do objeto
+	unsigned int lodCount;				 // Níveis de detalhe (LOD 0 = malha original)
+	MeshLod lods[MESH_LOD_MAX];		 // Trechos de cada nível (relativos a firstIndex)
+	std::vector<Meshlet> meshlets; // Clusters dos níveis (descarte na CPU, a cada quadro)
+	size_t gpuBytes;							 // Tamanho de VBO + EBO
+	unsigned int refCount;				 // Malhas que ainda usam esta geometria (0 = slot livre)
+};
+
+// Erro de simplificação tolerado na tela, em pixels, e margem de histerese: um nível mais
+// simples só é escolhido quando fica 25% abaixo do limite, evitando que a malha alterne
+// entre dois níveis a cada quadro perto da fronteira
+const float LOD_PIXEL_ERROR = 1.0f;
+const float LOD_HYSTERESIS = 0.25f;
+
+// Nível de detalhe para uma geometria cuja esfera envolvente aparece com screenRadius pixels
+// de raio, partindo do nível usado no quadro anterior
+unsigned int selectLod(const MeshLod *lods, unsigned int lodCount, float screenRadius, unsigned int current);
+
+// Identificador de uma geometria registrada (índice estável enquanto refCount > 0)
+typedef unsigned int GeometryId;
+const GeometryId INVALID_GEOMETRY = ~0u;
+
+// Registro de geometrias: cada .obj é lido e enviado para a GPU uma única vez, não importa
+// quantas malhas da cena o referenciem. Caminhos diferentes que levam ao mesmo arquivo
+// (ou a arquivos com conteúdo idêntico) também compartilham a mesma geometria.
+//
+// Todas as geometrias moram em três buffers (vértices, índices de 16 bits e de 32 bits)
+// atrás de um único VAO: trocar de geometria é só mudar baseVertex / firstIndex, o que
+// permite desenhar geometrias diferentes em um glMultiDrawElementsIndirect
+class GeometryRegistry
+{
+private:
+	std::vector<SharedGeometry> entries;												// Slots (reaproveitados após liberação)
+	std::unordered_map<std::string, GeometryId> byPath;					// Caminho canônico -> slot
+	std::unordered_map<unsigned long long, GeometryId> byHash;	// Hash do conteúdo -> slot
+	unsigned int requests = 0, uploads = 0;											// Estatísticas de acquire()
+
+	BufferArena vertices{MeshVertexLayout::stride}, indices16{2}, indices32{4};
+	GLuint vertexArray = 0; // Atributos de MeshVertexLayout sobre "vertices"
+
+	GeometryId upload(const std::string &path, unsigned long long hash, const GeometryView &view);
+	void setupGeometry(const GeometryView &view, SharedGeometry &geometry);
+	void freeGeometry(SharedGeometry &geometry);
+
+public:
+	GeometryRegistry() = default;
+	~GeometryRegistry() { clear(); }
+
+	// Os objetos OpenGL pertencem ao registro: não pode ser copiado
+	GeometryRegistry(const GeometryRegistry &) = delete;
+	GeometryRegistry &operator=(const GeometryRegistry &) = delete;
+
+	// Devolve a geometria do .obj (carregando e enviando para a GPU só na primeira vez) e
+	// incrementa a contagem de referências; INVALID_GEOMETRY se o arquivo não puder ser lido
+	GeometryId acquire(const std::string &objPath);
+
+	// Igual, para uma geometria já no formato de upload (ex.: de um SceneBundle); o .obj não é aberto
+	GeometryId acquire(const std::string &objPath, unsigned long long sourceHash, const GeometryView &view);
+
+	// Decrementa a contagem de referências; a última liberação devolve os trechos aos buffers
+	void release(GeometryId id);
+
+	// Esquece o caminho (o arquivo mudou no disco): o próximo acquire() o lê de novo. Quem já
+	// tem a geometria antiga continua com ela até liberá-la
+	void invalidate(const std::string &objPath);
+
+	const SharedGeometry &get(GeometryId id) const { return entries[id]; }
+
+	// VAO compartilhado (0 até a primeira geometria) e o buffer de índices de cada tipo, a
+	// vincular nele antes de desenhar geometrias desse indexType
+	GLuint getVertexArray() const { return vertexArray; }
+	GLuint getIndexBuffer(GLenum indexType) const
+	{
+		return (indexType == GL_UNSIGNED_SHORT) ? indices16.getId() : indices32.getId();
+	}
+
+	// Apaga o VAO e os buffers compartilhados (chamar antes de destruir o contexto OpenGL)
+	void clear();
+
+	// Imprime pedidos, geometrias únicas e memória de GPU ocupada
+	void printStats() const;
+};
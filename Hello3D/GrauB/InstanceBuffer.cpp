@@ -0,0 +1,90 @@
+// InstanceBuffer.cpp
+#include "InstanceBuffer.h" // Inclui o arquivo de cabeçalho do buffer de instâncias
+
+#include "GLExtensions.h" // GL_DRAW_INDIRECT_BUFFER
+
+/* Um novo glBufferData a cada quadro (mesmo tamanho) deixa o driver trocar a memória em vez
+   de esperar os desenhos do quadro anterior, que ainda leem o conteúdo antigo. O tamanho
+   só cresce, em potências de 2 */
+static void streamBuffer(GLenum target, GLuint &buffer, size_t &capacity, const void *data, size_t bytes)
+{
+	if (buffer == 0)
+		glGenBuffers(1, &buffer);
+	glBindBuffer(target, buffer);
+	if (bytes > capacity)
+	{
+		capacity = 4096;
+		while (capacity < bytes)
+			capacity *= 2;
+	}
+	glBufferData(target, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+	if (bytes > 0)
+		glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+}
+
+void InstanceBuffer::upload(const std::vector<InstanceData> &instances)
+{
+	streamBuffer(GL_ARRAY_BUFFER, buffer, capacity, instances.data(), instances.size() * sizeof(InstanceData));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/*****************************************************************************************
+ *  InstanceBuffer::enable()
+ *  --------------------------------------------------------------------------------------
+ *  Com desenho indireto, first = 0 uma vez por quadro (o baseInstance de cada comando
+ *  escolhe o trecho). Sem ele, no OpenGL 3.3 não há glDrawElementsInstancedBaseInstance,
+ *  e o início do desenho entra no deslocamento dos ponteiros: 8 chamadas por desenho.
+ *****************************************************************************************/
+void InstanceBuffer::enable(size_t first) const
+{
+	const GLsizei stride = sizeof(InstanceData);
+	const size_t base = first * sizeof(InstanceData);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	for (GLuint column = 0; column < 4; ++column)
+	{
+		GLuint location = INSTANCE_MODEL_LOCATION + column;
+		glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+													reinterpret_cast<GLvoid *>(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+		glVertexAttribDivisor(location, 1);
+		glEnableVertexAttribArray(location);
+	}
+	glVertexAttribPointer(INSTANCE_COLOR_LOCATION, 3, GL_FLOAT, GL_FALSE, stride,
+												reinterpret_cast<GLvoid *>(base + offsetof(InstanceData, extraColor)));
+	glVertexAttribDivisor(INSTANCE_COLOR_LOCATION, 1);
+	glEnableVertexAttribArray(INSTANCE_COLOR_LOCATION);
+	glVertexAttribIPointer(INSTANCE_FLAGS_LOCATION, 2, GL_INT, stride,
+												 reinterpret_cast<GLvoid *>(base + offsetof(InstanceData, materialIndex)));
+	glVertexAttribDivisor(INSTANCE_FLAGS_LOCATION, 1);
+	glEnableVertexAttribArray(INSTANCE_FLAGS_LOCATION);
+	const size_t bounds[2] = {offsetof(InstanceData, positionOffset), offsetof(InstanceData, positionScale)};
+	for (GLuint field = 0; field < 2; ++field)
+	{
+		GLuint location = INSTANCE_BOUNDS_LOCATION + field;
+		glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid *>(base + bounds[field]));
+		glVertexAttribDivisor(location, 1);
+		glEnableVertexAttribArray(location);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::release()
+{
+	if (buffer != 0)
+		glDeleteBuffers(1, &buffer);
+	buffer = 0;
+	capacity = 0;
+}
+
+void IndirectBuffer::upload(const std::vector<DrawElementsIndirectCommand> &commands)
+{
+	streamBuffer(GL_DRAW_INDIRECT_BUFFER, buffer, capacity, commands.data(),
+							 commands.size() * sizeof(DrawElementsIndirectCommand));
+}
+
+void IndirectBuffer::release()
+{
+	if (buffer != 0)
+		glDeleteBuffers(1, &buffer);
+	buffer = 0;
+	capacity = 0;
+}
@@ -0,0 +1,71 @@
+// InstanceBuffer.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <vector>	 // Necessário para usar std::vector
+
+#include <glad/glad.h> // Tipos OpenGL (GLuint, GLint...)
+#include <glm/glm.hpp> // glm::vec3 / glm::mat4
+
+// Entradas por instância do Object.vs (depois das do MeshVertexLayout, 0 a 2). A mat4
+// ocupa quatro posições seguidas, uma por coluna
+const GLuint INSTANCE_MODEL_LOCATION = 3;
+const GLuint INSTANCE_COLOR_LOCATION = 7;
+const GLuint INSTANCE_FLAGS_LOCATION = 8;
+const GLuint INSTANCE_BOUNDS_LOCATION = 9; // 9 e 10, lidas pela decodificação de PositionUnorm16 (VertexLayout.h)
+
+// Dados de um objeto desenhado, lidos pelo vertex shader com divisor 1 (um por instância)
+struct InstanceData
+{
+	glm::mat4 model;					// Matriz Model
+	glm::vec3 extraColor;			// Cor misturada ao resultado (seleção)
+	GLint materialIndex;			// Slot na MaterialTable
+	GLint skipLighting;				// 1 = sem iluminação (Sol)
+	glm::vec3 positionOffset; // Caixa das posições quantizadas da geometria (VertexBounds)
+	glm::vec3 positionScale;
+};
+
+// Buffer com os InstanceData de todos os objetos visíveis do quadro, na ordem dos desenhos.
+// Cada desenho lê o seu trecho: pelo baseInstance do comando indireto, ou, sem desenho
+// indireto, com enable() apontando os atributos por instância do VAO vinculado para a
+// primeira instância do desenho. Sem destrutor: release() é chamado com o contexto OpenGL
+// ainda ativo
+class InstanceBuffer
+{
+private:
+	GLuint buffer = 0;
+	size_t capacity = 0; // Bytes do buffer atual
+
+public:
+	// Substitui o conteúdo (o buffer só é realocado quando precisa crescer)
+	void upload(const std::vector<InstanceData> &instances);
+
+	// Configura os atributos por instância no VAO vinculado, a partir da instância "first"
+	void enable(size_t first) const;
+
+	void release();
+};
+
+// Comando de glMultiDrawElementsIndirect (layout fixado pela especificação do OpenGL)
+struct DrawElementsIndirectCommand
+{
+	GLuint count;					// Índices
+	GLuint instanceCount;
+	GLuint firstIndex;		// No buffer de índices vinculado
+	GLint baseVertex;			// Somado a cada índice
+	GLuint baseInstance;	// Primeira instância lida dos atributos com divisor
+};
+
+// Comandos indiretos do quadro, em GL_DRAW_INDIRECT_BUFFER (mesmo esquema do InstanceBuffer)
+class IndirectBuffer
+{
+private:
+	GLuint buffer = 0;
+	size_t capacity = 0; // Bytes do buffer atual
+
+public:
+	// Substitui o conteúdo e deixa o buffer vinculado a GL_DRAW_INDIRECT_BUFFER
+	void upload(const std::vector<DrawElementsIndirectCommand> &commands);
+
+	void release();
+};
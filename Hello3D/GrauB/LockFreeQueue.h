@@ -0,0 +1,59 @@
+// LockFreeQueue.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <atomic>	 // std::atomic
+#include <utility> // std::move
+
+// Fila sem travas com vários produtores e um único consumidor (MPSC, algoritmo de Vyukov).
+// As threads de trabalho entregam resultados com push(); a thread do OpenGL os recolhe com
+// pop() uma vez por quadro, sem nunca esperar por um mutex que uma thread de trabalho segure.
+// Cada push() aloca um nó; a ordem de push() de um mesmo produtor é preservada.
+template <typename T>
+class LockFreeQueue
+{
+private:
+	struct Node
+	{
+		std::atomic<Node *> next{nullptr};
+		T value;
+	};
+
+	std::atomic<Node *> head; // Último nó inserido (lado dos produtores)
+	Node *tail;								// Nó sentinela; o próximo é o mais antigo (lado do consumidor)
+
+public:
+	LockFreeQueue() : head(new Node()), tail(head.load(std::memory_order_relaxed)) {}
+
+	~LockFreeQueue()
+	{
+		T value;
+		while (pop(value))
+			;
+		delete tail;
+	}
+
+	LockFreeQueue(const LockFreeQueue &) = delete;
+	LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+	// Qualquer thread: insere no fim
+	void push(T value)
+	{
+		Node *node = new Node();
+		node->value = std::move(value);
+		Node *previous = head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release); // Publica o nó para o consumidor
+	}
+
+	// Somente o consumidor: retira o mais antigo; false se a fila estiver vazia (ou se um
+	// produtor ainda estiver no meio de um push(), que aparece na próxima chamada)
+	bool pop(T &value)
+	{
+		Node *next = tail->next.load(std::memory_order_acquire);
+		if (!next)
+			return false;
+		value = std::move(next->value);
+		delete tail;
+		tail = next; // "next" vira o novo sentinela
+		return true;
+	}
+};
@@ -0,0 +1,91 @@
+// MappedFile.cpp
+#include "MappedFile.h" // Inclui o arquivo de cabeçalho da classe MappedFile
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // CreateFile / CreateFileMapping / MapViewOfFile
+#else
+#include <fcntl.h>		// open
+#include <sys/mman.h> // mmap / munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>		// close
+#endif
+
+// Construtor: abre o arquivo e mapeia todo o seu conteúdo para leitura.
+// Arquivos vazios são considerados abertos, com size() == 0 (não é possível mapear 0 bytes).
+MappedFile::MappedFile(const std::string &path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+														OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return;
+	}
+	fileHandle = file;
+	opened = true;
+	if (fileSize.QuadPart == 0)
+		return;
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+	{
+		opened = false;
+		return;
+	}
+	mappingHandle = mapping;
+
+	ptr = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!ptr)
+	{
+		opened = false;
+		return;
+	}
+	length = static_cast<size_t>(fileSize.QuadPart);
+#else
+	fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		return;
+	opened = true;
+	if (st.st_size == 0)
+		return;
+
+	void *p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		opened = false;
+		return;
+	}
+	madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL); // Leitura é sempre linear
+	ptr = static_cast<const char *>(p);
+	length = static_cast<size_t>(st.st_size);
+#endif
+}
+
+// Destrutor: desfaz o mapeamento e fecha os descritores abertos
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (ptr)
+		UnmapViewOfFile(ptr);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle)
+		CloseHandle(fileHandle);
+#else
+	if (ptr)
+		munmap(const_cast<char *>(ptr), length);
+	if (fd >= 0)
+		close(fd);
+#endif
+}
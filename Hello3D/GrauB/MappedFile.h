@@ -0,0 +1,35 @@
+// MappedFile.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string>	 // Necessário para usar std::string
+#include <cstddef> // size_t
+
+// Mapeia um arquivo inteiro em memória, somente leitura (mmap no POSIX, MapViewOfFile no Windows).
+// O conteúdo fica acessível como um único bloco contíguo, sem cópias para buffers intermediários.
+class MappedFile
+{
+private:
+	const char *ptr = nullptr; // Início do conteúdo mapeado
+	size_t length = 0;				 // Tamanho do arquivo em bytes
+	bool opened = false;			 // true se o arquivo foi aberto (mesmo que vazio)
+#ifdef _WIN32
+	void *fileHandle = nullptr;		 // HANDLE do arquivo
+	void *mappingHandle = nullptr; // HANDLE do mapeamento
+#else
+	int fd = -1; // Descritor do arquivo
+#endif
+
+public:
+	// Abre e mapeia o arquivo indicado; em caso de falha isOpen() devolve false
+	explicit MappedFile(const std::string &path);
+	~MappedFile();
+
+	// O mapeamento é um recurso exclusivo: não pode ser copiado
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	bool isOpen() const { return opened; }
+	const char *data() const { return ptr; }
+	const char *end() const { return ptr + length; }
+	size_t size() const { return length; }
+};
@@ -0,0 +1,44 @@
+// Material.cpp
+#include "Material.h" // Inclui o arquivo de cabeçalho da struct Material
+
+#include <fstream>	// Manipulação de arquivos
+#include <iostream> // Saída de dados no console
+#include <sstream>	// String streams
+
+/*****************************************************************************************
+ *  setupMtl()
+ *  --------------------------------------------------------------------------------------
+ *  Lê um arquivo .mtl e devolve uma estrutura Material preenchida.
+ *****************************************************************************************/
+Material setupMtl(std::string path)
+{
+	Material material{};
+	std::ifstream file(path);
+	std::string line;
+
+	if (!file.is_open())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+		return material;
+	}
+
+	while (getline(file, line))
+	{
+		std::istringstream ss(line);
+		std::string type;
+		ss >> type;
+
+		if (type == "Ka")
+			ss >> material.kaR >> material.kaG >> material.kaB;
+		else if (type == "Kd")
+			ss >> material.kdR >> material.kdG >> material.kdB;
+		else if (type == "Ks")
+			ss >> material.ksR >> material.ksG >> material.ksB;
+		else if (type == "Ns")
+			ss >> material.ns;
+		else if (type == "map_Kd")
+			ss >> material.textureName;
+	}
+	file.close();
+	return material;
+}
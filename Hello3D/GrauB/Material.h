@@ -0,0 +1,17 @@
+// Material.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+
+struct Material
+{
+	// Componentes de material baseados no modelo de iluminação Phong
+	float kaR, kaG, kaB;		 // Coeficiente ambiente (Ka)
+	float kdR, kdG, kdB;		 // Coeficiente difuso   (Kd)
+	float ksR, ksG, ksB;		 // Coeficiente especular (Ks)
+	float ns;								 // Expoente especular
+	std::string textureName; // Nome do arquivo de textura
+};
+
+// Lê um arquivo .mtl e devolve uma estrutura Material preenchida
+Material setupMtl(const std::string path);
@@ -0,0 +1,100 @@
+// MaterialTable.cpp
+#include "MaterialTable.h" // Inclui o arquivo de cabeçalho da tabela de materiais
+
+#include <algorithm> // std::min / std::max
+
+static GpuMaterial packMaterial(const Material &material)
+{
+	GpuMaterial packed;
+	packed.ambient = glm::vec4(material.kaR, material.kaG, material.kaB, 0.0f);
+	packed.diffuse = glm::vec4(material.kdR, material.kdG, material.kdB, 0.0f);
+	packed.specular = glm::vec4(material.ksR, material.ksG, material.ksB, material.ns);
+	return packed;
+}
+
+std::string materialTableGlsl()
+{
+	return "#define MATERIAL_TABLE_BINDING " + std::to_string(MATERIAL_TABLE_BINDING) + "\n";
+}
+
+/*****************************************************************************************
+ *  MaterialTable::acquire()
+ *  --------------------------------------------------------------------------------------
+ *  Busca linear pelos coeficientes: acquire() só é chamado na carga e nas recargas, nunca
+ *  por quadro, e as cenas têm poucos materiais distintos.
+ *****************************************************************************************/
+MaterialId MaterialTable::acquire(const Material &material)
+{
+	GpuMaterial packed = packMaterial(material);
+	MaterialId freeSlot = INVALID_MATERIAL;
+	for (MaterialId id = 0; id < entries.size(); ++id)
+	{
+		if (refCounts[id] == 0)
+		{
+			if (freeSlot == INVALID_MATERIAL)
+				freeSlot = id;
+			continue;
+		}
+		if (entries[id].ambient == packed.ambient && entries[id].diffuse == packed.diffuse &&
+				entries[id].specular == packed.specular)
+		{
+			++refCounts[id];
+			return id;
+		}
+	}
+
+	if (freeSlot == INVALID_MATERIAL)
+	{
+		freeSlot = static_cast<MaterialId>(entries.size());
+		entries.emplace_back();
+		refCounts.push_back(0);
+	}
+
+	entries[freeSlot] = packed;
+	refCounts[freeSlot] = 1;
+	dirtyBegin = (dirtyBegin == dirtyEnd) ? freeSlot : std::min<size_t>(dirtyBegin, freeSlot);
+	dirtyEnd = std::max<size_t>(dirtyEnd, freeSlot + 1);
+	return freeSlot;
+}
+
+void MaterialTable::release(MaterialId id)
+{
+	if (id != INVALID_MATERIAL && refCounts[id] > 0)
+		--refCounts[id];
+}
+
+void MaterialTable::update()
+{
+	if (buffer.getId() == 0 || entries.size() > capacity)
+	{
+		/* Buffer novo com todos os slots: os desenhos pendentes continuam lendo o antigo */
+		capacity = std::max<size_t>(capacity, MATERIAL_TABLE_SIZE);
+		while (capacity < entries.size())
+			capacity *= 2;
+		buffer.create(MATERIAL_TABLE_BINDING, static_cast<GLsizeiptr>(capacity * sizeof(GpuMaterial)), nullptr,
+									GL_SHADER_STORAGE_BUFFER);
+		if (!entries.empty())
+			buffer.update(entries.data(), static_cast<GLsizeiptr>(entries.size() * sizeof(GpuMaterial)));
+		dirtyBegin = dirtyEnd = 0;
+		return;
+	}
+	if (dirtyBegin == dirtyEnd)
+		return;
+	buffer.update(&entries[dirtyBegin], (dirtyEnd - dirtyBegin) * sizeof(GpuMaterial), dirtyBegin * sizeof(GpuMaterial));
+	dirtyBegin = dirtyEnd = 0;
+}
+
+void MaterialTable::clear()
+{
+	buffer.release();
+	entries.clear();
+	refCounts.clear();
+	dirtyBegin = dirtyEnd = 0;
+	capacity = 0;
+}
+
+unsigned int MaterialTable::count() const
+{
+	return static_cast<unsigned int>(std::count_if(refCounts.begin(), refCounts.end(), [](unsigned int refs)
+																								 { return refs != 0; }));
+}
@@ -0,0 +1,69 @@
+// MaterialTable.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include <glm/glm.hpp> // glm::vec4
+
+#include "Material.h"			 // Struct Material
+#include "GLExtensions.h"	 // GL_SHADER_STORAGE_BUFFER
+#include "UniformBuffer.h" // Buffer do bloco e binding point
+
+// Binding point do bloco de armazenamento "MaterialTable" do Object.fs (chega ao shader como
+// #define por materialTableGlsl(), então os dois lados não divergem)
+const GLuint MATERIAL_TABLE_BINDING = 1;
+
+// Slots reservados na GPU no primeiro update(); quando os materiais distintos passam disso,
+// o buffer dobra de tamanho (o array do shader não tem tamanho fixo)
+const unsigned int MATERIAL_TABLE_SIZE = 256;
+
+// Um material no layout std430 (só vec4: o mesmo do std140): xyz = Ka / Kd / Ks; specular.w = Ns
+struct GpuMaterial
+{
+	glm::vec4 ambient;
+	glm::vec4 diffuse;
+	glm::vec4 specular;
+};
+static_assert(sizeof(GpuMaterial) == 48, "GpuMaterial deve seguir o layout std430 do bloco MaterialTable");
+
+// Índice de um material na tabela (o valor enviado ao shader em cada desenho)
+typedef unsigned int MaterialId;
+const MaterialId INVALID_MATERIAL = ~0u;
+
+// Definições inseridas no Object.fs depois do #version (Shader, fragmentShaderHeader)
+std::string materialTableGlsl();
+
+// Tabela de materiais da cena: cada combinação distinta de coeficientes ocupa um slot do bloco
+// de armazenamento (SSBO, std430), compartilhado por todas as malhas que a usam. acquire() /
+// release() só mexem na cópia da CPU; update(), uma vez por quadro antes dos desenhos, envia o
+// trecho alterado, ou recria o buffer com o dobro de slots se os materiais não cabem mais
+class MaterialTable
+{
+private:
+	std::vector<GpuMaterial> entries;			// Slots (reaproveitados após liberação)
+	std::vector<unsigned int> refCounts;	// Malhas que usam cada slot (0 = slot livre)
+	size_t dirtyBegin = 0, dirtyEnd = 0;	// Slots ainda não enviados, [begin, end)
+	size_t capacity = 0;									// Slots do buffer na GPU
+	UniformBuffer buffer;									// Criado no primeiro update()
+
+public:
+	// Slot com os mesmos coeficientes (ou um novo) e incrementa a contagem de referências
+	MaterialId acquire(const Material &material);
+
+	// Decrementa a contagem de referências (INVALID_MATERIAL é ignorado)
+	void release(MaterialId id);
+
+	// Envia os slots alterados desde o último update() (um único glBufferSubData); se a
+	// tabela cresceu além do buffer, cria um maior com todos os slots
+	void update();
+
+	// Apaga o buffer (chamar antes de destruir o contexto OpenGL)
+	void clear();
+
+	// Slots em uso
+	unsigned int count() const;
+
+	// Slots reservados na GPU
+	size_t getCapacity() const { return capacity; }
+};
@@ -0,0 +1,342 @@
+// MeshOptimizer.cpp
+#include "MeshOptimizer.h" // Inclui o arquivo de cabeçalho do otimizador de malhas
+
+#include <algorithm> // std::stable_sort
+#include <iomanip>	 // std::setprecision
+#include <sstream>	 // Montagem do relatório
+
+#include <glm/glm.hpp> // glm::vec3 / cross / dot
+
+/* Cache FIFO por carimbos de tempo: o vértice está no cache se entrou há menos de cacheSize
+   faltas. Devolve true em uma falta (e registra a entrada) */
+static inline bool touchCache(std::vector<unsigned int> &cacheTime, unsigned int &timestamp, unsigned int vertex,
+															unsigned int cacheSize)
+{
+	if (timestamp - cacheTime[vertex] <= cacheSize)
+		return false;
+	cacheTime[vertex] = timestamp++;
+	return true;
+}
+
+/*****************************************************************************************
+ *  analyzeVertexCache()
+ *****************************************************************************************/
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize)
+{
+	std::vector<unsigned int> cacheTime(vertexCount, 0);
+	unsigned int timestamp = cacheSize + 1; // Nenhum vértice começa no cache
+	size_t misses = 0;
+	for (unsigned int index : indices)
+		misses += touchCache(cacheTime, timestamp, index, cacheSize);
+
+	VertexCacheStats stats{0.0f, 0.0f};
+	if (!indices.empty())
+		stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+	if (vertexCount)
+		stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+	return stats;
+}
+
+/*****************************************************************************************
+ *  optimizeVertexCache()
+ *  --------------------------------------------------------------------------------------
+ *  Tipsify: emite em leque todos os triângulos ainda não emitidos de um vértice e escolhe
+ *  o próximo entre os vértices recém-usados, preferindo o que está há mais tempo no cache
+ *  mas ainda vai continuar nele depois dos próprios triângulos (idade + 2 * vivos <= k).
+ *  Sem candidato, volta pela pilha de vértices emitidos (beco sem saída) ou, no último
+ *  caso, pelo próximo vértice com triângulos na ordem do arquivo. Linear no nº de índices.
+ *****************************************************************************************/
+std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+																							unsigned int cacheSize, std::vector<size_t> *clusters)
+{
+	const size_t triangleCount = indices.size() / 3;
+	std::vector<unsigned int> result;
+	result.reserve(triangleCount * 3);
+	if (clusters)
+		clusters->clear();
+	if (triangleCount == 0)
+		return result;
+
+	/* Adjacência vértice -> triângulos em um único array (offsets por vértice) */
+	std::vector<unsigned int> live(vertexCount, 0); // Triângulos ainda não emitidos de cada vértice
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+		++live[indices[i]];
+	std::vector<size_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v)
+		offsets[v + 1] = offsets[v] + live[v];
+	std::vector<unsigned int> adjacency(triangleCount * 3);
+	{
+		std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+	}
+
+	std::vector<unsigned int> cacheTime(vertexCount, 0);
+	std::vector<unsigned char> emitted(triangleCount, 0);
+	std::vector<unsigned int> deadEnd, candidates;
+	deadEnd.reserve(triangleCount * 3);
+	unsigned int timestamp = cacheSize + 1;
+	size_t cursor = 0; // Próximo vértice a tentar na ordem do arquivo
+
+	long long fanning = indices[0];
+	bool restarted = true; // O próximo triângulo emitido começa um cluster
+	while (fanning >= 0)
+	{
+		const unsigned int f = static_cast<unsigned int>(fanning);
+		candidates.clear();
+		for (size_t a = offsets[f]; a < offsets[f + 1]; ++a)
+		{
+			unsigned int t = adjacency[a];
+			if (emitted[t])
+				continue;
+			if (restarted && clusters)
+				clusters->push_back(result.size() / 3);
+			restarted = false;
+			for (int k = 0; k < 3; ++k)
+			{
+				unsigned int v = indices[t * 3 + k];
+				result.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				--live[v];
+				touchCache(cacheTime, timestamp, v, cacheSize);
+			}
+			emitted[t] = 1;
+		}
+
+		/* Próximo vértice do leque: o mais antigo que ainda sobrevive no cache. Prioridade 0
+		   (vivo, mas sairia do cache) não serve: segue para o beco sem saída */
+		fanning = -1;
+		long long bestPriority = 0;
+		for (unsigned int v : candidates)
+		{
+			if (live[v] == 0)
+				continue;
+			long long age = timestamp - cacheTime[v];
+			long long priority = (age + 2 * static_cast<long long>(live[v]) <= cacheSize) ? age : 0;
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanning = v;
+			}
+		}
+		if (fanning >= 0)
+			continue;
+
+		/* Beco sem saída: cluster novo */
+		restarted = true;
+		while (!deadEnd.empty() && fanning < 0)
+		{
+			unsigned int v = deadEnd.back();
+			deadEnd.pop_back();
+			if (live[v] > 0)
+				fanning = v;
+		}
+		while (fanning < 0 && cursor < vertexCount)
+		{
+			if (live[cursor] > 0)
+				fanning = static_cast<long long>(cursor);
+			++cursor;
+		}
+	}
+	return result;
+}
+
+/*****************************************************************************************
+ *  optimizeOverdraw()
+ *  --------------------------------------------------------------------------------------
+ *  1. Subdivide cada cluster do Tipsify onde o ACMR acumulado do trecho já está dentro de
+ *     "threshold" vezes o do cluster inteiro (trechos menores = ordenação mais fina, com
+ *     perda limitada de cache).
+ *  2. Para cada trecho: centroide e normal média ponderados pela área.
+ *  3. Ordena pela projeção (centroide - centroide da malha) . normal, maior primeiro: as
+ *     faces externas voltadas para fora são desenhadas antes e ocultam as de trás.
+ *****************************************************************************************/
+size_t optimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+												std::vector<size_t> clusters, float threshold, unsigned int cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return 0;
+	if (clusters.empty() || clusters.front() != 0)
+		clusters.insert(clusters.begin(), 0);
+	clusters.push_back(triangleCount); // Sentinela: fim do último cluster
+
+	/* 1. Subdivisão */
+	std::vector<size_t> starts;
+	std::vector<unsigned int> cacheTime(vertices.size(), 0);
+	unsigned int timestamp = cacheSize + 1;
+	for (size_t c = 0; c + 1 < clusters.size(); ++c)
+	{
+		const size_t begin = clusters[c], end = clusters[c + 1];
+		if (begin >= end)
+			continue;
+
+		timestamp += cacheSize + 1; // Esvazia o cache
+		size_t clusterMisses = 0;
+		for (size_t i = begin * 3; i < end * 3; ++i)
+			clusterMisses += touchCache(cacheTime, timestamp, indices[i], cacheSize);
+		const float limit = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+		timestamp += cacheSize + 1;
+		size_t start = begin, misses = 0;
+		starts.push_back(begin);
+		for (size_t t = begin; t < end; ++t)
+		{
+			for (int k = 0; k < 3; ++k)
+				misses += touchCache(cacheTime, timestamp, indices[t * 3 + k], cacheSize);
+			if (t + 1 < end && static_cast<float>(misses) <= limit * static_cast<float>(t + 1 - start))
+			{
+				starts.push_back(t + 1);
+				start = t + 1;
+				misses = 0;
+				timestamp += cacheSize + 1;
+			}
+		}
+	}
+	starts.push_back(triangleCount);
+	const size_t pieceCount = starts.size() - 1;
+
+	/* 2. Centroide e normal por trecho (e centroide da malha) */
+	auto position = [&](unsigned int v)
+	{ return glm::vec3(vertices[v].x, vertices[v].y, vertices[v].z); };
+
+	std::vector<glm::vec3> centroid(pieceCount, glm::vec3(0.0f)), normal(pieceCount, glm::vec3(0.0f));
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (size_t p = 0; p < pieceCount; ++p)
+	{
+		float area = 0.0f;
+		for (size_t t = starts[p]; t < starts[p + 1]; ++t)
+		{
+			glm::vec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), c = position(indices[t * 3 + 2]);
+			glm::vec3 n = glm::cross(b - a, c - a); // |n| = 2 * área
+			float weight = glm::length(n);
+			centroid[p] += (a + b + c) * (weight / 3.0f);
+			normal[p] += n;
+			area += weight;
+		}
+		meshCentroid += centroid[p];
+		meshArea += area;
+		centroid[p] = (area > 0.0f) ? centroid[p] / area : position(indices[starts[p] * 3]);
+	}
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+
+	/* 3. Ordenação (estável: empates mantêm a ordem do Tipsify) */
+	std::vector<float> key(pieceCount);
+	std::vector<size_t> order(pieceCount);
+	for (size_t p = 0; p < pieceCount; ++p)
+	{
+		float length = glm::length(normal[p]);
+		key[p] = (length > 0.0f) ? glm::dot(centroid[p] - meshCentroid, normal[p] / length) : 0.0f;
+		order[p] = p;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+									 { return key[a] > key[b]; });
+
+	std::vector<unsigned int> sorted;
+	sorted.reserve(indices.size());
+	for (size_t p : order)
+		sorted.insert(sorted.end(), indices.begin() + starts[p] * 3, indices.begin() + starts[p + 1] * 3);
+	indices.swap(sorted);
+	return pieceCount;
+}
+
+/*****************************************************************************************
+ *  optimizeVertexFetch()
+ *****************************************************************************************/
+void optimizeVertexFetch(IndexedGeometry &geometry)
+{
+	const unsigned int UNUSED = ~0u;
+	std::vector<unsigned int> remap(geometry.vertices.size(), UNUSED);
+	std::vector<Vertex> vertices;
+	vertices.reserve(geometry.vertices.size());
+	for (unsigned int &index : geometry.indices)
+	{
+		if (remap[index] == UNUSED)
+		{
+			remap[index] = static_cast<unsigned int>(vertices.size());
+			vertices.push_back(geometry.vertices[index]);
+		}
+		index = remap[index];
+	}
+	geometry.vertices.swap(vertices);
+}
+
+/*****************************************************************************************
+ *  optimizeMesh()
+ *****************************************************************************************/
+MeshOptimizationReport optimizeMesh(IndexedGeometry &geometry)
+{
+	MeshOptimizationReport report{};
+	report.triangles = geometry.indices.size() / 3;
+	report.before = analyzeVertexCache(geometry.indices, geometry.vertices.size());
+
+	const size_t vertexCount = geometry.vertices.size();
+
+	std::vector<size_t> clusters;
+	geometry.indices = optimizeVertexCache(geometry.indices, vertexCount, VERTEX_CACHE_SIZE, &clusters);
+	report.clusters = optimizeOverdraw(geometry.indices, geometry.vertices, clusters);
+	report.after = analyzeVertexCache(geometry.indices, vertexCount);
+
+	/* LODs: os erros se acumulam de um nível para o outro, então o limite vale para a soma */
+	report.lods[0] = MeshLod{0, static_cast<unsigned int>(geometry.indices.size()), 0.0f, 0, 0, 0};
+	report.lodCount = 1;
+	const float radius = meshRadius(geometry.vertices);
+	std::vector<unsigned int> previous = geometry.indices;
+	while (report.lodCount < MESH_LOD_MAX && radius > 0.0f)
+	{
+		const MeshLod &last = report.lods[report.lodCount - 1];
+		size_t target = static_cast<size_t>(previous.size() / 3 * MESH_LOD_RATIO) * 3;
+		float error = 0.0f;
+		std::vector<unsigned int> lod = simplifyMesh(geometry.vertices, previous, target,
+																								 (MESH_LOD_MAX_ERROR - last.error) * radius, &error);
+		if (lod.empty() || lod.size() > previous.size() * MESH_LOD_MIN_REDUCTION)
+			break;
+
+		lod = optimizeVertexCache(lod, vertexCount);
+		report.lods[report.lodCount++] = MeshLod{static_cast<unsigned int>(geometry.indices.size()),
+																						 static_cast<unsigned int>(lod.size()), last.error + error / radius, 0, 0, 0};
+		geometry.indices.insert(geometry.indices.end(), lod.begin(), lod.end());
+		previous.swap(lod);
+	}
+
+	/* Meshlets dos níveis grandes (reordenam os triângulos só dentro de cada nível). O
+	   agrupamento troca eficiência de cache por clusters compactos: cada meshlet mantém a
+	   ordem do Tipsify, mas reúne triângulos de leques diferentes, então o ACMR sobe */
+	for (unsigned int l = 0; l < report.lodCount; ++l)
+	{
+		MeshLod &lod = report.lods[l];
+		lod.meshletOffset = static_cast<unsigned int>(report.meshlets.size());
+		if (lod.indexCount / 3 < MESHLET_MIN_TRIANGLES)
+			continue;
+		std::vector<Meshlet> meshlets = buildMeshlets(geometry.vertices, geometry.indices, lod.indexOffset, lod.indexCount);
+		lod.meshletCount = static_cast<unsigned int>(meshlets.size());
+		report.meshlets.insert(report.meshlets.end(), meshlets.begin(), meshlets.end());
+	}
+	report.clustered = analyzeVertexCache(std::vector<unsigned int>(geometry.indices.begin(), geometry.indices.begin() + report.lods[0].indexCount),
+																				vertexCount);
+
+	/* Todos os níveis usam vértices do LOD 0, que vem primeiro: a ordem de fetch é a dele */
+	optimizeVertexFetch(geometry);
+	return report;
+}
+
+std::string formatOptimizationReport(const std::string &path, const MeshOptimizationReport &report)
+{
+	std::ostringstream line;
+	line << std::fixed << std::setprecision(3) << "Malha otimizada " << path << ": " << report.triangles
+			 << " triangulo(s), " << report.clusters << " cluster(s), ACMR " << report.before.acmr << " -> "
+			 << report.after.acmr;
+	if (report.lods[0].meshletCount > 0)
+		line << " (" << report.clustered.acmr << " com meshlets)";
+	line << ", ATVR " << report.before.atvr << " -> " << report.after.atvr;
+	if (report.lods[0].meshletCount > 0)
+		line << " (" << report.clustered.atvr << " com meshlets)";
+	line << ", LODs ";
+	for (unsigned int l = 0; l < report.lodCount; ++l)
+		line << (l ? "/" : "") << report.lods[l].indexCount / 3;
+	line << " triangulo(s), " << report.meshlets.size() << " meshlet(s)\n";
+	return line.str();
+}
@@ -0,0 +1,67 @@
+// MeshOptimizer.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include "Meshlet.h"				// Meshlet / buildMeshlets
+#include "MeshSimplifier.h" // MeshLod / simplifyMesh
+#include "ObjLoader.h"			// IndexedGeometry
+
+// Entradas do cache pós-transformação simulado (FIFO), usado pelo Tipsify e pelas métricas
+const unsigned int VERTEX_CACHE_SIZE = 16;
+
+// Quanto o ACMR de um trecho pode piorar para que ele vire um cluster separado na ordenação
+// por overdraw (1.05 = até 5% pior que o do cluster de onde saiu)
+const float OVERDRAW_THRESHOLD = 1.05f;
+
+// Eficiência do cache de vértices de uma ordem de triângulos
+struct VertexCacheStats
+{
+	float acmr; // Average Cache Miss Ratio: vértices processados por triângulo (0.5 a 3)
+	float atvr; // Average Transformed Vertex Ratio: vértices processados por vértice único (>= 1)
+};
+
+// Antes e depois de optimizeMesh()
+struct MeshOptimizationReport
+{
+	size_t triangles;
+	size_t clusters; // Trechos reordenados pela ordenação por overdraw
+	VertexCacheStats before, after; // Do LOD 0: original e depois do cache / overdraw
+	VertexCacheStats clustered;			// Do LOD 0 agrupado em meshlets (= after se não há meshlets)
+	unsigned int lodCount;					// Níveis gerados (1 = só o original)
+	MeshLod lods[MESH_LOD_MAX];			// Trechos do index buffer final
+	std::vector<Meshlet> meshlets;	// De todos os níveis, na ordem dos níveis
+};
+
+// Simula um cache FIFO de cacheSize entradas sobre os índices (3 por triângulo)
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+																		unsigned int cacheSize = VERTEX_CACHE_SIZE);
+
+// Tipsify (Sander, Nehab e Barczak, 2007): devolve os triângulos em ordem amigável ao cache.
+// clusters (opcional) recebe o primeiro triângulo de cada trecho iniciado depois de um
+// beco sem saída (cache "esvaziado"), ponto em que a ordem pode ser trocada sem custo
+std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+																							unsigned int cacheSize = VERTEX_CACHE_SIZE,
+																							std::vector<size_t> *clusters = nullptr);
+
+// Ordena os clusters do Tipsify por um critério independente da câmera: os que ficam mais
+// para fora e voltados para fora primeiro, de modo que escondam os de dentro (menos overdraw).
+// Clusters longos são subdivididos onde o ACMR fica até OVERDRAW_THRESHOLD pior. Devolve
+// quantos clusters foram ordenados
+size_t optimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+												std::vector<size_t> clusters, float threshold = OVERDRAW_THRESHOLD,
+												unsigned int cacheSize = VERTEX_CACHE_SIZE);
+
+// Renumera os vértices na ordem do primeiro uso pelos índices (leitura sequencial do VBO).
+// Vértices que nenhum triângulo usa são descartados
+void optimizeVertexFetch(IndexedGeometry &geometry);
+
+// Cache -> overdraw no original; depois a cadeia de LODs (cada nível simplificado a partir do
+// anterior e reordenado para o cache), concatenada no mesmo index buffer; os níveis com pelo
+// menos MESHLET_MIN_TRIANGLES são agrupados em meshlets; por fim o fetch
+MeshOptimizationReport optimizeMesh(IndexedGeometry &geometry);
+
+// Uma linha de console com ACMR / ATVR antes e depois (e com os meshlets, se o LOD 0 os tem),
+// os triângulos de cada LOD e os meshlets
+std::string formatOptimizationReport(const std::string &path, const MeshOptimizationReport &report);
@@ -0,0 +1,240 @@
+// MeshSimplifier.cpp
+#include "MeshSimplifier.h" // Inclui o arquivo de cabeçalho do simplificador de malhas
+
+#include <algorithm>		 // std::sort / std::max
+#include <cmath>				 // std::sqrt
+#include <unordered_map> // Contagem de arestas
+
+#include <glm/glm.hpp> // glm::vec3 / glm::dvec3
+
+// Quádrica simétrica 4x4 (10 coeficientes) acumulada com o peso (área) dos planos
+struct Quadric
+{
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2, weight;
+};
+
+static Quadric planeQuadric(const glm::dvec3 &n, double d, double weight)
+{
+	return Quadric{n.x * n.x * weight, n.x * n.y * weight, n.x * n.z * weight, n.x * d * weight,
+								 n.y * n.y * weight, n.y * n.z * weight, n.y * d * weight,
+								 n.z * n.z * weight, n.z * d * weight, d * d * weight, weight};
+}
+
+static void addQuadric(Quadric &q, const Quadric &r)
+{
+	q.a2 += r.a2, q.ab += r.ab, q.ac += r.ac, q.ad += r.ad, q.b2 += r.b2, q.bc += r.bc;
+	q.bd += r.bd, q.c2 += r.c2, q.cd += r.cd, q.d2 += r.d2, q.weight += r.weight;
+}
+
+/* Distância quadrática média de p aos planos de q + r */
+static double quadricError(const Quadric &q, const Quadric &r, const glm::dvec3 &p)
+{
+	double a2 = q.a2 + r.a2, ab = q.ab + r.ab, ac = q.ac + r.ac, ad = q.ad + r.ad, b2 = q.b2 + r.b2;
+	double bc = q.bc + r.bc, bd = q.bd + r.bd, c2 = q.c2 + r.c2, cd = q.cd + r.cd, d2 = q.d2 + r.d2;
+	double weight = q.weight + r.weight;
+	double error = a2 * p.x * p.x + 2 * ab * p.x * p.y + 2 * ac * p.x * p.z + 2 * ad * p.x +
+								 b2 * p.y * p.y + 2 * bc * p.y * p.z + 2 * bd * p.y +
+								 c2 * p.z * p.z + 2 * cd * p.z + d2;
+	return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+}
+
+static inline glm::vec3 positionOf(const Vertex &v)
+{
+	return glm::vec3(v.x, v.y, v.z);
+}
+
+/*****************************************************************************************
+ *  meshRadius()
+ *****************************************************************************************/
+float meshRadius(const std::vector<Vertex> &vertices)
+{
+	if (vertices.empty())
+		return 0.0f;
+	glm::vec3 lo = positionOf(vertices[0]), hi = lo;
+	for (const Vertex &v : vertices)
+	{
+		lo = glm::min(lo, positionOf(v));
+		hi = glm::max(hi, positionOf(v));
+	}
+	return 0.5f * glm::length(hi - lo);
+}
+
+/*****************************************************************************************
+ *  lockVertices()
+ *  --------------------------------------------------------------------------------------
+ *  Vértices que não podem colapsar: os que dividem a posição com outro vértice (costura
+ *  de texcoord / normal: colapsar só um lado abriria um buraco) e os de arestas de borda
+ *  ou não-manifold (usadas por um ou por mais de dois triângulos).
+ *****************************************************************************************/
+static std::vector<unsigned char> lockVertices(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+{
+	const size_t n = vertices.size();
+	std::vector<unsigned char> locked(n, 0);
+
+	/* Mesma posição -> mesmo id (ordenação pelas coordenadas) */
+	std::vector<unsigned int> order(n), positionId(n);
+	for (unsigned int v = 0; v < n; ++v)
+		order[v] = v;
+	auto less = [&](unsigned int a, unsigned int b)
+	{
+		const Vertex &p = vertices[a], &q = vertices[b];
+		return p.x != q.x ? p.x < q.x : p.y != q.y ? p.y < q.y : p.z < q.z;
+	};
+	std::sort(order.begin(), order.end(), less);
+	for (size_t i = 0; i < n; ++i)
+	{
+		bool same = i > 0 && !less(order[i - 1], order[i]);
+		positionId[order[i]] = same ? positionId[order[i - 1]] : order[i];
+		if (same)
+			locked[order[i]] = locked[order[i - 1]] = 1;
+	}
+
+	/* Arestas por posição: bordas e não-manifold */
+	std::unordered_map<unsigned long long, unsigned int> edges;
+	edges.reserve(indices.size());
+	for (size_t t = 0; t + 2 < indices.size(); t += 3)
+		for (int k = 0; k < 3; ++k)
+		{
+			unsigned long long a = positionId[indices[t + k]], b = positionId[indices[t + (k + 1) % 3]];
+			if (a != b)
+				++edges[a < b ? (a << 32 | b) : (b << 32 | a)];
+		}
+	std::vector<unsigned char> lockedPosition(n, 0);
+	for (const auto &edge : edges)
+		if (edge.second != 2)
+			lockedPosition[edge.first >> 32] = lockedPosition[edge.first & 0xFFFFFFFFu] = 1;
+	for (size_t v = 0; v < n; ++v)
+		locked[v] |= lockedPosition[positionId[v]];
+	return locked;
+}
+
+/*****************************************************************************************
+ *  simplifyMesh()
+ *  --------------------------------------------------------------------------------------
+ *  Em passadas: gera todos os colapsos a -> b possíveis (arestas dos triângulos atuais),
+ *  ordena pelo erro quádrico e aplica os mais baratos cujos vizinhos ainda não mudaram
+ *  nesta passada, rejeitando os que invertem algum triângulo. Depois reescreve os índices
+ *  e descarta os triângulos degenerados.
+ *****************************************************************************************/
+std::vector<unsigned int> simplifyMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+																			 size_t targetIndexCount, float maxError, float *resultError)
+{
+	const size_t n = vertices.size();
+	std::vector<unsigned int> result(indices.begin(), indices.end() - indices.size() % 3);
+	std::vector<unsigned char> locked = lockVertices(vertices, result);
+
+	/* Quádrica de cada vértice: planos dos triângulos vizinhos, pesados pela área */
+	std::vector<Quadric> quadrics(n, Quadric{});
+	for (size_t t = 0; t < result.size(); t += 3)
+	{
+		glm::dvec3 p0 = positionOf(vertices[result[t]]), p1 = positionOf(vertices[result[t + 1]]),
+							 p2 = positionOf(vertices[result[t + 2]]);
+		glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+		double area = glm::length(normal);
+		if (area <= 0.0)
+			continue;
+		normal /= area;
+		Quadric q = planeQuadric(normal, -glm::dot(normal, p0), area * 0.5);
+		for (int k = 0; k < 3; ++k)
+			addQuadric(quadrics[result[t + k]], q);
+	}
+
+	struct Collapse
+	{
+		double error;
+		unsigned int from, to;
+	};
+	std::vector<Collapse> collapses;
+	std::vector<unsigned int> remap(n), offsets(n + 1), adjacency;
+	std::vector<unsigned char> touched(n);
+	const double errorLimit = static_cast<double>(maxError) * maxError;
+	double worstError = 0.0;
+
+	while (result.size() > targetIndexCount)
+	{
+		/* Adjacência vértice -> triângulos do index buffer atual */
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (unsigned int index : result)
+			++offsets[index + 1];
+		for (size_t v = 0; v < n; ++v)
+			offsets[v + 1] += offsets[v];
+		adjacency.resize(result.size());
+		{
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i)
+				adjacency[fill[result[i]]++] = static_cast<unsigned int>(i / 3);
+		}
+
+		/* Candidatos, do mais barato ao mais caro */
+		collapses.clear();
+		for (size_t t = 0; t < result.size(); t += 3)
+			for (int k = 0; k < 3; ++k)
+				for (int d = 1; d <= 2; ++d)
+				{
+					unsigned int from = result[t + k], to = result[t + (k + d) % 3];
+					if (!locked[from])
+						collapses.push_back({quadricError(quadrics[from], quadrics[to], positionOf(vertices[to])), from, to});
+				}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+							{ return a.error < b.error; });
+
+		/* Cada colapso remove ~2 triângulos */
+		size_t budget = (result.size() - targetIndexCount) / 6 + 1, applied = 0;
+		for (unsigned int v = 0; v < n; ++v)
+			remap[v] = v;
+		std::fill(touched.begin(), touched.end(), 0);
+		for (const Collapse &c : collapses)
+		{
+			if (c.error > errorLimit || applied >= budget)
+				break;
+			if (touched[c.from] || touched[c.to])
+				continue;
+
+			/* Nenhum triângulo que sobrevive pode virar do avesso */
+			const glm::vec3 target = positionOf(vertices[c.to]);
+			bool flips = false;
+			for (unsigned int a = offsets[c.from]; a < offsets[c.from + 1] && !flips; ++a)
+			{
+				const unsigned int *tri = &result[adjacency[a] * 3];
+				if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to)
+					continue; // Vai degenerar e sair
+				glm::vec3 p[3], q[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					p[k] = positionOf(vertices[tri[k]]);
+					q[k] = (tri[k] == c.from) ? target : p[k];
+				}
+				flips = glm::dot(glm::cross(p[1] - p[0], p[2] - p[0]), glm::cross(q[1] - q[0], q[2] - q[0])) <= 0.0f;
+			}
+			if (flips)
+				continue;
+
+			remap[c.from] = c.to;
+			addQuadric(quadrics[c.to], quadrics[c.from]);
+			for (unsigned int a = offsets[c.from]; a < offsets[c.from + 1]; ++a)
+				for (int k = 0; k < 3; ++k)
+					touched[result[adjacency[a] * 3 + k]] = 1;
+			worstError = std::max(worstError, c.error);
+			++applied;
+		}
+		if (applied == 0)
+			break;
+
+		/* Reescreve os índices sem os triângulos degenerados */
+		size_t out = 0;
+		for (size_t t = 0; t < result.size(); t += 3)
+		{
+			unsigned int a = remap[result[t]], b = remap[result[t + 1]], c = remap[result[t + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+			result[out++] = a;
+			result[out++] = b;
+			result[out++] = c;
+		}
+		result.resize(out);
+	}
+
+	if (resultError)
+		*resultError = static_cast<float>(std::sqrt(worstError));
+	return result;
+}
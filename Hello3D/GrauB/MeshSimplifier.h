@@ -0,0 +1,42 @@
+// MeshSimplifier.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <vector>	 // Necessário para usar std::vector
+
+#include "Vertex.h" // Vértice em float
+
+// Níveis de detalhe por geometria, contando o original (LOD 0)
+const unsigned int MESH_LOD_MAX = 5;
+
+// Cada nível tenta manter esta fração dos triângulos do anterior
+const float MESH_LOD_RATIO = 0.5f;
+
+// Erro máximo de um nível, relativo ao raio da geometria (a cadeia para antes de passar disso)
+const float MESH_LOD_MAX_ERROR = 0.05f;
+
+// Um nível que não remova pelo menos 15% dos triângulos do anterior não é gerado
+const float MESH_LOD_MIN_REDUCTION = 0.85f;
+
+// Um nível de detalhe: trecho do index buffer (todos os níveis usam o mesmo VBO)
+struct MeshLod
+{
+	unsigned int indexOffset;		// Primeiro índice no EBO
+	unsigned int indexCount;		// 3 por triângulo
+	float error;								// Erro quádrico: raiz da distância quadrática média aos planos
+															// originais no pior colapso (acumulada entre níveis), relativo ao raio
+	unsigned int meshletOffset; // Meshlets que cobrem o trecho (meshletCount = 0: desenhado inteiro)
+	unsigned int meshletCount;
+	unsigned int reserved;
+};
+
+// Simplificação por colapso de arestas com métrica de erro quádrica (Garland e Heckbert):
+// cada vértice só pode colapsar sobre um vizinho já existente, então o resultado é apenas um
+// novo index buffer para os mesmos vértices. Vértices em costuras (mesma posição com outro
+// texcoord / normal) e em bordas ficam fixos. Para em targetIndexCount ou quando o próximo
+// colapso passaria de maxError (distância absoluta); resultError recebe o erro atingido
+std::vector<unsigned int> simplifyMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+																			 size_t targetIndexCount, float maxError, float *resultError = nullptr);
+
+// Raio da esfera envolvente centrada na caixa dos vértices (escala dos erros relativos)
+float meshRadius(const std::vector<Vertex> &vertices);
@@ -0,0 +1,238 @@
+// Meshlet.cpp
+#include "Meshlet.h" // Inclui o arquivo de cabeçalho dos meshlets
+
+#include <algorithm> // std::sort / std::min / std::max
+#include <cmath>		 // std::sqrt
+
+#include <glm/glm.hpp> // glm::vec3 / cross / dot
+
+static inline glm::vec3 positionOf(const Vertex &v)
+{
+	return glm::vec3(v.x, v.y, v.z);
+}
+
+/*****************************************************************************************
+ *  computeMeshletBounds()
+ *  --------------------------------------------------------------------------------------
+ *  Esfera: centro da caixa dos vértices e a maior distância até ele.
+ *  Cone: eixo = média das normais dos triângulos; o meio-ângulo vem da normal mais
+ *  afastada do eixo (cutoff = seno dele). O ápice é recuado ao longo do eixo até ficar
+ *  atrás do plano de todos os triângulos, de modo que uma câmera dentro do cone a partir
+ *  do ápice veja todos eles de costas. Clusters com normais espalhadas demais (mais de
+ *  ~84 graus do eixo) ficam sem cone.
+ *****************************************************************************************/
+static void computeMeshletBounds(const std::vector<Vertex> &vertices, const unsigned int *indices, Meshlet &meshlet)
+{
+	const size_t triangleCount = meshlet.indexCount / 3;
+
+	glm::vec3 lo = positionOf(vertices[indices[0]]), hi = lo;
+	for (size_t i = 1; i < meshlet.indexCount; ++i)
+	{
+		lo = glm::min(lo, positionOf(vertices[indices[i]]));
+		hi = glm::max(hi, positionOf(vertices[indices[i]]));
+	}
+	glm::vec3 center = 0.5f * (lo + hi);
+	float radius = 0.0f;
+	for (size_t i = 0; i < meshlet.indexCount; ++i)
+		radius = std::max(radius, glm::length(positionOf(vertices[indices[i]]) - center));
+
+	std::vector<glm::vec3> normals(triangleCount, glm::vec3(0.0f));
+	glm::vec3 axis(0.0f);
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		glm::vec3 a = positionOf(vertices[indices[t * 3]]), b = positionOf(vertices[indices[t * 3 + 1]]),
+							c = positionOf(vertices[indices[t * 3 + 2]]);
+		glm::vec3 n = glm::cross(b - a, c - a);
+		float length = glm::length(n);
+		if (length > 0.0f)
+			normals[t] = n / length; // Triângulos degenerados não restringem o cone
+		axis += normals[t];
+	}
+
+	for (int a = 0; a < 3; ++a)
+	{
+		meshlet.center[a] = center[a];
+		meshlet.coneApex[a] = center[a];
+		meshlet.coneAxis[a] = 0.0f;
+	}
+	meshlet.radius = radius;
+	meshlet.coneCutoff = 2.0f; // Sem cone
+
+	float axisLength = glm::length(axis);
+	if (axisLength <= 0.0f)
+		return;
+	axis /= axisLength;
+
+	float minDot = 1.0f;
+	for (const glm::vec3 &n : normals)
+		if (n != glm::vec3(0.0f))
+			minDot = std::min(minDot, glm::dot(n, axis));
+	if (minDot <= 0.1f)
+		return;
+
+	float apexDistance = 0.0f;
+	for (size_t t = 0; t < triangleCount; ++t)
+		if (normals[t] != glm::vec3(0.0f))
+		{
+			/* dot(centro - t * eixo - canto, normal) <= 0 */
+			float distance = glm::dot(center - positionOf(vertices[indices[t * 3]]), normals[t]);
+			apexDistance = std::max(apexDistance, distance / glm::dot(normals[t], axis));
+		}
+
+	glm::vec3 apex = center - axis * apexDistance;
+	for (int a = 0; a < 3; ++a)
+	{
+		meshlet.coneApex[a] = apex[a];
+		meshlet.coneAxis[a] = axis[a];
+	}
+	meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+/*****************************************************************************************
+ *  buildMeshlets()
+ *  --------------------------------------------------------------------------------------
+ *  Cada meshlet começa no primeiro triângulo ainda livre (na ordem atual, então os
+ *  clusters seguem aproximadamente a ordem do Tipsify / overdraw) e cresce pelos
+ *  triângulos que dividem vértices com ele, escolhendo o de menor custo:
+ *      vértices novos + (1 - normal . eixo médio) / 2
+ *  Para em MESHLET_MAX_TRIANGLES, ou quando nenhum vizinho cabe em MESHLET_MAX_VERTICES.
+ *****************************************************************************************/
+std::vector<Meshlet> buildMeshlets(const std::vector<Vertex> &vertices, std::vector<unsigned int> &indices,
+																	 size_t indexOffset, size_t indexCount)
+{
+	const unsigned int NONE = ~0u;
+	const size_t triangleCount = indexCount / 3;
+	const unsigned int *triangles = indices.data() + indexOffset;
+	std::vector<Meshlet> meshlets;
+	if (triangleCount == 0)
+		return meshlets;
+
+	/* Adjacência vértice -> triângulos do trecho, normais dos triângulos */
+	std::vector<unsigned int> offsets(vertices.size() + 1, 0), adjacency(triangleCount * 3);
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+		++offsets[triangles[i] + 1];
+	for (size_t v = 0; v < vertices.size(); ++v)
+		offsets[v + 1] += offsets[v];
+	{
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			adjacency[fill[triangles[i]]++] = static_cast<unsigned int>(i / 3);
+	}
+	std::vector<glm::vec3> normals(triangleCount);
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		glm::vec3 a = positionOf(vertices[triangles[t * 3]]), b = positionOf(vertices[triangles[t * 3 + 1]]),
+							c = positionOf(vertices[triangles[t * 3 + 2]]);
+		glm::vec3 n = glm::cross(b - a, c - a);
+		float length = glm::length(n);
+		normals[t] = (length > 0.0f) ? n / length : glm::vec3(0.0f);
+	}
+
+	/* Carimbos com o número do meshlet atual: vértice já nele / triângulo já candidato */
+	std::vector<unsigned int> vertexStamp(vertices.size(), 0), candidateStamp(triangleCount, 0);
+	std::vector<unsigned char> emitted(triangleCount, 0);
+	std::vector<unsigned int> order, members, candidates;
+	order.reserve(triangleCount);
+	std::vector<size_t> starts;
+
+	size_t seed = 0;
+	for (unsigned int stamp = 1;; ++stamp)
+	{
+		while (seed < triangleCount && emitted[seed])
+			++seed;
+		if (seed == triangleCount)
+			break;
+
+		members.clear();
+		candidates.clear();
+		unsigned int vertexCount = 0;
+		glm::vec3 normalSum(0.0f);
+		for (unsigned int next = static_cast<unsigned int>(seed); next != NONE;)
+		{
+			emitted[next] = 1;
+			members.push_back(next);
+			normalSum += normals[next];
+			for (int k = 0; k < 3; ++k)
+			{
+				unsigned int v = triangles[next * 3 + k];
+				if (vertexStamp[v] == stamp)
+					continue;
+				vertexStamp[v] = stamp;
+				++vertexCount;
+				for (unsigned int a = offsets[v]; a < offsets[v + 1]; ++a)
+					if (!emitted[adjacency[a]] && candidateStamp[adjacency[a]] != stamp)
+					{
+						candidateStamp[adjacency[a]] = stamp;
+						candidates.push_back(adjacency[a]);
+					}
+			}
+			if (members.size() == MESHLET_MAX_TRIANGLES)
+				break;
+
+			/* Próximo triângulo: o mais barato entre os vizinhos que ainda cabem */
+			float axisLength = glm::length(normalSum);
+			glm::vec3 axis = (axisLength > 0.0f) ? normalSum / axisLength : glm::vec3(0.0f);
+			float bestCost = 0.0f;
+			size_t kept = 0;
+			next = NONE;
+			for (unsigned int c : candidates)
+			{
+				if (emitted[c])
+					continue;
+				candidates[kept++] = c;
+				unsigned int newVertices = 0;
+				for (int k = 0; k < 3; ++k)
+					newVertices += vertexStamp[triangles[c * 3 + k]] != stamp;
+				if (vertexCount + newVertices > MESHLET_MAX_VERTICES)
+					continue;
+				float cost = newVertices + 0.5f * (1.0f - glm::dot(normals[c], axis));
+				if (next == NONE || cost < bestCost || (cost == bestCost && c < next))
+				{
+					next = c;
+					bestCost = cost;
+				}
+			}
+			candidates.resize(kept);
+		}
+
+		/* Dentro do meshlet, a ordem anterior (amigável ao cache de vértices) */
+		std::sort(members.begin(), members.end());
+		starts.push_back(order.size());
+		order.insert(order.end(), members.begin(), members.end());
+	}
+	starts.push_back(order.size());
+
+	/* Reescreve o trecho agrupado por meshlet */
+	std::vector<unsigned int> original(triangles, triangles + triangleCount * 3);
+	for (size_t i = 0; i < order.size(); ++i)
+		for (int k = 0; k < 3; ++k)
+			indices[indexOffset + i * 3 + k] = original[order[i] * 3 + k];
+
+	meshlets.resize(starts.size() - 1);
+	for (size_t m = 0; m < meshlets.size(); ++m)
+	{
+		Meshlet &meshlet = meshlets[m];
+		meshlet = Meshlet{};
+		meshlet.indexOffset = static_cast<unsigned int>(indexOffset + starts[m] * 3);
+		meshlet.indexCount = static_cast<unsigned int>((starts[m + 1] - starts[m]) * 3);
+		computeMeshletBounds(vertices, indices.data() + meshlet.indexOffset, meshlet);
+	}
+	return meshlets;
+}
+
+/*****************************************************************************************
+ *  validMeshlets()
+ *****************************************************************************************/
+bool validMeshlets(const Meshlet *meshlets, unsigned int meshletCount, unsigned int indexOffset, unsigned int indexCount)
+{
+	if (meshletCount == 0)
+		return true;
+	unsigned long long next = indexOffset;
+	for (unsigned int m = 0; m < meshletCount; ++m)
+	{
+		if (meshlets[m].indexOffset != next || meshlets[m].indexCount == 0 || meshlets[m].indexCount % 3 != 0)
+			return false;
+		next += meshlets[m].indexCount;
+	}
+	return next == static_cast<unsigned long long>(indexOffset) + indexCount;
+}
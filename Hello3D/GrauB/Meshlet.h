@@ -0,0 +1,39 @@
+// Meshlet.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <vector>	 // Necessário para usar std::vector
+
+#include "Vertex.h" // Vértice em float
+
+// Limites de um meshlet (cluster): vértices distintos e triângulos
+const unsigned int MESHLET_MAX_VERTICES = 64;
+const unsigned int MESHLET_MAX_TRIANGLES = 124;
+
+// Níveis com menos triângulos que isto são desenhados inteiros (não compensa testar clusters)
+const unsigned int MESHLET_MIN_TRIANGLES = 512;
+
+// Cluster de triângulos contíguos no index buffer, com os volumes usados no descarte por
+// cluster. Tudo no espaço do objeto (posições já decodificadas)
+struct Meshlet
+{
+	float center[3], radius; // Esfera envolvente
+	float coneApex[3];			 // Cone de normais: o cluster está de costas quando
+	float coneCutoff;				 // dot(normalize(coneApex - câmera), coneAxis) >= coneCutoff (> 1 = nunca)
+	float coneAxis[3];
+	unsigned int indexOffset; // Primeiro índice no EBO
+	unsigned int indexCount;	// 3 por triângulo
+	unsigned int reserved[3];
+};
+
+// Agrupa os triângulos de indices[indexOffset, indexOffset + indexCount) em meshlets: cresce
+// cada cluster pelos triângulos vizinhos que acrescentam menos vértices novos (e, no empate,
+// com a normal mais parecida), então os clusters saem compactos e com cones estreitos. Os
+// triângulos do trecho são reordenados para que cada meshlet seja contíguo; dentro dele
+// mantêm a ordem anterior (a do Tipsify). Devolve os meshlets com offsets absolutos
+std::vector<Meshlet> buildMeshlets(const std::vector<Vertex> &vertices, std::vector<unsigned int> &indices,
+																	 size_t indexOffset, size_t indexCount);
+
+// true se os meshlets cobrem exatamente o trecho [indexOffset, indexOffset + indexCount)
+// do index buffer, em ordem (validação de entradas do cache / pacotes)
+bool validMeshlets(const Meshlet *meshlets, unsigned int meshletCount, unsigned int indexOffset, unsigned int indexCount);
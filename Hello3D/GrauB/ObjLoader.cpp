@@ -0,0 +1,491 @@
+// ObjLoader.cpp
+#include "ObjLoader.h" // Inclui o arquivo de cabeçalho do carregador de OBJ
+
+#include <algorithm> // std::copy / std::max
+#include <chrono>		// Medição de tempo do benchmark
+#include <climits>	// INT_MAX
+#include <cstring>	// memchr
+#include <iostream> // Saída de dados no console
+#include <thread>		// Leitura em paralelo por blocos
+
+#include "MappedFile.h" // Arquivo mapeado em memória
+#include "TextTokens.h" // isBlank / skipBlanks / skipToken / parseFloat
+
+/* Lê um inteiro com sinal opcional; "found" indica se havia ao menos um dígito. Um valor
+   além de INT_MAX é consumido inteiro, mas conta como índice malformado (found = false) */
+static inline const char *parseInt(const char *p, const char *end, int &out, bool &found)
+{
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+
+	const char *digits = p;
+	long long value = 0;
+	while (p < end && static_cast<unsigned>(*p - '0') < 10u)
+	{
+		if (value <= INT_MAX) // Satura: o acumulador nunca transborda, por mais dígitos que haja
+			value = value * 10 + (*p - '0');
+		++p;
+	}
+
+	found = (p != digits) && value <= INT_MAX;
+	out = found ? static_cast<int>(negative ? -value : value) : 0;
+	return p;
+}
+
+/* Converte um índice OBJ (1-based, ou negativo = relativo ao fim) para 0-based; -1 = ausente.
+   Um negativo que passa do início fica negativo aqui: só rebaseIndex() decide se é válido */
+static inline int resolveIndex(int index, bool found, size_t count)
+{
+	if (!found || index == 0)
+		return -1;
+	return index > 0 ? index - 1 : static_cast<int>(count) + index;
+}
+
+/* Lê um canto de face nos formatos v, v/vt, v//vn ou v/vt/vn.
+   "relative" recebe um bit por componente (1 = v, 2 = vt, 4 = vn) escrito como índice negativo */
+static inline const char *parseCorner(const char *p, const char *end, const ObjData &data,
+																			ObjCorner &corner, unsigned &relative)
+{
+	int v = 0, t = 0, n = 0;
+	bool hasV = false, hasT = false, hasN = false;
+
+	p = parseInt(p, end, v, hasV);
+	if (p < end && *p == '/')
+	{
+		p = parseInt(p + 1, end, t, hasT);
+		if (p < end && *p == '/')
+			p = parseInt(p + 1, end, n, hasN);
+	}
+
+	corner.v = resolveIndex(v, hasV, data.positions.size());
+	corner.t = resolveIndex(t, hasT, data.texcoords.size());
+	corner.n = resolveIndex(n, hasN, data.normals.size());
+	relative = (hasV && v < 0 ? 1u : 0u) | (hasT && t < 0 ? 2u : 0u) | (hasN && n < 0 ? 4u : 0u);
+	return skipToken(p, end);
+}
+
+/* Soma o deslocamento global do bloco a um índice relativo. Se mesmo assim ele aponta para
+   antes do início do arquivo (.obj malformado), vira ausente, nas duas versões do parser */
+static inline int rebaseIndex(int index, size_t base)
+{
+	long long global = static_cast<long long>(index) + static_cast<long long>(base);
+	return global < 0 ? -1 : static_cast<int>(global);
+}
+
+// Canto cujo índice negativo foi resolvido contra as contagens locais de um bloco
+struct ObjFixup
+{
+	size_t corner;		 // Posição do canto em ObjData::corners
+	unsigned relative; // Componentes a rebasear (mesmos bits de parseCorner)
+};
+
+/*****************************************************************************************
+ *  parseChunk()
+ *  --------------------------------------------------------------------------------------
+ *  Percorre [begin, end) linha a linha (memchr por '\n') e interpreta os registros v / vt
+ *  / vn / f no próprio buffer. Assim como o carregador original, apenas os três primeiros
+ *  cantos de cada face são considerados (triângulos).
+ *  Índices positivos de face já são globais; os negativos são resolvidos contra as
+ *  contagens deste bloco e anotados em "fixups" para serem rebaseados depois.
+ *****************************************************************************************/
+static void parseChunk(const char *begin, const char *end, ObjData &data, std::vector<ObjFixup> &fixups)
+{
+	const char *line = begin;
+
+	while (line < end)
+	{
+		const char *eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+		if (!eol)
+			eol = end;
+
+		const char *p = skipBlanks(line, eol);
+		const char *keyEnd = skipToken(p, eol);
+		size_t keyLen = keyEnd - p;
+
+		/* Posições de vértice */
+		if (keyLen == 1 && p[0] == 'v')
+		{
+			glm::vec3 pos;
+			p = parseFloat(keyEnd, eol, pos.x);
+			p = parseFloat(p, eol, pos.y);
+			parseFloat(p, eol, pos.z);
+			data.positions.push_back(pos);
+		}
+		/* Coordenadas de textura */
+		else if (keyLen == 2 && p[0] == 'v' && p[1] == 't')
+		{
+			glm::vec2 uv;
+			p = parseFloat(keyEnd, eol, uv.x);
+			parseFloat(p, eol, uv.y);
+			data.texcoords.push_back(uv);
+		}
+		/* Normais */
+		else if (keyLen == 2 && p[0] == 'v' && p[1] == 'n')
+		{
+			glm::vec3 n;
+			p = parseFloat(keyEnd, eol, n.x);
+			p = parseFloat(p, eol, n.y);
+			parseFloat(p, eol, n.z);
+			data.normals.push_back(n);
+		}
+		/* Faces (triângulos) */
+		else if (keyLen == 1 && p[0] == 'f')
+		{
+			ObjCorner corners[3];
+			unsigned relative[3];
+			int count = 0;
+			p = skipBlanks(keyEnd, eol);
+			while (count < 3 && p < eol)
+			{
+				p = skipBlanks(parseCorner(p, eol, data, corners[count], relative[count]), eol);
+				++count;
+			}
+			if (count == 3)
+			{
+				for (int i = 0; i < 3; ++i)
+					if (relative[i])
+						fixups.push_back({data.corners.size() + i, relative[i]});
+				data.corners.insert(data.corners.end(), corners, corners + 3);
+			}
+		}
+
+		line = eol + 1;
+	}
+}
+
+/* Executa job(i) para i em [0, count) usando até threadCount threads */
+template <typename Job>
+static void runParallel(unsigned count, unsigned threadCount, Job job)
+{
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < threadCount && t < count; ++t)
+		workers.emplace_back([&, t]()
+												 { for (unsigned i = t; i < count; i += threadCount) job(i); });
+	for (unsigned i = 0; i < count; i += threadCount)
+		job(i);
+	for (std::thread &w : workers)
+		w.join();
+}
+
+/* Número de threads a usar: 0 = automático (todas as threads de hardware para arquivos grandes) */
+static unsigned resolveThreadCount(unsigned threadCount, size_t bytes)
+{
+	if (threadCount == 0)
+		threadCount = bytes >= OBJ_PARALLEL_MIN_BYTES ? std::thread::hardware_concurrency() : 1;
+	return threadCount == 0 ? 1 : threadCount;
+}
+
+/*****************************************************************************************
+ *  parseObj()
+ *  --------------------------------------------------------------------------------------
+ *  Versão serial: o arquivo inteiro é um único bloco, então as contagens locais já são as
+ *  globais; os índices negativos só passam por rebaseIndex() com deslocamento 0, para que
+ *  os que apontam para antes do início virem ausentes como na versão paralela.
+ *  Versão paralela:
+ *    1. Divide o buffer em "threadCount" blocos, ajustando cada corte para o início de
+ *       uma linha.
+ *    2. Cada thread interpreta o seu bloco em um ObjData local.
+ *    3. Soma de prefixos sobre as contagens de cada bloco dá o deslocamento global de
+ *       v / vt / vn / cantos de cada bloco.
+ *    4. Cada thread copia o seu bloco para o deslocamento global e rebaseia os índices
+ *       negativos anotados no passo 2.
+ *  O resultado é idêntico bit a bit ao da versão serial.
+ *****************************************************************************************/
+ObjData parseObj(const char *begin, const char *end, unsigned threadCount)
+{
+	threadCount = resolveThreadCount(threadCount, end - begin);
+
+	if (threadCount <= 1)
+	{
+		ObjData data;
+		std::vector<ObjFixup> fixups;
+		parseChunk(begin, end, data, fixups);
+		for (const ObjFixup &f : fixups)
+		{
+			ObjCorner &corner = data.corners[f.corner];
+			if (f.relative & 1u)
+				corner.v = rebaseIndex(corner.v, 0);
+			if (f.relative & 2u)
+				corner.t = rebaseIndex(corner.t, 0);
+			if (f.relative & 4u)
+				corner.n = rebaseIndex(corner.n, 0);
+		}
+		return data;
+	}
+
+	/* 1. Cortes nas fronteiras de linha */
+	std::vector<const char *> cuts(threadCount + 1);
+	cuts[0] = begin;
+	cuts[threadCount] = end;
+	for (unsigned c = 1; c < threadCount; ++c)
+	{
+		const char *p = begin + (end - begin) * c / threadCount;
+		if (p < cuts[c - 1])
+			p = cuts[c - 1];
+		const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+		cuts[c] = eol ? eol + 1 : end;
+	}
+
+	/* 2. Interpretação independente de cada bloco */
+	std::vector<ObjData> chunks(threadCount);
+	std::vector<std::vector<ObjFixup>> fixups(threadCount);
+	runParallel(threadCount, threadCount, [&](unsigned c)
+							{ parseChunk(cuts[c], cuts[c + 1], chunks[c], fixups[c]); });
+
+	/* 3. Soma de prefixos das contagens por bloco */
+	struct Offsets
+	{
+		size_t positions, texcoords, normals, corners;
+	};
+	std::vector<Offsets> base(threadCount + 1, Offsets{0, 0, 0, 0});
+	for (unsigned c = 0; c < threadCount; ++c)
+	{
+		base[c + 1].positions = base[c].positions + chunks[c].positions.size();
+		base[c + 1].texcoords = base[c].texcoords + chunks[c].texcoords.size();
+		base[c + 1].normals = base[c].normals + chunks[c].normals.size();
+		base[c + 1].corners = base[c].corners + chunks[c].corners.size();
+	}
+
+	/* 4. Cópia para as posições globais + rebase dos índices relativos */
+	ObjData data;
+	data.positions.resize(base[threadCount].positions);
+	data.texcoords.resize(base[threadCount].texcoords);
+	data.normals.resize(base[threadCount].normals);
+	data.corners.resize(base[threadCount].corners);
+
+	runParallel(threadCount, threadCount, [&](unsigned c)
+							{
+		const ObjData &chunk = chunks[c];
+		std::copy(chunk.positions.begin(), chunk.positions.end(), data.positions.begin() + base[c].positions);
+		std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), data.texcoords.begin() + base[c].texcoords);
+		std::copy(chunk.normals.begin(), chunk.normals.end(), data.normals.begin() + base[c].normals);
+
+		ObjCorner *corners = data.corners.data() + base[c].corners;
+		std::copy(chunk.corners.begin(), chunk.corners.end(), corners);
+		for (const ObjFixup &f : fixups[c])
+		{
+			if (f.relative & 1u)
+				corners[f.corner].v = rebaseIndex(corners[f.corner].v, base[c].positions);
+			if (f.relative & 2u)
+				corners[f.corner].t = rebaseIndex(corners[f.corner].t, base[c].texcoords);
+			if (f.relative & 4u)
+				corners[f.corner].n = rebaseIndex(corners[f.corner].n, base[c].normals);
+		} });
+
+	return data;
+}
+
+/* Monta os vértices dos cantos [first, last) de "corners" usando os atributos de "data" */
+static void expandRange(const ObjData &data, const ObjCorner *corners, size_t first, size_t last, Vertex *out)
+{
+	for (size_t i = first; i < last; ++i)
+	{
+		const ObjCorner &c = corners[i];
+		Vertex &v = out[i];
+		if (c.v >= 0 && static_cast<size_t>(c.v) < data.positions.size())
+		{
+			v.x = data.positions[c.v].x;
+			v.y = data.positions[c.v].y;
+			v.z = data.positions[c.v].z;
+		}
+		if (c.t >= 0 && static_cast<size_t>(c.t) < data.texcoords.size())
+		{
+			v.s = data.texcoords[c.t].x;
+			v.t = data.texcoords[c.t].y;
+		}
+		if (c.n >= 0 && static_cast<size_t>(c.n) < data.normals.size())
+		{
+			v.nx = data.normals[c.n].x;
+			v.ny = data.normals[c.n].y;
+			v.nz = data.normals[c.n].z;
+		}
+	}
+}
+
+/*****************************************************************************************
+ *  expandObj()
+ *  --------------------------------------------------------------------------------------
+ *  Monta um Vertex por canto de face. Índices ausentes ou fora do intervalo deixam o
+ *  atributo correspondente zerado. Com threadCount > 1 os cantos são divididos em faixas
+ *  contíguas, uma por thread.
+ *****************************************************************************************/
+std::vector<Vertex> expandObj(const ObjData &data, unsigned threadCount)
+{
+	std::vector<Vertex> vertices(data.corners.size(), Vertex{});
+	threadCount = resolveThreadCount(threadCount, data.corners.size() * sizeof(Vertex));
+
+	size_t count = data.corners.size();
+	runParallel(threadCount, threadCount, [&](unsigned t)
+							{ expandRange(data, data.corners.data(), count * t / threadCount, count * (t + 1) / threadCount, vertices.data()); });
+	return vertices;
+}
+
+/* Hash de um trio v/vt/vn, usado como chave na soldagem */
+static inline size_t hashCorner(const ObjCorner &c)
+{
+	unsigned long long h = static_cast<unsigned int>(c.v) * 0x9E3779B97F4A7C15ull;
+	h ^= (static_cast<unsigned int>(c.t) + (h << 6) + (h >> 2)) * 0xBF58476D1CE4E5B9ull;
+	h ^= (static_cast<unsigned int>(c.n) + (h << 6) + (h >> 2)) * 0x94D049BB133111EBull;
+	return static_cast<size_t>(h ^ (h >> 31));
+}
+
+/*****************************************************************************************
+ *  indexObj()
+ *  --------------------------------------------------------------------------------------
+ *  Percorre os cantos na ordem das faces; o primeiro canto de cada trio v/vt/vn distinto
+ *  gera um novo vértice e os seguintes reaproveitam o seu índice. A ordem dos triângulos
+ *  é preservada, então indices[i] aponta para um vértice idêntico a expandObj(data)[i].
+ *  A tabela hash usa endereçamento aberto (sondagem linear) e guarda apenas o índice do
+ *  vértice único: 4 bytes por posição e nenhuma alocação por entrada.
+ *****************************************************************************************/
+IndexedGeometry indexObj(const ObjData &data)
+{
+	const unsigned int EMPTY = 0xFFFFFFFFu;
+	IndexedGeometry geometry;
+	geometry.indices.resize(data.corners.size());
+
+	size_t capacity = 16;
+	while (capacity < data.corners.size() * 2)
+		capacity <<= 1;
+	std::vector<unsigned int> table(capacity, EMPTY);
+
+	std::vector<ObjCorner> unique;
+	for (size_t i = 0; i < data.corners.size(); ++i)
+	{
+		const ObjCorner &c = data.corners[i];
+		size_t slot = hashCorner(c) & (capacity - 1);
+		while (table[slot] != EMPTY)
+		{
+			const ObjCorner &u = unique[table[slot]];
+			if (u.v == c.v && u.t == c.t && u.n == c.n)
+				break;
+			slot = (slot + 1) & (capacity - 1);
+		}
+		if (table[slot] == EMPTY)
+		{
+			table[slot] = static_cast<unsigned int>(unique.size());
+			unique.push_back(c);
+		}
+		geometry.indices[i] = table[slot];
+	}
+
+	/* Expande apenas os trios únicos */
+	geometry.vertices.assign(unique.size(), Vertex{});
+	expandRange(data, unique.data(), 0, unique.size(), geometry.vertices.data());
+	return geometry;
+}
+
+/*****************************************************************************************
+ *  setupObj()
+ *  --------------------------------------------------------------------------------------
+ *  Carrega um arquivo .obj simples (v / vt / vn / f) e devolve um vetor de Vertex pronto
+ *  para envio à GPU.
+ *  Passo a passo:
+ *    1. Mapeia o arquivo inteiro em memória (sem cópia para std::string).
+ *    2. Interpreta os registros diretamente no buffer mapeado (parseObj), em paralelo
+ *       quando o arquivo é grande o bastante.
+ *    3. Converte os cantos das faces em instâncias de Vertex (expandObj).
+ *****************************************************************************************/
+std::vector<Vertex> setupObj(const std::string path, unsigned threadCount)
+{
+	MappedFile file(path);
+	if (!file.isOpen())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+		return std::vector<Vertex>();
+	}
+	threadCount = resolveThreadCount(threadCount, file.size());
+	return expandObj(parseObj(file.data(), file.end(), threadCount), threadCount);
+}
+
+/*****************************************************************************************
+ *  setupIndexedObj()
+ *  --------------------------------------------------------------------------------------
+ *  Mesmo fluxo de setupObj(), trocando a expansão por vértice pela soldagem de indexObj().
+ *****************************************************************************************/
+IndexedGeometry setupIndexedObj(const std::string path, unsigned threadCount)
+{
+	MappedFile file(path);
+	if (!file.isOpen())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+		return IndexedGeometry();
+	}
+	return indexObj(parseObj(file.data(), file.end(), resolveThreadCount(threadCount, file.size())));
+}
+
+/* Melhor tempo (s) de "repetitions" execuções de setupObj() */
+static double timeObjLoader(const std::string &path, int repetitions, unsigned threadCount,
+														std::vector<Vertex> &vertices)
+{
+	double best = 0.0;
+	for (int r = 0; r < repetitions; ++r)
+	{
+		auto start = std::chrono::steady_clock::now();
+		vertices = setupObj(path, threadCount);
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (r == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+	return best;
+}
+
+/*****************************************************************************************
+ *  benchmarkObjLoader()
+ *  --------------------------------------------------------------------------------------
+ *  Executa setupObj() "repetitions" vezes sobre o mesmo arquivo, primeiro com 1 thread e
+ *  depois dobrando até "maxThreads", e imprime o melhor tempo, a vazão em MB/s e o
+ *  ganho sobre a versão serial. Também confere se cada resultado paralelo é idêntico
+ *  ao serial.
+ *  Uso: Hello3D --bench-obj <arquivo.obj> [repetições] [threads]
+ *****************************************************************************************/
+int benchmarkObjLoader(const std::string path, int repetitions, unsigned maxThreads)
+{
+	size_t fileSize;
+	{
+		MappedFile file(path);
+		if (!file.isOpen())
+		{
+			std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+			return -1;
+		}
+		fileSize = file.size();
+	}
+	if (maxThreads == 0)
+		maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	double megabytes = fileSize / (1024.0 * 1024.0);
+	std::vector<Vertex> serial;
+	double serialTime = timeObjLoader(path, repetitions, 1, serial);
+	std::cout << "OBJ " << path << ": " << megabytes << " MB, " << serial.size() << " vertices\n";
+
+	int status = 0;
+	for (unsigned threads = 1; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads != maxThreads) ? maxThreads : threads * 2)
+	{
+		std::vector<Vertex> vertices;
+		double best = threads == 1 ? serialTime : timeObjLoader(path, repetitions, threads, vertices);
+		bool identical = threads == 1 ||
+										 (vertices.size() == serial.size() &&
+											std::memcmp(vertices.data(), serial.data(), serial.size() * sizeof(Vertex)) == 0);
+		if (!identical)
+			status = -1;
+
+		std::cout << "  " << threads << " thread(s), melhor de " << repetitions << ": " << best * 1000.0 << " ms ("
+							<< (best > 0.0 ? megabytes / best : 0.0) << " MB/s, " << (best > 0.0 ? serialTime / best : 0.0) << "x)"
+							<< (identical ? "" : "  DIFERENTE DO SERIAL") << std::endl;
+		if (threads == maxThreads)
+			break;
+	}
+
+	/* Soldagem: quantos vértices sobram e quanto custa gerar o index buffer */
+	auto start = std::chrono::steady_clock::now();
+	IndexedGeometry indexed = setupIndexedObj(path, maxThreads);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << "  indexado: " << indexed.vertices.size() << " vertices unicos, " << indexed.indices.size()
+						<< " indices, " << elapsed.count() * 1000.0 << " ms" << std::endl;
+	return status;
+}
@@ -0,0 +1,53 @@
+// ObjLoader.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include <glm/glm.hpp> // Tipos glm::vec2 / glm::vec3
+
+#include "Vertex.h" // Definição da struct Vertex
+
+// Um canto de face já resolvido para índices 0-based (-1 = atributo ausente)
+struct ObjCorner
+{
+	int v, t, n;
+};
+
+// Conteúdo bruto de um .obj: atributos na ordem do arquivo e os cantos das faces (3 por triângulo)
+struct ObjData
+{
+	std::vector<glm::vec3> positions; // Linhas "v"
+	std::vector<glm::vec2> texcoords; // Linhas "vt"
+	std::vector<glm::vec3> normals;		// Linhas "vn"
+	std::vector<ObjCorner> corners;		// Linhas "f"
+};
+
+// Geometria indexada: vértices únicos + três índices por triângulo
+struct IndexedGeometry
+{
+	std::vector<Vertex> vertices;			 // Um Vertex por combinação v/vt/vn distinta
+	std::vector<unsigned int> indices; // Índices para "vertices" (3 por triângulo)
+};
+
+// Arquivos a partir deste tamanho são lidos em paralelo quando threadCount == 0 (automático)
+const size_t OBJ_PARALLEL_MIN_BYTES = 4 * 1024 * 1024;
+
+// Interpreta o texto de um .obj diretamente do buffer [begin, end), sem alocar por linha/token.
+// threadCount: 1 = serial, 0 = automático; o resultado é o mesmo para qualquer valor
+ObjData parseObj(const char *begin, const char *end, unsigned threadCount = 1);
+
+// Expande os cantos das faces em três structs Vertex por triângulo
+std::vector<Vertex> expandObj(const ObjData &data, unsigned threadCount = 1);
+
+// Solda cantos com o mesmo trio v/vt/vn em um único vértice e gera o index buffer
+IndexedGeometry indexObj(const ObjData &data);
+
+// Mapeia o arquivo em memória, interpreta-o e devolve os vértices prontos para a GPU
+std::vector<Vertex> setupObj(const std::string path, unsigned threadCount = 0);
+
+// Igual a setupObj(), mas devolve a geometria indexada (vértices soldados)
+IndexedGeometry setupIndexedObj(const std::string path, unsigned threadCount = 0);
+
+// Mede a vazão (MB/s) do carregador de OBJ com 1..maxThreads threads (0 = todas)
+int benchmarkObjLoader(const std::string path, int repetitions, unsigned maxThreads = 0);
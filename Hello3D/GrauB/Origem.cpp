@@ -5,22 +5,38 @@
 // fornecer uma explicação passo a passo do funcionamento do código.
 // ============================================================================
 
-// *** IMPLEMENTAÇÃO DA STB_IMAGE *** -----------------------------------------
-// Define que o arquivo stb_image.h incluirá apenas a implementação necessária
-// nesta tradução‑unit. Deve vir *antes* da inclusão do cabeçalho.
-#define STB_IMAGE_IMPLEMENTATION
-#include "../../Common/include/stb_image.h"
-
 // *** BIBLIOTECAS PADRÃO *** --------------------------------------------------
 #include <iostream>			 // Saída de dados no console
 #include <string>				 // Classe std::string
 #include <assert.h>			 // Assertivas de depuração
-#include <fstream>			 // Manipulação de arquivos
-#include <sstream>			 // String streams
 #include <vector>				 // Vetores dinâmicos
 #include <unordered_map> // Dicionários hash
-
-#include "Shader.h" // Classe utilitária para shaders
+#include <unordered_set> // Nomes presentes na cena recarregada
+#include <algorithm>		 // std::binary_search
+#include <chrono>				 // Medição do tempo de carga da cena
+#include <cmath>				 // std::tan (tamanho projetado das malhas)
+#include <cstring>			 // std::memcpy
+#include <limits>				 // std::numeric_limits
+#include <tuple>				 // std::tie (ordem dos grupos instanciados)
+
+#include "Shader.h"		// Classe utilitária para shaders
+#include "UniformBuffer.h" // Bloco std140 das constantes do quadro (câmera e luz)
+#include "VertexLayout.h" // MeshVertexLayout (layout do VBO e entradas do Object.vs)
+#include "ObjLoader.h" // Carregador de OBJ mapeado em memória
+#include "Material.h"	// Struct Material + leitor de .mtl
+#include "MaterialTable.h" // Coeficientes de todos os materiais em um SSBO
+#include "AssetCache.h" // Cache persistente de assets processados
+#include "GeometryRegistry.h" // Geometrias compartilhadas entre malhas do mesmo .obj
+#include "TextureRegistry.h"	// Texturas compartilhadas entre materiais da mesma imagem
+#include "GLExtensions.h"		// Extensões OpenGL (S3TC, glTexStorage2D)
+#include "SceneParser.h"			// Leitor de Scene.txt mapeado em memória
+#include "SceneLoader.h"			// Carga paralela do Scene.txt e dos arquivos referenciados
+#include "Bezier.h"						// Pontos de controle e discretização das curvas (recarga)
+#include "FileWatcher.h"			// Recarga a quente (inotify / varredura)
+#include "SceneBundle.h"			// Pacote binário da cena (--compile-scene)
+#include "Culling.h"					// Descarte de meshlets (frustum e cone de normais)
+#include "DynamicBvh.h"				// Índice espacial das malhas e curvas (descarte e seleção)
+#include "InstanceBuffer.h"			// Matrizes e dados por instância dos desenhos instanciados
 
 // *** OPENGL / FRAMEWORKS *** -------------------------------------------------
 #include <glad/glad.h>									// Carregador de funções OpenGL
@@ -33,24 +49,6 @@
 // ESTRUTURAS DE DADOS
 // ============================================================================
 
-struct Vertex
-{
-	float x, y, z;		// Posição do vértice
-	float s, t;				// Coordenadas de textura
-	float r, g, b;		// Cor (não utilizada para materiais)
-	float nx, ny, nz; // Vetor normal
-};
-
-struct Material
-{
-	// Componentes de material baseados no modelo de iluminação Phong
-	float kaR, kaG, kaB;		 // Coeficiente ambiente (Ka)
-	float kdR, kdG, kdB;		 // Coeficiente difuso   (Kd)
-	float ksR, ksG, ksB;		 // Coeficiente especular (Ks)
-	float ns;								 // Expoente especular
-	std::string textureName; // Nome do arquivo de textura
-};
-
 struct GlobalConfig
 {
 	// Parámetros de iluminação e câmera globais
@@ -69,10 +67,20 @@ struct Mesh
 	glm::vec3 angle;											// Ângulos iniciais (XYZ)
 	GLuint incrementalAngle;							// Flag p/ rotação contínua
 
-	std::vector<Vertex> vertices; // Vértices carregados
-	GLuint VAO;										// Vertex Array Object
+	GeometryId geometry;					// Geometria compartilhada no GeometryRegistry
+	unsigned int lodCount;				// Níveis de detalhe (trechos do EBO), cópia de geometry
+	MeshLod lods[MESH_LOD_MAX];
+	unsigned int lod;							// Nível desenhado no último quadro (base da histerese)
+	GLenum indexType;							// GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT
+	VertexBounds bounds;					// Decodificação das posições quantizadas (e caixa envolvente)
+	BoundingSphere sphere;				// Esfera envolvente (descarte), cópia de geometry
 	Material material;						// Material associado
-	GLuint textureID;							// ID da textura OpenGL
+	MaterialId materialId;				// Slot do material na tabela (índice enviado ao shader)
+	TextureId texture;						// Textura compartilhada no TextureRegistry (pode estar carregando)
+
+	int proxy;										// Folha na BVH da cena (BVH_NULL_NODE: fora dela)
+	glm::mat4 model;							// Matriz Model da última atualização da folha
+	glm::vec3 modelScale;					// Escala usada em model
 };
 
 struct BezierCurve
@@ -88,6 +96,45 @@ struct BezierCurve
 	GLuint VAO;													// VAO da curva
 	GLuint controlPointsVAO;						// VAO para pontos de controle
 	std::vector<glm::vec3> curvePoints; // Pontos discretizados
+	glm::vec3 boundsMin, boundsMax;			// Caixa da curva e dos pontos de controle (descarte)
+	int proxy;													// Folha na BVH da cena
+};
+
+struct LineUniforms
+{
+	// Alças das uniformes do Line.vs / Line.fs enviadas a cada curva
+	Uniform<glm::vec4> finalColor;
+};
+
+struct MeshInstance
+{
+	// Malha a desenhar no quadro atual, montada antes do descarte
+	Mesh *mesh;
+	glm::mat4 model;		 // Matriz Model do quadro
+	glm::vec3 scale;		 // Escala usada em model
+	bool isSelected;		 // Recebe a cor extra de seleção
+	bool skipLighting; // Sol: sem iluminação
+};
+
+struct MeshDraw
+{
+	// Malha visível no quadro. Ordenadas pela chave: as vizinhas com a mesma textura e o
+	// mesmo tipo de índice vão no mesmo glMultiDrawElementsIndirect, e as com a mesma
+	// geometria e LOD, no mesmo comando (instanciado)
+	TextureId texture;
+	GLenum indexType;
+	GeometryId geometry;
+	unsigned int lod;
+	bool clusters;				 // Comandos só dela, um por trecho de meshlets visíveis
+	unsigned int instance; // Índice em instances
+};
+
+struct DrawBatch
+{
+	// Comandos consecutivos desenhados com um glMultiDrawElementsIndirect
+	TextureId texture;
+	GLenum indexType;
+	size_t firstCommand, commandCount;
 };
 
 // ============================================================================
@@ -95,18 +142,40 @@ struct BezierCurve
 // ============================================================================
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
 void mouse_callback(GLFWwindow *window, double xpos, double ypos);
-void readSceneFile(const std::string sceneFilePath,
-									 std::unordered_map<std::string, Mesh> *meshes,
-									 std::vector<std::string> *meshList,
-									 std::unordered_map<std::string, BezierCurve> *bezierCurves,
-									 GlobalConfig *globalConfig);
-GLuint setupTexture(const std::string path);
-std::vector<Vertex> setupObj(const std::string path);
-Material setupMtl(const std::string path);
-int setupGeometry(std::vector<Vertex> &vertices);
-std::vector<glm::vec3> generateCircleControlPoints(glm::vec3 referencePoint, float radius);
+bool streamSceneFile(SceneLoader &loader,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures,
+										 SceneDescription *liveScene);
+void readSceneBundle(const std::string &bundlePath,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures);
+bool reloadSceneFile(const std::string &sceneFilePath,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures,
+										 SceneDescription *liveScene);
+void reloadChangedAssets(const std::vector<std::string> &changedFiles,
+												 std::unordered_map<std::string, Mesh> *meshes,
+												 GeometryRegistry *geometries,
+												 TextureRegistry *textures);
+void watchSceneFiles(FileWatcher &watcher, const std::string &sceneFilePath,
+										 const std::unordered_map<std::string, Mesh> &meshes);
+LineUniforms getLineUniforms(Shader &lineShader);
+float projectedRadius(const VertexBounds &bounds, const glm::mat4 &model, const glm::vec3 &scale, int fbHeight);
+Mesh *pickMesh(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance);
 GLuint generateControlPointsBuffer(const std::vector<glm::vec3> controlPoints);
-BezierCurve createBezierCurve(const std::vector<glm::vec3> controlPoints, int pointsPerSegment);
+void deleteControlPointsBuffer(GLuint VAO);
 
 // ============================================================================
 // VARIÁVEIS GLOBAIS
@@ -126,7 +195,8 @@ bool moveW = false, moveA = false, moveS = false, moveD = false; // Teclas W A S
 int i = 0, j = 0;							 // Índices para animação de órbitas
 float incrementalAngle = 0.0f; // Ângulo global para rotações contínuas
 
-GLuint currentlySelectedMesh = -1;								// Índice do objeto selecionado
+const GLuint NO_SELECTION = ~0u;									// Nenhum objeto selecionado (o 1º TAB passa para 0)
+GLuint currentlySelectedMesh = NO_SELECTION;			// Índice do objeto selecionado
 GLfloat selectedMeshScale = 1.0f;									// Escala aplicada ao objeto selecionado
 GLfloat selectedMeshAngle = 0.0f;									// Rotação adicional do objeto selecionado
 glm::vec2 selectedMeshPosition = glm::vec2(0.0f); // Deslocamento XY 2D
@@ -134,11 +204,71 @@ glm::vec2 selectedMeshPosition = glm::vec2(0.0f); // Deslocamento XY 2D
 // --- Depuração ---------------------------------------------------------------
 GLuint showCurves = 1; // 1 = desenha curvas; 0 = esconde
 
+// --- Índice espacial ---------------------------------------------------------
+DynamicBvh sceneBvh;				// Caixas no mundo de todas as malhas e curvas
+MaterialTable sceneMaterials; // Coeficientes dos materiais de todas as malhas (SSBO)
+bool pickRequested = false; // Tecla P: seleciona a malha no centro da tela
+
 // ============================================================================
 // FUNÇÃO PRINCIPAL
 // ============================================================================
-int main()
+int main(int argc, char *argv[])
 {
+	// Modo benchmark: mede o carregador de OBJ sem abrir janela -------------
+	if (argc >= 3 && std::string(argv[1]) == "--bench-obj")
+		return benchmarkObjLoader(argv[2], argc >= 4 ? std::stoi(argv[3]) : 10,
+															argc >= 5 ? std::stoul(argv[4]) : 0);
+
+	// Modo benchmark: mede o leitor de cena sobre cenas sintéticas ----------
+	if (argc >= 2 && std::string(argv[1]) == "--bench-scene")
+		return benchmarkSceneParser(argc >= 3 ? std::stoul(argv[2]) : 100000, argc >= 4 ? std::stoi(argv[3]) : 5);
+
+	// Modo benchmark: consultas da BVH contra força bruta -------------------
+	if (argc >= 2 && std::string(argv[1]) == "--bench-bvh")
+		return benchmarkBvh(argc >= 3 ? std::stoul(argv[2]) : 1000000, argc >= 4 ? std::stoi(argv[3]) : 3);
+
+	auto programStart = std::chrono::steady_clock::now();
+
+	// "--no-cache": ignora o cache de assets (sempre processa os arquivos de origem)
+	// "--compress-textures": envia as texturas em blocos BC1/BC3 (~6x menos memória de vídeo)
+	// "--scene <arquivo>": Scene.txt ou pacote binário a carregar (padrão: ../Scene.txt)
+	// "--no-lod": desenha sempre a malha original (LOD 0)
+	// "--no-cluster-culling": desenha os níveis inteiros, sem testar os meshlets
+	// "--no-frustum-culling": desenha todas as malhas e curvas, mesmo fora da tela
+	// "--no-instancing": um comando de desenho por malha, mesmo com a geometria repetida
+	// "--no-indirect": uma chamada de desenho por comando, sem glMultiDrawElementsIndirect
+	bool compressTextures = false, useLods = true, clusterCulling = true, frustumCulling = true, instancing = true;
+	bool indirect = true;
+	std::string scenePath = "../Scene.txt";
+	for (int arg = 1; arg < argc; ++arg)
+	{
+		if (std::string(argv[arg]) == "--no-cache")
+			assetCacheEnabled = false;
+		else if (std::string(argv[arg]) == "--compress-textures")
+			compressTextures = true;
+		else if (std::string(argv[arg]) == "--no-lod")
+			useLods = false;
+		else if (std::string(argv[arg]) == "--no-cluster-culling")
+			clusterCulling = false;
+		else if (std::string(argv[arg]) == "--no-frustum-culling")
+			frustumCulling = false;
+		else if (std::string(argv[arg]) == "--no-instancing")
+			instancing = false;
+		else if (std::string(argv[arg]) == "--no-indirect")
+			indirect = false;
+		else if (std::string(argv[arg]) == "--scene" && arg + 1 < argc)
+			scenePath = argv[++arg];
+	}
+
+	// Modo conversor: compila o Scene.txt em um pacote binário, sem abrir janela --
+	if (argc >= 4 && std::string(argv[1]) == "--compile-scene")
+		return compileSceneBundle(argv[2], argv[3], compressTextures) ? 0 : -1;
+
+	// Leitura da cena e dos arquivos que ela referencia começa já, em segundo plano,
+	// enquanto a janela e o contexto OpenGL são criados
+	SceneLoader sceneLoader;
+	sceneLoader.start(scenePath);
+
 	// --------------------------------------------------------------------
 	// 1) Inicialização da janela e do contexto OpenGL (GLFW + GLAD)
 	// --------------------------------------------------------------------
@@ -163,6 +293,7 @@ int main()
 		std::cerr << "Falha ao inicializar GLAD\n";
 		return -1;
 	}
+	loadGLExtensions((GLADloadproc)glfwGetProcAddress); // Funções além do OpenGL 3.3 (se houver)
 
 	// Informações do driver ---------------------------------------------
 	std::cout << "Renderer: " << glGetString(GL_RENDERER) << '\n'
@@ -173,59 +304,161 @@ int main()
 	glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
 	glViewport(0, 0, fbWidth, fbHeight);
 
+	// Compressão de texturas só se o driver aceitar S3TC -----------------
+	if (compressTextures && !hasGLExtension("GL_EXT_texture_compression_s3tc"))
+	{
+		std::cout << "GL_EXT_texture_compression_s3tc indisponivel: texturas serao enviadas sem compressao\n";
+		compressTextures = false;
+	}
+
 	// --------------------------------------------------------------------
 	// 2) Carregamento da cena (malhas, curvas, configurações globais)
 	// --------------------------------------------------------------------
 	std::unordered_map<std::string, Mesh> meshes;							 // Tabela de malhas
 	std::vector<std::string> meshList;												 // Lista ordenada p/ seleção
 	std::unordered_map<std::string, BezierCurve> bezierCurves; // Curvas Bézier
+	GeometryRegistry geometries;															 // Geometrias únicas por .obj (um VAO para todas)
+	TextureRegistry textures(compressTextures);								 // Texturas únicas por imagem
+
+	SceneDescription liveScene;																 // Cena em uso (base da recarga a quente)
 
-	readSceneFile("../Scene.txt", &meshes, &meshList, &bezierCurves, &globalConfig);
+	// Pacote binário: carregado aqui mesmo (só mapeamento). Scene.txt: chega aos poucos, sem
+	// bloquear, em streamSceneFile() no laço principal
+	if (sceneLoader.isBundle())
+	{
+		auto loadStart = std::chrono::steady_clock::now();
+		readSceneBundle(sceneLoader.path(), &meshes, &meshList, &bezierCurves, &globalConfig, &geometries, &textures);
+		std::cout << "Cena carregada em "
+							<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count()
+							<< " ms (texturas em segundo plano)\n";
+		geometries.printStats();
+	}
 
 	// --------------------------------------------------------------------
 	// 3) Compilação / Link de Shaders
 	// --------------------------------------------------------------------
-	Shader objectShader("../shaders/Object.vs", "../shaders/Object.fs");
+	Shader objectShader("../shaders/Object.vs", "../shaders/Object.fs", MeshVertexLayout::glsl(), materialTableGlsl());
 	Shader lineShader("../shaders/Line.vs", "../shaders/Line.fs");
+	MeshVertexLayout::reportUnused(objectShader.getId(), objectShader.getVertexPath());
 
-	// Define a unidade de textura padrão para o shader de objetos --------
+	// Unidade de textura padrão (refeito após cada recarga) ---------------
 	glUseProgram(objectShader.getId());
-	glUniform1i(glGetUniformLocation(objectShader.getId(), "tex"), 0);
+	objectShader.setTextureUniform();
 
-	// Matrizes de câmera e projeção iniciais ------------------------------
-	glm::mat4 view = glm::lookAt(globalConfig.cameraPos, globalConfig.cameraFront, cameraUp);
-	glm::mat4 projection = glm::perspective(glm::radians(globalConfig.fov),
-																					static_cast<float>(fbWidth) / fbHeight,
-																					globalConfig.nearPlane, globalConfig.farPlane);
-	glUniformMatrix4fv(glGetUniformLocation(objectShader.getId(), "view"), 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(glGetUniformLocation(objectShader.getId(), "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+	// Câmera e luz: um bloco std140 escrito uma vez por quadro e lido por todos os programas
+	UniformBuffer frameUniforms;
+	frameUniforms.create(FRAME_UNIFORMS_BINDING, sizeof(FrameUniforms));
+	for (Shader *shader : {&objectShader, &lineShader})
+		shader->bindUniformBlock("FrameUniforms", FRAME_UNIFORMS_BINDING, sizeof(FrameUniforms));
 
-	// Luz principal -------------------------------------------------------
-	glUniform3fv(glGetUniformLocation(objectShader.getId(), "lightPos"), 1, glm::value_ptr(globalConfig.lightPos));
-	glUniform3fv(glGetUniformLocation(objectShader.getId(), "lightColor"), 1, glm::value_ptr(globalConfig.lightColor));
+	// Localizações resolvidas uma vez (e por Shader::reload()), não a cada malha
+	const LineUniforms lineUniforms = getLineUniforms(lineShader);
+	glm::mat4 view; // Recalculada a cada quadro
 
-	// Shaders para curvas (usa mesma câmera / projeção) -------------------
-	glUseProgram(lineShader.getId());
-	glUniformMatrix4fv(glGetUniformLocation(lineShader.getId(), "view"), 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(glGetUniformLocation(lineShader.getId(), "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+	// Recarga a quente: shaders já; cena e arquivos dela quando a carga terminar
+	FileWatcher watcher;
+	for (Shader *shader : {&objectShader, &lineShader})
+	{
+		watcher.watch(shader->getVertexPath());
+		watcher.watch(shader->getFragmentPath());
+	}
+	std::string canonicalScenePath = canonicalPath(scenePath);
+	std::vector<std::string> changedFiles;
 
 	// Habilita o teste de profundidade (pintar pixels mais próximos) ------
 	glEnable(GL_DEPTH_TEST);
 
+	// Faces de costas (ordem horária na tela) são descartadas, como no teste de cone dos
+	// meshlets: os dois supõem malhas de um lado só, com os triângulos em ordem anti-horária
+	glEnable(GL_CULL_FACE);
+	glCullFace(GL_BACK);
+	glFrontFace(GL_CCW);
+
 	// --------------------------------------------------------------------
 	// 4) Loop principal (Game Loop)
 	// --------------------------------------------------------------------
+	bool firstFrame = true, texturesReady = false;
+	std::vector<GLsizei> drawCounts;			 // Trechos visíveis do index buffer de uma geometria
+	std::vector<GLuint> drawFirsts;
+	ClusterCullingStats cullingStats{};
+	std::vector<MeshInstance> instances;	 // Malhas candidatas (índices 0..n-1 do lote)
+	std::vector<const BezierCurve *> curves; // Curvas candidatas (depois das malhas no lote)
+	CullingBatch cullingBatch;						 // Volumes no mundo: malhas, depois curvas
+	std::vector<unsigned char> visible;		 // Resultado do descarte, na ordem do lote
+	ObjectCullingStats objectStats{};
+	std::vector<MeshDraw> meshDraws;			 // Malhas visíveis, na ordem dos desenhos
+	std::vector<InstanceData> instanceData; // Idem, dados por instância enviados à GPU
+	InstanceBuffer instanceBuffer;
+	std::vector<DrawElementsIndirectCommand> drawCommands; // Comandos do quadro, na ordem dos lotes
+	std::vector<DrawBatch> drawBatches;
+	IndirectBuffer indirectBuffer;
+	bool multiDraw = indirect && ext_glMultiDrawElementsIndirect != nullptr;
+	size_t drawnMeshes = 0, meshCommands = 0, meshDrawCalls = 0;
+	unsigned long long frameCount = 0;
 	while (!glfwWindowShouldClose(window))
 	{
 		// 4.1) Processa eventos de input -------------------------------
 		glfwPollEvents();
 
-		// 4.2) Limpa color buffer + depth buffer -----------------------
+		// 4.2) Carga progressiva: cena e malhas que ficaram prontas ----
+		if (!sceneLoader.done())
+		{
+			sceneLoader.setCamera(globalConfig.cameraPos); // Arquivos mais próximos primeiro
+			streamSceneFile(sceneLoader, &meshes, &meshList, &bezierCurves, &globalConfig, &geometries, &textures, &liveScene);
+			if (sceneLoader.done() && sceneLoader.hasScene())
+			{
+				std::cout << "Cena completa em "
+									<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - programStart).count()
+									<< " ms (texturas em segundo plano)\n";
+				geometries.printStats();
+				watchSceneFiles(watcher, scenePath, meshes);
+			}
+		}
+
+		// 4.3) Recarga a quente dos arquivos alterados em disco ---------
+		changedFiles.clear();
+		if (sceneLoader.done())
+			watcher.poll(changedFiles);
+		if (!changedFiles.empty())
+		{
+			reloadChangedAssets(changedFiles, &meshes, &geometries, &textures);
+			if (!sceneLoader.isBundle() &&
+					std::binary_search(changedFiles.begin(), changedFiles.end(), canonicalScenePath))
+				reloadSceneFile(scenePath, &meshes, &meshList, &bezierCurves, &globalConfig,
+																				&geometries, &textures, &liveScene);
+			for (Shader *shader : {&objectShader, &lineShader})
+				if (std::binary_search(changedFiles.begin(), changedFiles.end(), canonicalPath(shader->getVertexPath())) ||
+						std::binary_search(changedFiles.begin(), changedFiles.end(), canonicalPath(shader->getFragmentPath())))
+				{
+					bool rebuilt = shader->reload();
+					std::cout << "Shader " << shader->getFragmentPath() << (rebuilt ? " recompilado\n" : " com erro: mantido o anterior\n");
+					if (rebuilt)
+					{
+						glUseProgram(shader->getId());
+						shader->setTextureUniform(); // Blocos uniformes: religados pelo próprio reload()
+					}
+				}
+			if (!sceneLoader.isBundle())
+				watchSceneFiles(watcher, scenePath, meshes); // Arquivos novos
+		}
+
+		// 4.4) Recebe texturas decodificadas e envia a próxima fatia ---
+		if (textures.update() && !texturesReady)
+		{
+			texturesReady = true;
+			std::cout << "Texturas prontas em "
+								<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - programStart).count()
+								<< " ms\n";
+			printAssetCacheStats();
+			textures.printStats();
+		}
+
+		// 4.5) Limpa color buffer + depth buffer -----------------------
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glPointSize(10); // Tamanho para pontos das curvas
 
-		// 4.3) Atualiza a câmera de acordo com entrada WASD ------------
+		// 4.6) Atualiza a câmera de acordo com entrada WASD ------------
 		if (moveW)
 			globalConfig.cameraPos += globalConfig.cameraFront * globalConfig.cameraSpeed;
 		if (moveA)
@@ -236,26 +469,60 @@ int main()
 			globalConfig.cameraPos += glm::normalize(glm::cross(globalConfig.cameraFront, cameraUp)) * globalConfig.cameraSpeed;
 
 		view = glm::lookAt(globalConfig.cameraPos, globalConfig.cameraPos + globalConfig.cameraFront, cameraUp);
-
-		// 4.4) Renderiza malhas ----------------------------------------
+		glm::mat4 projection = glm::perspective(glm::radians(globalConfig.fov), static_cast<float>(fbWidth) / fbHeight,
+																						globalConfig.nearPlane, globalConfig.farPlane);
+		Frustum frustum = extractFrustum(projection * view);
+		++frameCount;
+
+		// Constantes do quadro: um único envio, qualquer que seja o número de programas
+		FrameUniforms frameData{};
+		frameData.view = view;
+		frameData.projection = projection;
+		frameData.cameraPos = globalConfig.cameraPos;
+		frameData.lightPos = globalConfig.lightPos;
+		frameData.lightColor = globalConfig.lightColor;
+		frameUniforms.update(&frameData, sizeof(frameData));
+		sceneMaterials.update(); // Materiais novos desde o último quadro
+
+		// 4.7) Renderiza malhas ----------------------------------------
 		glUseProgram(objectShader.getId());
-		glUniformMatrix4fv(glGetUniformLocation(objectShader.getId(), "view"), 1, GL_FALSE, glm::value_ptr(view));
-		glUniform3fv(glGetUniformLocation(objectShader.getId(), "cameraPos"), 1, glm::value_ptr(globalConfig.cameraPos));
 
 		// --- Atualização de posições de planeta e lua -----------------
-		Mesh &planeta = meshes["Planeta"];
-		BezierCurve &orbTer = bezierCurves["OrbitaTerra"];
-		planeta.position = orbTer.curvePoints[j];
+		// (qualquer um deles pode ter saído da cena em uma recarga)
+		auto planeta = meshes.find("Planeta"), lua = meshes.find("Lua");
+		auto orbTer = bezierCurves.find("OrbitaTerra"), orbLua = bezierCurves.find("OrbitaLua");
+		if (planeta != meshes.end() && orbTer != bezierCurves.end() && !orbTer->second.curvePoints.empty())
+		{
+			j %= orbTer->second.curvePoints.size(); // A curva pode ter encolhido
+			planeta->second.position = orbTer->second.curvePoints[j];
 
-		Mesh &lua = meshes["Lua"];
-		BezierCurve &orbLua = bezierCurves["OrbitaLua"];
-		lua.position = orbLua.curvePoints[i] + planeta.position; // órbita relativa
+			if (lua != meshes.end() && orbLua != bezierCurves.end() && !orbLua->second.curvePoints.empty())
+			{
+				i %= orbLua->second.curvePoints.size();
+				lua->second.position = orbLua->second.curvePoints[i] + planeta->second.position; // órbita relativa
+			}
+		}
 
-		// --- Desenha todas as malhas ----------------------------------
+		// --- Matrizes de todas as malhas; a BVH só muda para as que se moveram
+		// (ou trocaram de geometria). As curvas entram nela ao serem criadas
+		const std::string *selectedName = (currentlySelectedMesh != NO_SELECTION && !meshList.empty())
+																					? &meshList.at(currentlySelectedMesh % meshList.size())
+																					: nullptr;
+		size_t sceneObjects = showCurves ? bezierCurves.size() : 0;
 		for (auto &pair : meshes)
 		{
 			Mesh &mesh = pair.second;
-			bool isSelected = (currentlySelectedMesh != -1) && (meshList.at(currentlySelectedMesh % meshList.size()) == pair.first);
+			if (mesh.geometry == INVALID_GEOMETRY)
+			{
+				if (mesh.proxy != BVH_NULL_NODE) // Geometria perdida em uma recarga
+				{
+					sceneBvh.destroyProxy(mesh.proxy);
+					mesh.proxy = BVH_NULL_NODE;
+				}
+				continue; // Ainda carregando (ou .obj inválido): nada a desenhar
+			}
+			bool isSelected = selectedName && *selectedName == pair.first;
+			++sceneObjects;
 
 			// Matriz Model de cada malha -----------------------------
 			glm::mat4 model(1.0f);
@@ -274,456 +541,803 @@ int main()
 			glm::vec3 scl = mesh.scale * (isSelected ? selectedMeshScale : 1.0f);
 			model = glm::scale(model, scl);
 
-			// Envia a matriz Model p/ o shader -----------------------
-			glUniformMatrix4fv(glGetUniformLocation(objectShader.getId(), "model"), 1, GL_FALSE, glm::value_ptr(model));
-
-			// Material ----------------------------------------------
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kaR"), mesh.material.kaR);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kaG"), mesh.material.kaG);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kaB"), mesh.material.kaB);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kdR"), mesh.material.kdR);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kdG"), mesh.material.kdG);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "kdB"), mesh.material.kdB);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "ksR"), mesh.material.ksR);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "ksG"), mesh.material.ksG);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "ksB"), mesh.material.ksB);
-			glUniform1f(glGetUniformLocation(objectShader.getId(), "ns"), mesh.material.ns);
-
-			// Cor extra ao selecionar --------------------------------
-			if (isSelected)
-				glUniform3f(glGetUniformLocation(objectShader.getId(), "extraColor"), 0.3f, 0.5f, 0.9f);
+			// Caixa no mundo: a folha só é reinserida se sair da caixa gorda
+			if (mesh.proxy == BVH_NULL_NODE || model != mesh.model)
+			{
+				mesh.model = model;
+				mesh.modelScale = scl;
+				glm::vec3 boxMin = glm::make_vec3(mesh.bounds.offset);
+				Aabb box = transformAabb(boxMin, boxMin + glm::make_vec3(mesh.bounds.scale), model);
+				if (mesh.proxy == BVH_NULL_NODE)
+					mesh.proxy = sceneBvh.createProxy(box, &mesh, BVH_MESH);
+				else
+					sceneBvh.moveProxy(mesh.proxy, box);
+			}
+		}
+
+		// --- Seleção pelo centro da tela (tecla P) ---------------------
+		if (pickRequested)
+		{
+			pickRequested = false;
+			const Mesh *picked = pickMesh(globalConfig.cameraPos, globalConfig.cameraFront, globalConfig.farPlane);
+			auto index = picked ? std::find(meshList.begin(), meshList.end(), picked->name) : meshList.end();
+			if (index != meshList.end())
+			{
+				currentlySelectedMesh = static_cast<GLuint>(index - meshList.begin());
+				selectedMeshScale = 1.0f;
+				selectedMeshAngle = 0.0f;
+				selectedMeshPosition = {0.0f, 0.0f};
+				std::cout << "Selecionado: " << picked->name << '\n';
+			}
+			else
+				std::cout << "Nenhuma malha no centro da tela\n";
+		}
+
+		// --- Descarte pela pirâmide de visão: a BVH entrega as candidatas
+		// (caixas gordas), o lote SSE testa as caixas e esferas justas delas
+		instances.clear();
+		curves.clear();
+		auto collect = [&](int proxy)
+		{
+			if (sceneBvh.category(proxy) == BVH_MESH)
+			{
+				Mesh *mesh = static_cast<Mesh *>(sceneBvh.userData(proxy));
+				instances.push_back(MeshInstance{mesh, mesh->model, mesh->modelScale,
+																				 selectedName && *selectedName == mesh->name, mesh->name == "Sol"});
+			}
 			else
-				glUniform3f(glGetUniformLocation(objectShader.getId(), "extraColor"), 0.0f, 0.0f, 0.0f);
+				curves.push_back(static_cast<const BezierCurve *>(sceneBvh.userData(proxy)));
+			return true;
+		};
+		unsigned int categories = showCurves ? BVH_ALL : BVH_MESH;
+		if (frustumCulling)
+			sceneBvh.queryFrustum(frustum, categories, collect);
+		else
+			sceneBvh.queryAabb(Aabb{glm::vec3(-std::numeric_limits<float>::infinity()),
+															glm::vec3(std::numeric_limits<float>::infinity())},
+												 categories, collect);
+
+		cullingBatch.clear();
+		for (const MeshInstance &instance : instances)
+			cullingBatch.add(instance.mesh->bounds, instance.mesh->sphere, instance.model);
+		for (const BezierCurve *curve : curves)
+			cullingBatch.add(curve->boundsMin, curve->boundsMax);
+		if (frustumCulling)
+			cullingBatch.cull(frustum, visible);
+		else
+			visible.assign(cullingBatch.size(), 1);
+		objectStats.objects += sceneObjects;
+		objectStats.candidates += visible.size();
+		objectStats.culled += sceneObjects - std::count(visible.begin(), visible.end(), 1);
+
+		// --- Malhas visíveis: nível de detalhe e chave do agrupamento ---
+		meshDraws.clear();
+		for (size_t m = 0; m < instances.size(); ++m)
+		{
+			if (!visible[m])
+				continue;
+			Mesh &mesh = *instances[m].mesh;
+			if (useLods)
+				mesh.lod = selectLod(mesh.lods, mesh.lodCount,
+														 projectedRadius(mesh.bounds, instances[m].model, instances[m].scale, fbHeight), mesh.lod);
+			bool clusters = clusterCulling && mesh.lods[mesh.lod].meshletCount > 0;
+			meshDraws.push_back(MeshDraw{mesh.texture, mesh.indexType, mesh.geometry, mesh.lod, clusters,
+																	 static_cast<unsigned int>(m)});
+		}
+		std::sort(meshDraws.begin(), meshDraws.end(), [](const MeshDraw &a, const MeshDraw &b)
+							{ return std::tie(a.texture, a.indexType, a.geometry, a.lod, a.clusters, a.instance) <
+											 std::tie(b.texture, b.indexType, b.geometry, b.lod, b.clusters, b.instance); });
+
+		// Matriz Model, cor de seleção, material, iluminação e caixa da geometria de cada
+		// uma, na mesma ordem: o baseInstance de cada comando aponta para a sua primeira
+		instanceData.clear();
+		for (const MeshDraw &draw : meshDraws)
+		{
+			const MeshInstance &instance = instances[draw.instance];
+			const VertexBounds &bounds = instance.mesh->bounds;
+			instanceData.push_back(InstanceData{instance.model,
+																					instance.isSelected ? glm::vec3(0.3f, 0.5f, 0.9f) : glm::vec3(0.0f),
+																					static_cast<GLint>(instance.mesh->materialId), instance.skipLighting,
+																					glm::make_vec3(bounds.offset), glm::make_vec3(bounds.scale)});
+		}
+		instanceBuffer.upload(instanceData);
+
+		// --- Comandos: um por grupo com a mesma geometria e LOD (as malhas
+		// com meshlets têm um por trecho visível, pois o descarte dos clusters
+		// depende da matriz Model de cada uma) ------------------------------
+		drawCommands.clear();
+		drawBatches.clear();
+		for (size_t first = 0, last; first < meshDraws.size(); first = last)
+		{
+			const MeshDraw &draw = meshDraws[first];
+			for (last = first + 1; instancing && !draw.clusters && last < meshDraws.size(); ++last)
+			{
+				const MeshDraw &next = meshDraws[last];
+				if (next.texture != draw.texture || next.geometry != draw.geometry || next.lod != draw.lod || next.clusters)
+					break;
+			}
+			if (drawBatches.empty() || drawBatches.back().texture != draw.texture ||
+					drawBatches.back().indexType != draw.indexType)
+				drawBatches.push_back(DrawBatch{draw.texture, draw.indexType, drawCommands.size(), 0});
 
-			// Opcional: pular iluminação para o Sol ------------------
-			glUniform1i(glGetUniformLocation(objectShader.getId(), "skipLighting"), pair.first == "Sol");
+			const SharedGeometry &geometry = geometries.get(draw.geometry);
+			const MeshLod &lod = geometry.lods[draw.lod];
+			if (draw.clusters)
+			{
+				// Só os meshlets visíveis: câmera levada ao espaço do objeto p/ o teste do cone
+				// (que não vale com espelhamento: a ordem dos vértices se inverte)
+				const glm::mat4 &model = instances[draw.instance].model;
+				const glm::vec3 &scl = instances[draw.instance].scale;
+				glm::vec3 cameraObject = glm::vec3(glm::inverse(model) * glm::vec4(globalConfig.cameraPos, 1.0f));
+				float maxScale = std::max(std::fabs(scl.x), std::max(std::fabs(scl.y), std::fabs(scl.z)));
+				cullMeshlets(&geometry.meshlets[lod.meshletOffset], lod.meshletCount, frustum, model, maxScale, cameraObject,
+										 glm::determinant(glm::mat3(model)) > 0.0f, drawCounts, drawFirsts, cullingStats);
+				for (size_t r = 0; r < drawCounts.size(); ++r)
+					drawCommands.push_back(DrawElementsIndirectCommand{static_cast<GLuint>(drawCounts[r]), 1,
+																														 geometry.firstIndex + drawFirsts[r], geometry.baseVertex,
+																														 static_cast<GLuint>(first)});
+			}
+			else
+				drawCommands.push_back(DrawElementsIndirectCommand{lod.indexCount, static_cast<GLuint>(last - first),
+																													 geometry.firstIndex + lod.indexOffset, geometry.baseVertex,
+																													 static_cast<GLuint>(first)});
+			drawBatches.back().commandCount = drawCommands.size() - drawBatches.back().firstCommand;
+		}
+		drawnMeshes += meshDraws.size();
+		meshCommands += drawCommands.size();
 
-			// Desenho -----------------------------------------------
-			glBindVertexArray(mesh.VAO);
+		// --- Submissão: um VAO para todas as geometrias; por lote, só a
+		// textura e o index buffer mudam --------------------------------------
+		if (!drawCommands.empty())
+		{
+			glBindVertexArray(geometries.getVertexArray());
+			instanceBuffer.enable(0);
 			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, mesh.textureID);
-			glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mesh.vertices.size()));
+			if (multiDraw)
+				indirectBuffer.upload(drawCommands);
+			for (const DrawBatch &batch : drawBatches)
+			{
+				glBindTexture(GL_TEXTURE_2D, textures.texture(batch.texture));
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometries.getIndexBuffer(batch.indexType));
+				if (multiDraw)
+				{
+					ext_glMultiDrawElementsIndirect(GL_TRIANGLES, batch.indexType,
+																					reinterpret_cast<const void *>(batch.firstCommand * sizeof(DrawElementsIndirectCommand)),
+																					static_cast<GLsizei>(batch.commandCount), 0);
+					++meshDrawCalls;
+					continue;
+				}
+				const size_t indexSize = (batch.indexType == GL_UNSIGNED_SHORT) ? 2 : 4;
+				for (size_t c = batch.firstCommand; c < batch.firstCommand + batch.commandCount; ++c)
+				{
+					const DrawElementsIndirectCommand &command = drawCommands[c];
+					instanceBuffer.enable(command.baseInstance);
+					glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.count), batch.indexType,
+																						reinterpret_cast<const void *>(command.firstIndex * indexSize),
+																						static_cast<GLsizei>(command.instanceCount), command.baseVertex);
+					++meshDrawCalls;
+				}
+			}
 			glBindVertexArray(0);
+			if (multiDraw)
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 		}
 
-		// 4.5) Renderiza curvas de Bézier -----------------------------
+		// 4.8) Renderiza curvas de Bézier -----------------------------
 		if (showCurves)
 		{
 			glUseProgram(lineShader.getId());
-			glUniformMatrix4fv(glGetUniformLocation(lineShader.getId(), "view"), 1, GL_FALSE, glm::value_ptr(view));
 
-			for (const auto &pair : bezierCurves)
+			size_t c = instances.size(); // Curvas vêm depois das malhas no lote
+			for (const BezierCurve *curve : curves)
 			{
-				const BezierCurve &bc = pair.second;
+				const BezierCurve &bc = *curve;
+				if (!visible[c++])
+					continue;
 
 				// ----- Curva em linha contínua --------------------
-				glUniform4fv(glGetUniformLocation(lineShader.getId(), "finalColor"), 1, glm::value_ptr(bc.color));
+				lineShader.set(lineUniforms.finalColor, bc.color);
 				glBindVertexArray(bc.VAO);
 				glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(bc.curvePoints.size()));
 				glBindVertexArray(0);
 
 				// ----- Pontos de controle -------------------------
-				glUniform4f(glGetUniformLocation(lineShader.getId(), "finalColor"), 1.0f, 1.0f, 0.0f, 1.0f);
+				lineShader.set(lineUniforms.finalColor, glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
 				glBindVertexArray(bc.controlPointsVAO);
 				glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(bc.controlPoints.size()));
 				glBindVertexArray(0);
 
 				// ----- Linhas dos pontos de controle -------------
-				glUniform4f(glGetUniformLocation(lineShader.getId(), "finalColor"), 0.0f, 1.0f, 0.0f, 1.0f);
+				lineShader.set(lineUniforms.finalColor, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
 				glBindVertexArray(bc.controlPointsVAO);
 				glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(bc.controlPoints.size()));
 				glBindVertexArray(0);
 			}
 		}
 
-		// 4.6) Atualiza variáveis de animação -------------------------
-		i = (i + 36) % bezierCurves["OrbitaLua"].curvePoints.size();
-		j = (j + 5) % bezierCurves["OrbitaTerra"].curvePoints.size();
+		// 4.9) Atualiza variáveis de animação -------------------------
+		if (orbLua != bezierCurves.end() && !orbLua->second.curvePoints.empty())
+			i = (i + 36) % orbLua->second.curvePoints.size();
+		if (orbTer != bezierCurves.end() && !orbTer->second.curvePoints.empty())
+			j = (j + 5) % orbTer->second.curvePoints.size();
 
 		incrementalAngle = fmod(incrementalAngle + 0.1f, 360.0f);
 
-		// 4.7) Troca os buffers (double buffering) -------------------
+		// 4.10) Troca os buffers (double buffering) -------------------
 		glfwSwapBuffers(window);
+
+		if (firstFrame)
+		{
+			firstFrame = false;
+			std::cout << "Primeiro quadro em "
+								<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - programStart).count()
+								<< " ms\n";
+		}
 	}
 
+	// Descarte por objeto e por cluster: média por quadro ----------------
+	if (objectStats.objects > 0)
+		std::cout << "Objetos por quadro: " << objectStats.objects / frameCount << " na cena, "
+							<< objectStats.candidates / frameCount << " entregue(s) pela BVH, "
+							<< objectStats.culled / frameCount << " fora da tela\n";
+	if (drawnMeshes > 0)
+		std::cout << "Malhas por quadro: " << drawnMeshes / frameCount << " desenhada(s) em "
+							<< meshCommands / frameCount << " comando(s) e " << meshDrawCalls / frameCount
+							<< (multiDraw ? " glMultiDrawElementsIndirect\n" : " chamada(s) de desenho\n");
+	if (cullingStats.meshlets > 0)
+		std::cout << "Meshlets por quadro: " << cullingStats.meshlets / frameCount << " testado(s), "
+							<< cullingStats.frustumCulled / frameCount << " fora da tela, "
+							<< cullingStats.backfaceCulled / frameCount << " de costas, "
+							<< cullingStats.draws / frameCount << " trecho(s) desenhado(s)\n";
+
 	// --------------------------------------------------------------------
 	// 5) Liberação de recursos
 	// --------------------------------------------------------------------
 	for (const auto &pair : meshes)
-		glDeleteVertexArrays(1, &pair.second.VAO);
+	{
+		geometries.release(pair.second.geometry);
+		textures.release(pair.second.texture);
+		sceneMaterials.release(pair.second.materialId);
+	}
 	for (const auto &pair : bezierCurves)
-		glDeleteVertexArrays(1, &pair.second.VAO);
+	{
+		deleteControlPointsBuffer(pair.second.VAO);
+		deleteControlPointsBuffer(pair.second.controlPointsVAO);
+	}
+	textures.clear(); // Ainda com o contexto OpenGL ativo
+	frameUniforms.release();
+	sceneMaterials.clear();
+	instanceBuffer.release();
+	indirectBuffer.release();
+	geometries.clear();
 
 	glfwTerminate(); // Encerra GLFW e libera memória alocada internamente
 	return 0;
 }
 
+/* Aponta a malha para a geometria registrada (cópia dos LODs e da caixa) */
+static void setMeshGeometry(Mesh &mesh, GeometryId geometryId, GeometryRegistry *geometries)
+{
+	mesh.geometry = geometryId;
+	if (geometryId != INVALID_GEOMETRY)
+	{
+		const SharedGeometry &geometry = geometries->get(geometryId);
+		mesh.lodCount = geometry.lodCount;
+		std::memcpy(mesh.lods, geometry.lods, sizeof(mesh.lods));
+		mesh.indexType = geometry.indexType;
+		mesh.bounds = geometry.bounds;
+		mesh.sphere = geometry.sphere;
+		mesh.model = glm::mat4(0.0f); // Caixa nova: a folha na BVH é refeita no próximo quadro
+	}
+	else
+	{
+		mesh.lodCount = 0;
+		mesh.indexType = GL_UNSIGNED_SHORT;
+		mesh.bounds = VertexBounds{};
+		mesh.sphere = BoundingSphere{};
+	}
+	mesh.lod = 0;
+}
+
+/* Raio, em pixels, da esfera que circunscreve a caixa da malha vista da câmera atual
+   (infinito com a câmera dentro dela). É a mesma esfera de meshRadius(), à qual os erros
+   dos LODs são relativos. scale é a escala usada em model */
+float projectedRadius(const VertexBounds &bounds, const glm::mat4 &model, const glm::vec3 &scale, int fbHeight)
+{
+	glm::vec3 halfSize = 0.5f * glm::vec3(bounds.scale[0], bounds.scale[1], bounds.scale[2]);
+	glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(bounds.offset[0], bounds.offset[1], bounds.offset[2]) + halfSize, 1.0f));
+	float radius = glm::length(halfSize) * std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+	float distance = glm::length(center - globalConfig.cameraPos);
+	if (distance <= radius)
+		return std::numeric_limits<float>::max();
+	return radius / (distance * std::tan(glm::radians(globalConfig.fov) * 0.5f)) * fbHeight * 0.5f;
+}
+
+/* Malha cuja caixa o raio atinge primeiro. A BVH entrega as folhas cujas caixas gordas o raio
+   cruza, as mais próximas antes; cada uma é testada com o raio no espaço do objeto (t é o
+   mesmo nos dois espaços) e o acerto encurta o raio para as seguintes */
+Mesh *pickMesh(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance)
+{
+	Mesh *picked = nullptr;
+	sceneBvh.rayCast(origin, direction, maxDistance, BVH_MESH, [&](int proxy, float limit)
+									 {
+		Mesh &mesh = *static_cast<Mesh *>(sceneBvh.userData(proxy));
+		glm::mat4 inverse = glm::inverse(mesh.model);
+		glm::vec3 localOrigin = glm::vec3(inverse * glm::vec4(origin, 1.0f));
+		glm::vec3 localDirection = glm::vec3(inverse * glm::vec4(direction, 0.0f));
+		glm::vec3 boxMin = glm::make_vec3(mesh.bounds.offset);
+		float distance;
+		if (!rayHitsAabb(Aabb{boxMin, boxMin + glm::make_vec3(mesh.bounds.scale)}, localOrigin, 1.0f / localDirection,
+										 limit, &distance))
+			return -1.0f;
+		picked = &mesh;
+		return distance; }); // 0 (câmera dentro da caixa) encerra a busca
+	return picked;
+}
+
+/* Copia a transformação inicial da descrição */
+static void setMeshTransform(Mesh &mesh, const SceneMeshDesc &desc)
+{
+	mesh.position = desc.position;
+	mesh.rotation = desc.rotation;
+	mesh.scale = desc.scale;
+	mesh.angle = desc.angle;
+	mesh.incrementalAngle = desc.incrementalAngle;
+}
+
+/* Troca o material da malha e o seu slot na tabela (o novo antes de liberar o antigo: pode ser o mesmo) */
+static void setMeshMaterial(Mesh &mesh, const Material &material)
+{
+	MaterialId materialId = sceneMaterials.acquire(material);
+	sceneMaterials.release(mesh.materialId);
+	mesh.material = material;
+	mesh.materialId = materialId;
+}
+
 /*****************************************************************************************
- *  readSceneFile()
+ *  addSceneMesh()
  *  --------------------------------------------------------------------------------------
- *  Lê um arquivo de cena (.txt ou similar) e, para cada bloco de entidade descrito,
- *  popula as estruturas de configuração global, malhas (Mesh) e curvas de Bézier
- *  utilizadas na aplicação.
- *
- *  Passo a passo geral:
- *    1. Abre o arquivo indicado por sceneFilePath e verifica sucesso.
- *    2. Percorre cada linha do arquivo, identificando o tipo de informação (Type,
- *       LightPos, Obj, ControlPoint, End, etc.).
- *    3. Conforme o tipo, acumula dados temporariamente nas variáveis correspondentes.
- *    4. Quando encontra "End", instancia o objeto adequado (GlobalConfig, Mesh ou
- *       BezierCurve) com os dados coletados e o armazena nas coleções recebidas via
- *       ponteiro.
- *    5. Ao final, fecha o arquivo e retorna.
+ *  Monta a Mesh a partir da descrição, da geometria e da textura já registradas, e a
+ *  adiciona aos contêineres globais (comum ao Scene.txt e ao pacote binário).
  *****************************************************************************************/
-void readSceneFile(std::string sceneFilePath,
-									 std::unordered_map<std::string, Mesh> *meshes,
-									 std::vector<std::string> *meshList,
-									 std::unordered_map<std::string, BezierCurve> *bezierCurves,
-									 GlobalConfig *globalConfig)
+static void addSceneMesh(const SceneMeshDesc &desc, GeometryId geometryId, const Material &material,
+												 TextureId textureId, GeometryRegistry *geometries,
+												 std::unordered_map<std::string, Mesh> *meshes, std::vector<std::string> *meshList)
 {
-	std::ifstream file(sceneFilePath);
-	std::string line;
+	Mesh mesh;
+	mesh.name = desc.name;
+	mesh.objFilePath = desc.objFilePath;
+	mesh.mtlFilePath = desc.mtlFilePath;
+	setMeshGeometry(mesh, geometryId, geometries);
+	mesh.materialId = INVALID_MATERIAL;
+	setMeshMaterial(mesh, material);
+	mesh.texture = textureId;
+	setMeshTransform(mesh, desc);
+	mesh.proxy = BVH_NULL_NODE; // Entra na BVH no primeiro quadro com geometria
+
+	meshes->insert(std::make_pair(desc.name, mesh));
+	meshList->push_back(desc.name);
+}
 
-	if (!file.is_open())
+/*****************************************************************************************
+ *  addSceneCurve()
+ *  --------------------------------------------------------------------------------------
+ *  Cria os VAOs da curva (pontos discretizados e pontos de controle) e a adiciona ao
+ *  contêiner global.
+ *****************************************************************************************/
+static void addSceneCurve(const SceneCurveDesc &desc, const std::vector<glm::vec3> &controlPoints,
+													const std::vector<glm::vec3> &curvePoints,
+													std::unordered_map<std::string, BezierCurve> *bezierCurves)
+{
+	if (bezierCurves->count(desc.name)) // Nome repetido: antes de criar os VAOs
 	{
-		std::cerr << "Falha ao abrir o arquivo " << sceneFilePath << std::endl;
+		std::cerr << "Curva duplicada: " << desc.name << " (ignorada)" << std::endl;
 		return;
 	}
 
-	/* ------------------------------ Variáveis temporárias ------------------------------ */
-	std::string objectType; // Armazena o tipo atual (GlobalConfig, Mesh, BezierCurve)
-	std::string name;				// Nome do objeto corrente (identificador único)
-
-	// --- Atributos da configuração global ---
-	glm::vec3 lightPos{}, lightColor{};
-	glm::vec3 cameraPos{}, cameraFront{};
-	GLfloat fov{}, nearPlane{}, farPlane{}, sensitivity{}, cameraSpeed{};
-
-	// --- Atributos de Mesh ---
-	std::string objFilePath, mtlFilePath;
-	glm::vec3 scale{1.0f}, position{0.0f}, rotation{0.0f}, angle{0.0f};
-	GLuint incrementalAngle = false;
-
-	// --- Atributos de Bézier ---
-	std::vector<glm::vec3> tempControlPoints;
-	GLuint pointsPerSegment = 0;
-	glm::vec4 color{1.0f};
-	glm::vec3 orbit{0.0f};
-	GLfloat radius = 1.0f;
-	GLuint usingOrbit = false;
-
-	/* ------------------------------- Loop de leitura ---------------------------------- */
-	while (getline(file, line))
-	{
-		std::istringstream ss(line);
-		std::string type; // Primeiro token da linha define a “tag”
-		ss >> type;
-
-		/* ---------- Identificação de cada campo válido ---------- */
-		if (type == "Type")
-			ss >> objectType >> name;
-
-		/* ---- Campos da GlobalConfig ---- */
-		else if (type == "LightPos" && objectType == "GlobalConfig")
-			ss >> lightPos.x >> lightPos.y >> lightPos.z;
-		else if (type == "LightColor" && objectType == "GlobalConfig")
-			ss >> lightColor.r >> lightColor.g >> lightColor.b;
-		else if (type == "CameraPos" && objectType == "GlobalConfig")
-			ss >> cameraPos.x >> cameraPos.y >> cameraPos.z;
-		else if (type == "CameraFront" && objectType == "GlobalConfig")
-			ss >> cameraFront.x >> cameraFront.y >> cameraFront.z;
-		else if (type == "Fov" && objectType == "GlobalConfig")
-			ss >> fov;
-		else if (type == "NearPlane" && objectType == "GlobalConfig")
-			ss >> nearPlane;
-		else if (type == "FarPlane" && objectType == "GlobalConfig")
-			ss >> farPlane;
-		else if (type == "Sensitivity" && objectType == "GlobalConfig")
-			ss >> sensitivity;
-		else if (type == "CameraSpeed" && objectType == "GlobalConfig")
-			ss >> cameraSpeed;
-
-		/* ---- Campos de Mesh ---- */
-		else if (type == "Obj" && objectType == "Mesh")
-			ss >> objFilePath;
-		else if (type == "Mtl" && objectType == "Mesh")
-			ss >> mtlFilePath;
-		else if (type == "Scale" && objectType == "Mesh")
-			ss >> scale.x >> scale.y >> scale.z;
-		else if (type == "Position" && objectType == "Mesh")
-			ss >> position.x >> position.y >> position.z;
-		else if (type == "Rotation" && objectType == "Mesh")
-			ss >> rotation.x >> rotation.y >> rotation.z;
-		else if (type == "Angle" && objectType == "Mesh")
-			ss >> angle.x >> angle.y >> angle.z;
-		else if (type == "IncrementalAngle" && objectType == "Mesh")
-			ss >> incrementalAngle;
-
-		/* ---- Campos da BezierCurve ---- */
-		else if (type == "ControlPoint" && objectType == "BezierCurve")
+	BezierCurve bezierCurve;
+	bezierCurve.curvePoints = curvePoints;
+	bezierCurve.VAO = generateControlPointsBuffer(curvePoints);
+	GLuint controlVAO = generateControlPointsBuffer(controlPoints);
+
+	bezierCurve.name = desc.name;
+	bezierCurve.controlPoints = controlPoints;
+	bezierCurve.boundsMin = bezierCurve.boundsMax = !curvePoints.empty()		 ? curvePoints[0]
+																									: !controlPoints.empty() ? controlPoints[0]
+																																					 : glm::vec3(0.0f);
+	for (const std::vector<glm::vec3> *points : {&curvePoints, &controlPoints})
+		for (const glm::vec3 &point : *points)
 		{
-			glm::vec3 cp;
-			ss >> cp.x >> cp.y >> cp.z;
-			tempControlPoints.push_back(cp);
-			usingOrbit = false; // Se definir pontos manualmente, desativa órbita
+			bezierCurve.boundsMin = glm::min(bezierCurve.boundsMin, point);
+			bezierCurve.boundsMax = glm::max(bezierCurve.boundsMax, point);
 		}
-		else if (type == "PointsPerSegment" && objectType == "BezierCurve")
-			ss >> pointsPerSegment;
-		else if (type == "Color" && objectType == "BezierCurve")
-			ss >> color.r >> color.g >> color.b >> color.a;
-		else if (type == "Orbit" && objectType == "BezierCurve")
+	bezierCurve.color = desc.color;
+	bezierCurve.pointsPerSegment = desc.pointsPerSegment;
+	if (desc.usingOrbit)
+	{
+		bezierCurve.orbit = desc.orbit;
+		bezierCurve.radius = desc.radius;
+	}
+	bezierCurve.controlPointsVAO = controlVAO;
+
+	/* Curvas não se movem: a folha é criada uma vez, com a caixa final */
+	BezierCurve &inserted = bezierCurves->emplace(desc.name, bezierCurve).first->second;
+	inserted.proxy = sceneBvh.createProxy(Aabb{bezierCurve.boundsMin, bezierCurve.boundsMax}, &inserted, BVH_CURVE);
+}
+
+/* Copia a configuração global lida da cena */
+static void applyGlobalConfig(const SceneGlobalDesc &config, GlobalConfig *globalConfig)
+{
+	globalConfig->lightPos = config.lightPos;
+	globalConfig->lightColor = config.lightColor;
+	globalConfig->cameraPos = config.cameraPos;
+	globalConfig->cameraFront = config.cameraFront;
+	globalConfig->nearPlane = config.nearPlane;
+	globalConfig->farPlane = config.farPlane;
+	globalConfig->fov = config.fov;
+	globalConfig->sensitivity = config.sensitivity;
+	globalConfig->cameraSpeed = config.cameraSpeed;
+}
+
+/*****************************************************************************************
+ *  readSceneBundle()
+ *  --------------------------------------------------------------------------------------
+ *  Carrega um pacote gerado por --compile-scene: nada é interpretado, decodificado ou
+ *  discretizado; geometrias e texturas vão do mapeamento direto para os registros.
+ *****************************************************************************************/
+void readSceneBundle(const std::string &bundlePath,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures)
+{
+	SceneBundle bundle;
+	if (!bundle.open(bundlePath))
+		return;
+
+	if (bundle.hasGlobalConfig())
+		applyGlobalConfig(bundle.globalConfig(), globalConfig);
+
+	for (unsigned int m = 0; m < bundle.meshCount(); ++m)
+	{
+		/* Nome repetido: descartado antes de adquirir geometria e textura (o Scene.txt já os rejeita) */
+		SceneMeshDesc desc = bundle.meshDesc(m);
+		if (meshes->count(desc.name))
 		{
-			ss >> orbit.x >> orbit.y >> orbit.z;
-			usingOrbit = true; // Ativa modo de órbita (círculo automático)
+			std::cerr << "Malha duplicada no pacote: " << desc.name << " (ignorada)" << std::endl;
+			continue;
 		}
-		else if (type == "Radius" && objectType == "BezierCurve")
-			ss >> radius;
 
-		/* ---------- Fim de um bloco (“End”) ---------- */
-		else if (type == "End")
-		{
-			/* ---- Finaliza e armazena uma GlobalConfig ---- */
-			if (objectType == "GlobalConfig")
-			{
-				globalConfig->lightPos = lightPos;
-				globalConfig->lightColor = lightColor;
-				globalConfig->cameraPos = cameraPos;
-				globalConfig->cameraFront = cameraFront;
-				globalConfig->nearPlane = nearPlane;
-				globalConfig->farPlane = farPlane;
-				globalConfig->fov = fov;
-				globalConfig->sensitivity = sensitivity;
-				globalConfig->cameraSpeed = cameraSpeed;
-			}
-			/* ---- Finaliza e armazena uma Mesh ---- */
-			else if (objectType == "Mesh")
-			{
-				Mesh mesh;
-
-				/* 1. Carrega vértices do OBJ para CPU */
-				std::vector<Vertex> vertices = setupObj(objFilePath);
-
-				/* 2. Envia geometria para GPU, obtém VAO */
-				GLuint VAO = setupGeometry(vertices);
-
-				/* 3. Lê material (.mtl) e textura correspondente */
-				Material material = setupMtl(mtlFilePath);
-				GLuint textureID = setupTexture(material.textureName);
-
-				/* 4. Preenche estrutura Mesh */
-				mesh.name = name;
-				mesh.vertices = vertices;
-				mesh.VAO = VAO;
-				mesh.material = material;
-				mesh.textureID = textureID;
-				mesh.position = position;
-				mesh.rotation = rotation;
-				mesh.scale = scale;
-				mesh.angle = angle;
-				mesh.incrementalAngle = incrementalAngle;
-
-				/* 5. Adiciona aos contêineres globais */
-				meshes->insert(std::make_pair(name, mesh));
-				meshList->push_back(name);
-			}
-			/* ---- Finaliza e armazena uma BezierCurve ---- */
-			else if (objectType == "BezierCurve")
-			{
-				/* Se for curva orbital, gera pontos de controle automaticamente */
-				std::vector<glm::vec3> controlPoints = usingOrbit
-																									 ? generateCircleControlPoints(orbit, radius)
-																									 : tempControlPoints;
-
-				/* Cria curva, gera seu VAO, e preenche estrutura */
-				BezierCurve bezierCurve = createBezierCurve(controlPoints, pointsPerSegment);
-				GLuint controlVAO = generateControlPointsBuffer(controlPoints);
-
-				bezierCurve.name = name;
-				bezierCurve.controlPoints = controlPoints;
-				bezierCurve.color = color;
-				bezierCurve.pointsPerSegment = pointsPerSegment;
-				if (usingOrbit)
-				{
-					bezierCurve.orbit = orbit;
-					bezierCurve.radius = radius;
-				}
-				bezierCurve.controlPointsVAO = controlVAO;
+		std::string path;
+		unsigned long long sourceHash, pixelHash;
 
-				bezierCurves->insert(std::make_pair(name, bezierCurve));
-				tempControlPoints.clear(); // Limpa para o próximo bloco
-			}
+		GeometryView geometryView;
+		GeometryId geometryId = INVALID_GEOMETRY;
+		if (bundle.meshGeometry(m, path, sourceHash, geometryView))
+			geometryId = geometries->acquire(path, sourceHash, geometryView);
+
+		/* Texturas em BC1/BC3 só se o contexto aceitar; senão a malha fica sem textura */
+		TextureView textureView;
+		TextureId textureId = INVALID_TEXTURE;
+		if (bundle.meshTexture(m, path, sourceHash, pixelHash, textureView))
+		{
+			if (textureView.format == TextureFormat::Raw || hasGLExtension("GL_EXT_texture_compression_s3tc"))
+				textureId = textures->acquire(path, sourceHash, pixelHash, textureView, bundle.data());
+			else
+				std::cerr << "Textura comprimida sem suporte a S3TC: " << path << std::endl;
 		}
+
+		addSceneMesh(desc, geometryId, bundle.meshMaterial(m), textureId, geometries, meshes, meshList);
 	}
 
-	file.close();
+	for (unsigned int c = 0; c < bundle.curveCount(); ++c)
+	{
+		SceneCurveDesc desc = bundle.curveDesc(c);
+		addSceneCurve(desc, desc.controlPoints, bundle.curvePoints(c), bezierCurves);
+	}
 }
 
 /*****************************************************************************************
- *  setupObj()
+ *  streamSceneFile()
  *  --------------------------------------------------------------------------------------
- *  Carrega um arquivo .obj simples (v / vt / vn / f) e devolve um vetor de Vertex pronto
- *  para envio à GPU.
- *  Passo a passo:
- *    1. Abre o arquivo e percorre linha por linha.
- *    2. Armazena posições (v), coordenadas de textura (vt) e normais (vn) em vetores
- *       temporários.
- *    3. Para cada face (f), converte índices v/vt/vn em instâncias de Vertex, preenchendo
- *       posição, texcoord e normal.
+ *  Um passo da carga progressiva do Scene.txt, chamado a cada quadro até o SceneLoader
+ *  terminar. Nunca espera: usa só o que as threads de trabalho já entregaram.
+ *
+ *  Passo a passo geral:
+ *    1. Quando a cena interpretada chega: copia o último bloco GlobalConfig e cria todas
+ *       as malhas (ainda sem geometria, então não são desenhadas) e todas as curvas.
+ *    2. A cada quadro: as malhas cujo .obj e .mtl já chegaram recebem geometria, material
+ *       e textura e passam a ser desenhadas.
+ *  Devolve true no quadro em que a cena chegou (câmera e luz vão aos shaders pelo bloco
+ *  FrameUniforms, reescrito a cada quadro).
  *****************************************************************************************/
-std::vector<Vertex> setupObj(std::string path)
+bool streamSceneFile(SceneLoader &loader,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures,
+										 SceneDescription *liveScene)
 {
-	std::vector<Vertex> vertices;
-	std::ifstream file(path);
-	std::string line;
-
-	/* Vetores temporários para dados crus do .obj */
-	std::vector<glm::vec3> temp_positions;
-	std::vector<glm::vec2> temp_texcoords;
-	std::vector<glm::vec3> temp_normals;
+	std::vector<unsigned int> readyMeshes;
+	bool sceneArrived = loader.update(*geometries, *textures, readyMeshes);
+	if (!loader.hasScene())
+		return false;
+	const LoadedScene &scene = loader.scene();
+
+	/* 1. Cena interpretada: configuração global, malhas vazias e curvas */
+	if (sceneArrived)
+	{
+		if (scene.description.hasGlobalConfig)
+			applyGlobalConfig(scene.description.globalConfig, globalConfig);
+		for (const SceneMeshDesc &desc : scene.description.meshes)
+			addSceneMesh(desc, INVALID_GEOMETRY, Material{}, INVALID_TEXTURE, geometries, meshes, meshList);
+		for (size_t c = 0; c < scene.description.curves.size(); ++c)
+			addSceneCurve(scene.description.curves[c], scene.controlPoints[c], scene.curvePoints[c], bezierCurves);
+		*liveScene = scene.description; // Base da próxima recarga
+	}
 
-	if (!file.is_open())
+	/* 2. Malhas que ficaram completas neste quadro */
+	for (unsigned int m : readyMeshes)
 	{
-		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
-		return vertices;
+		Mesh &mesh = (*meshes)[scene.description.meshes[m].name];
+		setMeshGeometry(mesh, scene.geometries[m], geometries);
+		setMeshMaterial(mesh, scene.materials[m]);
+		mesh.texture = scene.textures[m];
 	}
+	return sceneArrived;
+}
 
-	while (getline(file, line))
+/* Mesmos valores em todos os campos do bloco GlobalConfig */
+static bool sameGlobalConfig(const SceneGlobalDesc &a, const SceneGlobalDesc &b)
+{
+	return a.lightPos == b.lightPos && a.lightColor == b.lightColor && a.cameraPos == b.cameraPos &&
+				 a.cameraFront == b.cameraFront && a.fov == b.fov && a.nearPlane == b.nearPlane &&
+				 a.farPlane == b.farPlane && a.sensitivity == b.sensitivity && a.cameraSpeed == b.cameraSpeed;
+}
+
+/* Mesma transformação inicial */
+static bool sameTransform(const SceneMeshDesc &a, const SceneMeshDesc &b)
+{
+	return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale && a.angle == b.angle &&
+				 a.incrementalAngle == b.incrementalAngle;
+}
+
+/* Mesmos pontos gerados (a cor não entra: muda sem rediscretizar) */
+static bool sameCurveShape(const SceneCurveDesc &a, const SceneCurveDesc &b)
+{
+	if (a.usingOrbit != b.usingOrbit || a.pointsPerSegment != b.pointsPerSegment)
+		return false;
+	return a.usingOrbit ? (a.orbit == b.orbit && a.radius == b.radius) : a.controlPoints == b.controlPoints;
+}
+
+/*****************************************************************************************
+ *  reloadSceneFile()
+ *  --------------------------------------------------------------------------------------
+ *  Relê o Scene.txt alterado e o compara com a cena em uso (liveScene), refazendo só o
+ *  que mudou:
+ *    - malha nova / removida: adquire / libera geometria e textura;
+ *    - outro .obj ou .mtl: troca só a geometria ou o material (e a textura) da malha;
+ *    - transformação: só copia os valores;
+ *    - curva com outros pontos: rediscretiza e recria os VAOs só dela; cor: só copia.
+ *  Devolve true se o GlobalConfig mudou.
+ *****************************************************************************************/
+bool reloadSceneFile(const std::string &sceneFilePath,
+										 std::unordered_map<std::string, Mesh> *meshes,
+										 std::vector<std::string> *meshList,
+										 std::unordered_map<std::string, BezierCurve> *bezierCurves,
+										 GlobalConfig *globalConfig,
+										 GeometryRegistry *geometries,
+										 TextureRegistry *textures,
+										 SceneDescription *liveScene)
+{
+	auto start = std::chrono::steady_clock::now();
+	SceneDescription scene;
+	if (!parseSceneFile(sceneFilePath, scene))
+		return false;
+	unsigned int added = 0, removed = 0, rebuilt = 0, updated = 0;
+
+	/* 1. Configuração global: só se o bloco mudou (senão a câmera do usuário seria reposta) */
+	bool globalChanged = scene.hasGlobalConfig &&
+											 (!liveScene->hasGlobalConfig || !sameGlobalConfig(scene.globalConfig, liveScene->globalConfig));
+	if (globalChanged)
+		applyGlobalConfig(scene.globalConfig, globalConfig);
+
+	/* 2. Malhas, comparadas pelo nome com a descrição anterior (a Mesh pode estar animada) */
+	std::unordered_map<std::string, const SceneMeshDesc *> previousMeshes;
+	for (const SceneMeshDesc &desc : liveScene->meshes)
+		previousMeshes.emplace(desc.name, &desc);
+	std::unordered_set<std::string> inScene;
+	for (const SceneMeshDesc &desc : scene.meshes)
 	{
-		std::istringstream ss(line);
-		std::string type;
-		ss >> type;
+		inScene.insert(desc.name);
+		auto it = meshes->find(desc.name);
+		if (it == meshes->end())
+		{
+			GeometryId geometryId = geometries->acquire(desc.objFilePath);
+			Material material = loadMaterialAsset(desc.mtlFilePath);
+			addSceneMesh(desc, geometryId, material, textures->acquire(material.textureName), geometries, meshes, meshList);
+			++added;
+			continue;
+		}
 
-		/* Posições de vértice */
-		if (type == "v")
+		Mesh &mesh = it->second;
+		if (desc.objFilePath != mesh.objFilePath)
+		{
+			GeometryId geometryId = geometries->acquire(desc.objFilePath); // Antes de liberar: pode ser a mesma
+			geometries->release(mesh.geometry);
+			setMeshGeometry(mesh, geometryId, geometries);
+			mesh.objFilePath = desc.objFilePath;
+			++rebuilt;
+		}
+		if (desc.mtlFilePath != mesh.mtlFilePath)
 		{
-			glm::vec3 pos;
-			ss >> pos.x >> pos.y >> pos.z;
-			temp_positions.push_back(pos);
+			setMeshMaterial(mesh, loadMaterialAsset(desc.mtlFilePath));
+			TextureId textureId = textures->acquire(mesh.material.textureName);
+			textures->release(mesh.texture);
+			mesh.texture = textureId;
+			mesh.mtlFilePath = desc.mtlFilePath;
+			++rebuilt;
 		}
-		/* Coordenadas de textura */
-		else if (type == "vt")
+		auto old = previousMeshes.find(desc.name);
+		if (old == previousMeshes.end() || !sameTransform(desc, *old->second))
 		{
-			glm::vec2 uv;
-			ss >> uv.x >> uv.y;
-			temp_texcoords.push_back(uv);
+			setMeshTransform(mesh, desc);
+			++updated;
 		}
-		/* Normais */
-		else if (type == "vn")
+	}
+	for (auto it = meshes->begin(); it != meshes->end();)
+	{
+		if (inScene.count(it->first))
 		{
-			glm::vec3 n;
-			ss >> n.x >> n.y >> n.z;
-			temp_normals.push_back(n);
+			++it;
+			continue;
 		}
-		/* Faces (triângulos) */
-		else if (type == "f")
+		geometries->release(it->second.geometry);
+		textures->release(it->second.texture);
+		sceneMaterials.release(it->second.materialId);
+		if (it->second.proxy != BVH_NULL_NODE)
+			sceneBvh.destroyProxy(it->second.proxy);
+		it = meshes->erase(it);
+		++removed;
+	}
+	meshList->clear();
+	for (const SceneMeshDesc &desc : scene.meshes)
+		meshList->push_back(desc.name);
+
+	/* 3. Curvas, comparadas pelo nome com a descrição anterior */
+	std::unordered_map<std::string, const SceneCurveDesc *> previousCurves;
+	for (const SceneCurveDesc &desc : liveScene->curves)
+		previousCurves.emplace(desc.name, &desc);
+	inScene.clear();
+	for (const SceneCurveDesc &desc : scene.curves)
+	{
+		inScene.insert(desc.name);
+		auto it = bezierCurves->find(desc.name);
+		auto old = previousCurves.find(desc.name);
+		if (it != bezierCurves->end() && old != previousCurves.end() && sameCurveShape(desc, *old->second))
 		{
-			std::string v1, v2, v3;
-			ss >> v1 >> v2 >> v3;
-			int vIdx[3], tIdx[3], nIdx[3];
-
-			/* Converte cada vértice v/vt/vn para índices inteiros (0-based) */
-			std::string verts[3] = {v1, v2, v3};
-			for (int i = 0; i < 3; ++i)
+			if (it->second.color != desc.color)
 			{
-				size_t p1 = verts[i].find('/');
-				size_t p2 = verts[i].find('/', p1 + 1);
-				vIdx[i] = std::stoi(verts[i].substr(0, p1)) - 1;
-				tIdx[i] = std::stoi(verts[i].substr(p1 + 1, p2 - p1 - 1)) - 1;
-				nIdx[i] = std::stoi(verts[i].substr(p2 + 1)) - 1;
+				it->second.color = desc.color;
+				++updated;
 			}
+			continue;
+		}
 
-			/* Monta três structs Vertex e adiciona ao vetor final */
-			for (int i = 0; i < 3; ++i)
-			{
-				Vertex v{};
-				v.x = temp_positions[vIdx[i]].x;
-				v.y = temp_positions[vIdx[i]].y;
-				v.z = temp_positions[vIdx[i]].z;
-				v.s = temp_texcoords[tIdx[i]].x;
-				v.t = temp_texcoords[tIdx[i]].y;
-				v.nx = temp_normals[nIdx[i]].x;
-				v.ny = temp_normals[nIdx[i]].y;
-				v.nz = temp_normals[nIdx[i]].z;
-				vertices.push_back(v);
-			}
+		if (it != bezierCurves->end())
+		{
+			deleteControlPointsBuffer(it->second.VAO);
+			deleteControlPointsBuffer(it->second.controlPointsVAO);
+			sceneBvh.destroyProxy(it->second.proxy);
+			bezierCurves->erase(it);
+			++rebuilt;
+		}
+		else
+			++added;
+		std::vector<glm::vec3> controlPoints = desc.usingOrbit
+																							 ? generateCircleControlPoints(desc.orbit, desc.radius)
+																							 : desc.controlPoints;
+		addSceneCurve(desc, controlPoints, tessellateBezier(controlPoints, desc.pointsPerSegment), bezierCurves);
+	}
+	for (auto it = bezierCurves->begin(); it != bezierCurves->end();)
+	{
+		if (inScene.count(it->first))
+		{
+			++it;
+			continue;
 		}
+		deleteControlPointsBuffer(it->second.VAO);
+		deleteControlPointsBuffer(it->second.controlPointsVAO);
+		sceneBvh.destroyProxy(it->second.proxy);
+		it = bezierCurves->erase(it);
+		++removed;
 	}
-	file.close();
-	return vertices;
+
+	*liveScene = std::move(scene);
+	std::cout << "Cena recarregada em "
+						<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+						<< " ms: " << added << " adicionado(s), " << removed << " removido(s), " << rebuilt
+						<< " reconstruido(s), " << updated << " atualizado(s)" << (globalChanged ? ", GlobalConfig" : "") << '\n';
+	return globalChanged;
 }
 
 /*****************************************************************************************
- *  setupMtl()
+ *  reloadChangedAssets()
  *  --------------------------------------------------------------------------------------
- *  Lê um arquivo .mtl e devolve uma estrutura Material preenchida.
+ *  Recarrega os .obj, .mtl e imagens alterados em disco (changedFiles: caminhos canônicos,
+ *  ordenados). O registro esquece o caminho antigo, então só o primeiro acquire() relê o
+ *  arquivo; as outras malhas que o usam recebem a mesma geometria / textura nova.
  *****************************************************************************************/
-Material setupMtl(std::string path)
+void reloadChangedAssets(const std::vector<std::string> &changedFiles,
+												 std::unordered_map<std::string, Mesh> *meshes,
+												 GeometryRegistry *geometries,
+												 TextureRegistry *textures)
 {
-	Material material{};
-	std::ifstream file(path);
-	std::string line;
-
-	if (!file.is_open())
+	auto changed = [&changedFiles](const std::string &path)
+	{
+		return !path.empty() && std::binary_search(changedFiles.begin(), changedFiles.end(), canonicalPath(path));
+	};
+	for (const std::string &path : changedFiles)
 	{
-		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
-		return material;
+		geometries->invalidate(path);
+		textures->invalidate(path);
 	}
 
-	while (getline(file, line))
+	unsigned int reloaded = 0;
+	for (auto &pair : *meshes)
 	{
-		std::istringstream ss(line);
-		std::string type;
-		ss >> type;
-
-		if (type == "Ka")
-			ss >> material.kaR >> material.kaG >> material.kaB;
-		else if (type == "Kd")
-			ss >> material.kdR >> material.kdG >> material.kdB;
-		else if (type == "Ks")
-			ss >> material.ksR >> material.ksG >> material.ksB;
-		else if (type == "Ns")
-			ss >> material.ns;
-		else if (type == "map_Kd")
-			ss >> material.textureName;
+		Mesh &mesh = pair.second;
+		bool meshChanged = false;
+
+		if (changed(mesh.objFilePath))
+		{
+			GeometryId geometryId = geometries->acquire(mesh.objFilePath);
+			geometries->release(mesh.geometry);
+			setMeshGeometry(mesh, geometryId, geometries);
+			meshChanged = true;
+		}
+
+		bool mtlChanged = changed(mesh.mtlFilePath);
+		if (mtlChanged)
+		{
+			setMeshMaterial(mesh, loadMaterialAsset(mesh.mtlFilePath));
+			meshChanged = true;
+		}
+		if (mtlChanged || changed(mesh.material.textureName))
+		{
+			TextureId textureId = textures->acquire(mesh.material.textureName);
+			textures->release(mesh.texture);
+			mesh.texture = textureId;
+			meshChanged = true;
+		}
+		reloaded += meshChanged;
 	}
-	file.close();
-	return material;
+	if (reloaded)
+		std::cout << "Assets recarregados: " << reloaded << " malha(s) atualizada(s)\n";
 }
 
-/*****************************************************************************************
- *  setupTexture()
- *  --------------------------------------------------------------------------------------
- *  Carrega uma textura de disco com stb_image e cria um objeto de textura OpenGL.
- *  Aceita imagens RGB ou RGBA; gera mipmaps automaticamente.
- *****************************************************************************************/
-GLuint setupTexture(std::string filename)
+/* Observa o Scene.txt (vazio = pacote binário, não observado) e os arquivos de cada malha */
+void watchSceneFiles(FileWatcher &watcher, const std::string &sceneFilePath,
+										 const std::unordered_map<std::string, Mesh> &meshes)
 {
-	GLuint texId;
-	glGenTextures(1, &texId);
-	glBindTexture(GL_TEXTURE_2D, texId);
-
-	/* Parâmetros de wrapping e filtragem */
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	stbi_set_flip_vertically_on_load(true); // Ajusta origem da imagem
+	if (!sceneFilePath.empty())
+		watcher.watch(sceneFilePath);
+	for (const auto &pair : meshes)
+		for (const std::string *path : {&pair.second.objFilePath, &pair.second.mtlFilePath, &pair.second.material.textureName})
+			if (!path->empty())
+				watcher.watch(*path);
+}
 
-	int w, h, channels;
-	unsigned char *data = stbi_load(filename.c_str(), &w, &h, &channels, 0);
-	if (data)
-	{
-		GLenum fmt = (channels == 3) ? GL_RGB : GL_RGBA;
-		glTexImage2D(GL_TEXTURE_2D, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		std::cerr << "Falha ao carregar a textura " << filename << std::endl;
-	}
-	stbi_image_free(data);
-	return texId;
+/* Alças das uniformes usadas no laço principal (continuam válidas após Shader::reload()) */
+LineUniforms getLineUniforms(Shader &lineShader)
+{
+	LineUniforms uniforms;
+	uniforms.finalColor = lineShader.uniform<glm::vec4>("finalColor");
+	return uniforms;
 }
 
 /*****************************************************************************************
@@ -780,6 +1394,10 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 	if (key == GLFW_KEY_LEFT && action == GLFW_PRESS)
 		selectedMeshPosition.x -= 0.3f;
 
+	/* Seleciona a malha no centro da tela (no próximo quadro) */
+	if (key == GLFW_KEY_P && action == GLFW_PRESS)
+		pickRequested = true;
+
 	/* Mostrar/ocultar curvas */
 	if (key == GLFW_KEY_F1 && action == GLFW_PRESS)
 		showCurves = !showCurves;
@@ -817,87 +1435,6 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos)
 	globalConfig.cameraFront = glm::normalize(front);
 }
 
-/*****************************************************************************************
- *  setupGeometry()
- *  --------------------------------------------------------------------------------------
- *  Cria VBO + VAO para um vetor de Vertex e devolve o ID do VAO.
- *  Layout dos atributos:
- *    0 -> posição (vec3)      | offset 0
- *    1 -> texcoord (vec2)     | offset 3  * sizeof(float)
- *    2 -> cor (vec3)          | offset 5  * sizeof(float)
- *    3 -> normal (vec3)       | offset 8  * sizeof(float)
- *****************************************************************************************/
-int setupGeometry(std::vector<Vertex> &vertices)
-{
-	GLuint VBO, VAO;
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER,
-							 vertices.size() * sizeof(Vertex),
-							 vertices.data(), GL_STATIC_DRAW);
-
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	/* Posição */
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)0);
-	glEnableVertexAttribArray(0);
-
-	/* Texcoord */
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-												(GLvoid *)(3 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(1);
-
-	/* Cor */
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-												(GLvoid *)(5 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(2);
-
-	/* Normal */
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-												(GLvoid *)(8 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(3);
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
-	return VAO;
-}
-
-/*****************************************************************************************
- *  generateCircleControlPoints()
- *  --------------------------------------------------------------------------------------
- *  Gera pontos de controle para desenhar um círculo de raio “radius” ao redor de
- *  referencePoint, usando quatro curvas de Bézier cúbicas.
- *****************************************************************************************/
-std::vector<glm::vec3> generateCircleControlPoints(glm::vec3 referencePoint, float radius)
-{
-	std::vector<glm::vec3> cps;
-	const float k = 0.552284749831f * radius; // Constante para aproximar círculo
-
-	/* Pontos principais do “quadrado” circunscrito */
-	glm::vec3 P0 = referencePoint + glm::vec3(radius, 0, radius);		// Topo
-	glm::vec3 P1 = referencePoint + glm::vec3(radius, 0, -radius);	// Lado direito
-	glm::vec3 P2 = referencePoint + glm::vec3(-radius, 0, -radius); // Base
-	glm::vec3 P3 = referencePoint + glm::vec3(-radius, 0, radius);	// Lado esquerdo
-
-	/* Pontos auxiliares (tangentes) */
-	glm::vec3 P0a = P0 + glm::vec3(k, 0, -k);
-	glm::vec3 P0b = P0 + glm::vec3(-k, 0, k);
-	glm::vec3 P1a = P1 + glm::vec3(-k, 0, -k);
-	glm::vec3 P1b = P1 + glm::vec3(k, 0, k);
-	glm::vec3 P2a = P2 + glm::vec3(-k, 0, k);
-	glm::vec3 P2b = P2 + glm::vec3(k, 0, -k);
-	glm::vec3 P3a = P3 + glm::vec3(k, 0, k);
-	glm::vec3 P3b = P3 + glm::vec3(-k, 0, -k);
-
-	/* Quatro segmentos Bézier (cada 4 pontos) */
-	cps.insert(cps.end(), {P0, P0a, P1b, P1,
-												 P1a, P2b, P2,
-												 P2a, P3b, P3,
-												 P3a, P0b, P0});
-	return cps;
-}
-
 /*****************************************************************************************
  *  generateControlPointsBuffer()
  *  --------------------------------------------------------------------------------------
@@ -925,57 +1462,18 @@ GLuint generateControlPointsBuffer(std::vector<glm::vec3> controlPoints)
 }
 
 /*****************************************************************************************
- *  createBezierCurve()
+ *  deleteControlPointsBuffer()
  *  --------------------------------------------------------------------------------------
- *  Constrói pontos de uma ou mais curvas de Bézier cúbicas usando matriz de base
- *  (M) e gera VAO para renderização. Devolve estrutura BezierCurve preenchida.
+ *  Apaga um VAO criado por generateControlPointsBuffer() junto com o VBO ligado a ele.
  *****************************************************************************************/
-BezierCurve createBezierCurve(std::vector<glm::vec3> controlPoints,
-															int pointsPerSegment)
+void deleteControlPointsBuffer(GLuint VAO)
 {
-	/* Matriz de base de Bézier cúbica */
-	const glm::mat4 M(
-			-1, 3, -3, 1,
-			3, -6, 3, 0,
-			-3, 3, 0, 0,
-			1, 0, 0, 0);
-
-	std::vector<glm::vec3> curvePoints;
-	float step = 1.0f / static_cast<float>(pointsPerSegment);
-
-	/* Para cada segmento de 4 pontos (P0..P3) */
-	for (size_t i = 0; i + 3 < controlPoints.size(); i += 3)
-	{
-		for (float t = 0.0f; t <= 1.0f; t += step)
-		{
-			glm::vec4 T(t * t * t, t * t, t, 1.0f);
-			glm::mat4x3 G(controlPoints[i],
-										controlPoints[i + 1],
-										controlPoints[i + 2],
-										controlPoints[i + 3]);
-			curvePoints.push_back(G * M * T);
-		}
-	}
-
-	/* Envio à GPU (VBO + VAO) */
-	GLuint VBO, VAO;
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER,
-							 curvePoints.size() * sizeof(glm::vec3),
-							 curvePoints.data(), GL_STATIC_DRAW);
-
-	glGenVertexArrays(1, &VAO);
+	GLint VBO = 0;
 	glBindVertexArray(VAO);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-												3 * sizeof(GLfloat), (GLvoid *)0);
-	glEnableVertexAttribArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &VBO);
 	glBindVertexArray(0);
 
-	/* Preenche struct de retorno */
-	BezierCurve bc;
-	bc.VAO = VAO;
-	bc.curvePoints = curvePoints;
-	return bc;
+	GLuint buffer = static_cast<GLuint>(VBO);
+	glDeleteBuffers(1, &buffer);
+	glDeleteVertexArrays(1, &VAO);
 }
@@ -0,0 +1,533 @@
+// SceneBundle.cpp
+#include "SceneBundle.h" // Inclui o arquivo de cabeçalho do pacote de cena
+
+#include <cstring>			 // memcpy / memcmp
+#include <filesystem>		 // rename
+#include <fstream>			 // Gravação do pacote
+#include <iostream>			 // Saída de dados no console
+#include <unordered_map> // Deduplicação de geometrias e texturas na compilação
+
+#include "Bezier.h"			// generateCircleControlPoints / tessellateBezier
+#include "MappedFile.h" // Leitura dos arquivos de origem
+
+static const char BUNDLE_MAGIC[4] = {'S', 'C', 'N', 'B'};
+
+/*****************************************************************************************
+ *  SceneBundle::open()
+ *  --------------------------------------------------------------------------------------
+ *  Mapeia o arquivo, confere assinatura, versão e tamanho, localiza cada tabela pela
+ *  seção correspondente e valida todos os offsets uma única vez. Depois disso os
+ *  acessores só montam views sobre o mapeamento.
+ *****************************************************************************************/
+template <typename T>
+static bool findSection(const unsigned char *base, size_t size, const BundleSection *sections, unsigned int count,
+												const char *tag, const T *&table, unsigned int &elements)
+{
+	table = nullptr;
+	elements = 0;
+	for (unsigned int s = 0; s < count; ++s)
+	{
+		const BundleSection &section = sections[s];
+		if (std::memcmp(section.tag, tag, 4) != 0)
+			continue;
+		if (section.offset % SCENE_BUNDLE_ALIGNMENT != 0 || section.offset > size || section.size > size - section.offset ||
+				section.size != static_cast<unsigned long long>(section.count) * sizeof(T))
+			return false;
+		table = reinterpret_cast<const T *>(base + section.offset);
+		elements = section.count;
+	}
+	return true; // Seção ausente = tabela vazia
+}
+
+bool SceneBundle::open(const std::string &path)
+{
+	*this = SceneBundle();
+	blob = std::make_shared<AssetBlob>();
+	if (!blob->map(path))
+	{
+		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+		blob.reset();
+		return false;
+	}
+
+	const unsigned char *base = blob->data();
+	size_t size = blob->size();
+	BundleHeader header{};
+	if (size >= sizeof(header))
+		std::memcpy(&header, base, sizeof(header));
+	if (size < sizeof(header) || std::memcmp(header.magic, BUNDLE_MAGIC, 4) != 0 ||
+			header.version != SCENE_BUNDLE_VERSION || header.vertexLayout != MeshVertexLayout::signature() ||
+			header.fileSize != size ||
+			header.sectionCount > (size - sizeof(header)) / sizeof(BundleSection))
+	{
+		std::cerr << "Pacote de cena invalido ou de outra versao: " << path << std::endl;
+		*this = SceneBundle();
+		return false;
+	}
+
+	const BundleSection *sections = reinterpret_cast<const BundleSection *>(base + sizeof(BundleHeader));
+	const unsigned int n = header.sectionCount;
+	unsigned int globals = 0, stringBytes = 0;
+	bool ok = findSection(base, size, sections, n, "GCFG", global, globals) &&
+						findSection(base, size, sections, n, "GEOM", geometries, geometryTotal) &&
+						findSection(base, size, sections, n, "TEXR", textures, textureTotal) &&
+						findSection(base, size, sections, n, "MESH", meshes, meshTotal) &&
+						findSection(base, size, sections, n, "CURV", curves, curveTotal) &&
+						findSection(base, size, sections, n, "STRS", strings, stringBytes);
+	stringsSize = stringBytes;
+	if (globals == 0)
+		global = nullptr;
+
+	if (!ok || !validate())
+	{
+		std::cerr << "Pacote de cena corrompido: " << path << std::endl;
+		*this = SceneBundle();
+		return false;
+	}
+	return true;
+}
+
+/* Confere strings, índices e blocos de dados de todas as tabelas */
+bool SceneBundle::validate() const
+{
+	const size_t size = blob->size();
+	auto fits = [size](unsigned long long offset, unsigned long long bytes)
+	{ return offset % SCENE_BUNDLE_ALIGNMENT == 0 && offset <= size && bytes <= size - offset; };
+	auto validString = [this](const BundleString &s)
+	{ return s.offset <= stringsSize && s.length <= stringsSize - s.offset; };
+
+	for (unsigned int g = 0; g < geometryTotal; ++g)
+	{
+		const BundleGeometry &geometry = geometries[g];
+		if (!validString(geometry.path) || (geometry.indexSize != 2 && geometry.indexSize != 4) ||
+				!fits(geometry.vertexOffset, static_cast<unsigned long long>(geometry.vertexCount) * MeshVertexLayout::stride) ||
+				!fits(geometry.indexOffset, static_cast<unsigned long long>(geometry.indexCount) * geometry.indexSize) ||
+				!fits(geometry.meshletOffset, static_cast<unsigned long long>(geometry.meshletCount) * sizeof(Meshlet)) ||
+				!validLods(geometry.lods, geometry.lodCount, geometry.indexCount,
+									 reinterpret_cast<const Meshlet *>(blob->data() + geometry.meshletOffset), geometry.meshletCount))
+			return false;
+	}
+	for (unsigned int t = 0; t < textureTotal; ++t)
+	{
+		const BundleTexture &texture = textures[t];
+		if (!validString(texture.path) || texture.levelCount == 0 ||
+				!fits(texture.levelsOffset, static_cast<unsigned long long>(texture.levelCount) * sizeof(TextureLevel)) ||
+				!fits(texture.pixelsOffset, texture.pixelsSize))
+			return false;
+		/* Formato conhecido e cada nível com o tamanho que o formato e as dimensões exigem:
+		   o upload passa esses bytes direto para glTexSubImage2D / glCompressedTexSubImage2D */
+		const TextureLevel *levels = reinterpret_cast<const TextureLevel *>(blob->data() + texture.levelsOffset);
+		if (!validTextureLevels(levels, texture.levelCount, texture.format, texture.width, texture.height,
+														texture.channels, texture.pixelsSize))
+			return false;
+	}
+	for (unsigned int m = 0; m < meshTotal; ++m)
+	{
+		const BundleMesh &mesh = meshes[m];
+		if (!validString(mesh.name) || !validString(mesh.objFilePath) || !validString(mesh.mtlFilePath) ||
+				!validString(mesh.textureName) || (mesh.geometry != BUNDLE_NONE && mesh.geometry >= geometryTotal) ||
+				(mesh.texture != BUNDLE_NONE && mesh.texture >= textureTotal))
+			return false;
+	}
+	for (unsigned int c = 0; c < curveTotal; ++c)
+	{
+		const BundleCurve &curve = curves[c];
+		if (!validString(curve.name) ||
+				!fits(curve.controlPointsOffset, static_cast<unsigned long long>(curve.controlPointCount) * sizeof(glm::vec3)) ||
+				!fits(curve.curvePointsOffset, static_cast<unsigned long long>(curve.curvePointCount) * sizeof(glm::vec3)))
+			return false;
+	}
+	return true;
+}
+
+const glm::vec3 *SceneBundle::points(unsigned long long offset) const
+{
+	return reinterpret_cast<const glm::vec3 *>(blob->data() + offset);
+}
+
+/*****************************************************************************************
+ *  Acessores: convertem as entradas do pacote para os tipos usados pela cena
+ *****************************************************************************************/
+SceneGlobalDesc SceneBundle::globalConfig() const
+{
+	SceneGlobalDesc desc;
+	desc.lightPos = glm::vec3(global->lightPos[0], global->lightPos[1], global->lightPos[2]);
+	desc.lightColor = glm::vec3(global->lightColor[0], global->lightColor[1], global->lightColor[2]);
+	desc.cameraPos = glm::vec3(global->cameraPos[0], global->cameraPos[1], global->cameraPos[2]);
+	desc.cameraFront = glm::vec3(global->cameraFront[0], global->cameraFront[1], global->cameraFront[2]);
+	desc.fov = global->fov;
+	desc.nearPlane = global->nearPlane;
+	desc.farPlane = global->farPlane;
+	desc.sensitivity = global->sensitivity;
+	desc.cameraSpeed = global->cameraSpeed;
+	return desc;
+}
+
+SceneMeshDesc SceneBundle::meshDesc(unsigned int i) const
+{
+	const BundleMesh &mesh = meshes[i];
+	SceneMeshDesc desc;
+	desc.name = string(mesh.name);
+	desc.objFilePath = string(mesh.objFilePath);
+	desc.mtlFilePath = string(mesh.mtlFilePath);
+	desc.scale = glm::vec3(mesh.scale[0], mesh.scale[1], mesh.scale[2]);
+	desc.position = glm::vec3(mesh.position[0], mesh.position[1], mesh.position[2]);
+	desc.rotation = glm::vec3(mesh.rotation[0], mesh.rotation[1], mesh.rotation[2]);
+	desc.angle = glm::vec3(mesh.angle[0], mesh.angle[1], mesh.angle[2]);
+	desc.incrementalAngle = mesh.incrementalAngle;
+	return desc;
+}
+
+Material SceneBundle::meshMaterial(unsigned int i) const
+{
+	const BundleMesh &mesh = meshes[i];
+	const float *v = mesh.material;
+	return Material{v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], string(mesh.textureName)};
+}
+
+bool SceneBundle::meshGeometry(unsigned int i, std::string &objPath, unsigned long long &sourceHash,
+															 GeometryView &view) const
+{
+	if (meshes[i].geometry == BUNDLE_NONE)
+		return false;
+	const BundleGeometry &geometry = geometries[meshes[i].geometry];
+	objPath = string(geometry.path);
+	sourceHash = geometry.sourceHash;
+	view.vertices = blob->data() + geometry.vertexOffset;
+	view.bounds = geometry.bounds;
+	view.sphere = geometry.sphere;
+	view.lodCount = geometry.lodCount;
+	std::memcpy(view.lods, geometry.lods, sizeof(view.lods));
+	view.meshlets = reinterpret_cast<const Meshlet *>(blob->data() + geometry.meshletOffset);
+	view.meshletCount = geometry.meshletCount;
+	view.vertexCount = geometry.vertexCount;
+	view.indices = blob->data() + geometry.indexOffset;
+	view.indexCount = geometry.indexCount;
+	view.indexSize = geometry.indexSize;
+	return true;
+}
+
+bool SceneBundle::meshTexture(unsigned int i, std::string &imagePath, unsigned long long &sourceHash,
+															unsigned long long &pixelHash, TextureView &view) const
+{
+	if (meshes[i].texture == BUNDLE_NONE)
+		return false;
+	const BundleTexture &texture = textures[meshes[i].texture];
+	imagePath = string(texture.path);
+	sourceHash = texture.sourceHash;
+	pixelHash = texture.pixelHash;
+	view.width = texture.width;
+	view.height = texture.height;
+	view.channels = texture.channels;
+	view.levelCount = texture.levelCount;
+	view.format = texture.format;
+	view.levels = reinterpret_cast<const TextureLevel *>(blob->data() + texture.levelsOffset);
+	view.pixels = blob->data() + texture.pixelsOffset;
+	return true;
+}
+
+SceneCurveDesc SceneBundle::curveDesc(unsigned int i) const
+{
+	const BundleCurve &curve = curves[i];
+	SceneCurveDesc desc;
+	desc.name = string(curve.name);
+	const glm::vec3 *controlPoints = points(curve.controlPointsOffset);
+	desc.controlPoints.assign(controlPoints, controlPoints + curve.controlPointCount);
+	desc.pointsPerSegment = curve.pointsPerSegment;
+	desc.color = glm::vec4(curve.color[0], curve.color[1], curve.color[2], curve.color[3]);
+	desc.orbit = glm::vec3(curve.orbit[0], curve.orbit[1], curve.orbit[2]);
+	desc.radius = curve.radius;
+	desc.usingOrbit = curve.usingOrbit != 0;
+	return desc;
+}
+
+std::vector<glm::vec3> SceneBundle::curvePoints(unsigned int i) const
+{
+	const glm::vec3 *first = points(curves[i].curvePointsOffset);
+	return std::vector<glm::vec3>(first, first + curves[i].curvePointCount);
+}
+
+/* true se o arquivo começa com a assinatura "SCNB" */
+bool isSceneBundle(const std::string &path)
+{
+	MappedFile file(path);
+	return file.isOpen() && file.size() >= sizeof(BUNDLE_MAGIC) &&
+				 std::memcmp(file.data(), BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) == 0;
+}
+
+/*****************************************************************************************
+ *  Funções auxiliares de gravação
+ *****************************************************************************************/
+static void alignBundle(std::vector<unsigned char> &out)
+{
+	out.resize((out.size() + SCENE_BUNDLE_ALIGNMENT - 1) / SCENE_BUNDLE_ALIGNMENT * SCENE_BUNDLE_ALIGNMENT, 0);
+}
+
+/* Alinha, acrescenta "bytes" bytes e devolve o offset onde foram gravados */
+static unsigned long long appendBlock(std::vector<unsigned char> &out, const void *data, size_t bytes)
+{
+	alignBundle(out);
+	unsigned long long offset = out.size();
+	const unsigned char *p = static_cast<const unsigned char *>(data);
+	out.insert(out.end(), p, p + bytes);
+	return offset;
+}
+
+/* Grava uma tabela inteira como seção */
+template <typename T>
+static BundleSection appendSection(std::vector<unsigned char> &out, const char *tag, const std::vector<T> &table)
+{
+	BundleSection section{};
+	std::memcpy(section.tag, tag, 4);
+	section.count = static_cast<unsigned int>(table.size());
+	section.size = table.size() * sizeof(T);
+	section.offset = appendBlock(out, table.data(), section.size);
+	return section;
+}
+
+/* Tabela de strings: cada string é gravada uma vez */
+struct BundleStrings
+{
+	std::vector<char> bytes;
+	std::unordered_map<std::string, BundleString> known;
+
+	BundleString add(const std::string &s)
+	{
+		auto it = known.find(s);
+		if (it != known.end())
+			return it->second;
+		BundleString entry{static_cast<unsigned int>(bytes.size()), static_cast<unsigned int>(s.size())};
+		bytes.insert(bytes.end(), s.begin(), s.end());
+		known.emplace(s, entry);
+		return entry;
+	}
+};
+
+static void copyVec3(float *out, const glm::vec3 &v)
+{
+	out[0] = v.x;
+	out[1] = v.y;
+	out[2] = v.z;
+}
+
+/*****************************************************************************************
+ *  compileSceneBundle()
+ *  --------------------------------------------------------------------------------------
+ *  1. Interpreta o Scene.txt (parseSceneFile).
+ *  2. Para cada malha, carrega geometria, material e textura pelos mesmos caminhos da
+ *     carga normal (cache de assets incluído); arquivos repetidos, por caminho ou por
+ *     conteúdo, entram uma única vez.
+ *  3. Expande órbitas e discretiza as curvas.
+ *  4. Grava dados alinhados, depois as tabelas, a tabela de strings e por fim preenche
+ *     cabeçalho e seções. O arquivo é escrito em um temporário e renomeado.
+ *  Uso: Hello3D --compile-scene <Scene.txt> <saída.bundle> [--compress-textures]
+ *****************************************************************************************/
+bool compileSceneBundle(const std::string &scenePath, const std::string &bundlePath, bool compressTextures)
+{
+	SceneDescription scene;
+	if (!parseSceneFile(scenePath, scene))
+		return false;
+
+	const unsigned int SECTION_COUNT = 6;
+	std::vector<unsigned char> out(sizeof(BundleHeader) + SECTION_COUNT * sizeof(BundleSection), 0);
+	BundleStrings strings;
+	std::vector<BundleGeometry> geometries;
+	std::vector<BundleTexture> textures;
+	std::vector<BundleMesh> meshes;
+	std::vector<BundleCurve> curves;
+	std::unordered_map<std::string, unsigned int> geometryByPath, textureByPath;
+	std::unordered_map<unsigned long long, unsigned int> geometryByHash, textureByHash;
+
+	/* Geometria do .obj (índice na tabela, ou BUNDLE_NONE se não puder ser lida) */
+	auto addGeometry = [&](const std::string &objPath) -> unsigned int
+	{
+		std::string key = canonicalPath(objPath);
+		auto pathIt = geometryByPath.find(key);
+		if (pathIt != geometryByPath.end())
+			return pathIt->second;
+
+		MappedFile source(objPath);
+		if (!source.isOpen())
+		{
+			std::cerr << "Falha ao abrir o arquivo " << objPath << std::endl;
+			return geometryByPath[key] = BUNDLE_NONE;
+		}
+		unsigned long long hash = hashAsset(source);
+		auto hashIt = geometryByHash.find(hash);
+		if (hashIt != geometryByHash.end())
+			return geometryByPath[key] = hashIt->second;
+
+		AssetBlob blob;
+		GeometryView view{};
+		if (!loadGeometryAsset(source, hash, objPath, blob, view))
+			return geometryByPath[key] = BUNDLE_NONE;
+
+		BundleGeometry geometry{};
+		geometry.path = strings.add(objPath);
+		geometry.vertexCount = view.vertexCount;
+		geometry.indexCount = view.indexCount;
+		geometry.indexSize = view.indexSize;
+		geometry.bounds = view.bounds;
+		geometry.sphere = view.sphere;
+		geometry.lodCount = view.lodCount;
+		std::memcpy(geometry.lods, view.lods, sizeof(geometry.lods));
+		geometry.meshletCount = view.meshletCount;
+		geometry.sourceHash = hash;
+		geometry.meshletOffset = appendBlock(out, view.meshlets, static_cast<size_t>(view.meshletCount) * sizeof(Meshlet));
+		geometry.vertexOffset = appendBlock(out, view.vertices, static_cast<size_t>(view.vertexCount) * MeshVertexLayout::stride);
+		geometry.indexOffset = appendBlock(out, view.indices, static_cast<size_t>(view.indexCount) * view.indexSize);
+		geometries.push_back(geometry);
+		unsigned int index = static_cast<unsigned int>(geometries.size() - 1);
+		geometryByHash[hash] = index;
+		return geometryByPath[key] = index;
+	};
+
+	/* Textura com todos os mipmaps (índice na tabela, ou BUNDLE_NONE) */
+	auto addTexture = [&](const std::string &imagePath) -> unsigned int
+	{
+		if (imagePath.empty()) // Material sem textura
+			return BUNDLE_NONE;
+
+		std::string key = canonicalPath(imagePath);
+		auto pathIt = textureByPath.find(key);
+		if (pathIt != textureByPath.end())
+			return pathIt->second;
+
+		MappedFile source(imagePath);
+		if (!source.isOpen())
+		{
+			std::cerr << "Falha ao carregar a textura " << imagePath << std::endl;
+			return textureByPath[key] = BUNDLE_NONE;
+		}
+		unsigned long long hash = hashAsset(source);
+		auto hashIt = textureByHash.find(hash);
+		if (hashIt != textureByHash.end())
+			return textureByPath[key] = hashIt->second;
+
+		AssetBlob blob;
+		TextureView view{};
+		if (!loadTextureAsset(source, hash, imagePath, blob, view, compressTextures))
+			return textureByPath[key] = BUNDLE_NONE;
+
+		BundleTexture texture{};
+		texture.path = strings.add(imagePath);
+		texture.width = view.width;
+		texture.height = view.height;
+		texture.channels = view.channels;
+		texture.levelCount = view.levelCount;
+		texture.format = view.format;
+		texture.sourceHash = hash;
+		texture.pixelHash = hashTexturePixels(view);
+		const TextureLevel &last = view.levels[view.levelCount - 1];
+		texture.pixelsSize = last.offset + last.size;
+		texture.levelsOffset = appendBlock(out, view.levels, view.levelCount * sizeof(TextureLevel));
+		texture.pixelsOffset = appendBlock(out, view.pixels, texture.pixelsSize);
+		textures.push_back(texture);
+		unsigned int index = static_cast<unsigned int>(textures.size() - 1);
+		textureByHash[hash] = index;
+		return textureByPath[key] = index;
+	};
+
+	/* 2. Malhas */
+	for (const SceneMeshDesc &desc : scene.meshes)
+	{
+		Material material = loadMaterialAsset(desc.mtlFilePath);
+
+		BundleMesh mesh{};
+		mesh.name = strings.add(desc.name);
+		mesh.objFilePath = strings.add(desc.objFilePath);
+		mesh.mtlFilePath = strings.add(desc.mtlFilePath);
+		mesh.textureName = strings.add(material.textureName);
+		mesh.geometry = addGeometry(desc.objFilePath);
+		mesh.texture = addTexture(material.textureName);
+		const float values[10] = {material.kaR, material.kaG, material.kaB, material.kdR, material.kdG,
+															material.kdB, material.ksR, material.ksG, material.ksB, material.ns};
+		std::memcpy(mesh.material, values, sizeof(values));
+		copyVec3(mesh.scale, desc.scale);
+		copyVec3(mesh.position, desc.position);
+		copyVec3(mesh.rotation, desc.rotation);
+		copyVec3(mesh.angle, desc.angle);
+		mesh.incrementalAngle = desc.incrementalAngle;
+		meshes.push_back(mesh);
+	}
+
+	/* 3. Curvas: órbitas expandidas e pontos já discretizados */
+	for (const SceneCurveDesc &desc : scene.curves)
+	{
+		std::vector<glm::vec3> controlPoints = desc.usingOrbit ? generateCircleControlPoints(desc.orbit, desc.radius)
+																													 : desc.controlPoints;
+		std::vector<glm::vec3> curvePoints = tessellateBezier(controlPoints, desc.pointsPerSegment);
+
+		BundleCurve curve{};
+		curve.name = strings.add(desc.name);
+		curve.pointsPerSegment = desc.pointsPerSegment;
+		curve.usingOrbit = desc.usingOrbit ? 1 : 0;
+		std::memcpy(curve.color, &desc.color[0], sizeof(curve.color));
+		copyVec3(curve.orbit, desc.orbit);
+		curve.radius = desc.radius;
+		curve.controlPointCount = static_cast<unsigned int>(controlPoints.size());
+		curve.curvePointCount = static_cast<unsigned int>(curvePoints.size());
+		curve.controlPointsOffset = appendBlock(out, controlPoints.data(), controlPoints.size() * sizeof(glm::vec3));
+		curve.curvePointsOffset = appendBlock(out, curvePoints.data(), curvePoints.size() * sizeof(glm::vec3));
+		curves.push_back(curve);
+	}
+
+	/* 4. Tabelas, strings, cabeçalho */
+	std::vector<BundleGlobal> global;
+	if (scene.hasGlobalConfig)
+	{
+		const SceneGlobalDesc &config = scene.globalConfig;
+		BundleGlobal entry{};
+		copyVec3(entry.lightPos, config.lightPos);
+		copyVec3(entry.lightColor, config.lightColor);
+		copyVec3(entry.cameraPos, config.cameraPos);
+		copyVec3(entry.cameraFront, config.cameraFront);
+		entry.fov = config.fov;
+		entry.nearPlane = config.nearPlane;
+		entry.farPlane = config.farPlane;
+		entry.sensitivity = config.sensitivity;
+		entry.cameraSpeed = config.cameraSpeed;
+		global.push_back(entry);
+	}
+
+	BundleSection sections[SECTION_COUNT] = {
+			appendSection(out, "GCFG", global),
+			appendSection(out, "GEOM", geometries),
+			appendSection(out, "TEXR", textures),
+			appendSection(out, "MESH", meshes),
+			appendSection(out, "CURV", curves),
+			appendSection(out, "STRS", strings.bytes)};
+	alignBundle(out);
+
+	BundleHeader header{};
+	std::memcpy(header.magic, BUNDLE_MAGIC, 4);
+	header.version = SCENE_BUNDLE_VERSION;
+	header.vertexLayout = MeshVertexLayout::signature();
+	header.sectionCount = SECTION_COUNT;
+	header.fileSize = out.size();
+	std::memcpy(out.data(), &header, sizeof(header));
+	std::memcpy(out.data() + sizeof(header), sections, sizeof(sections));
+
+	std::string temp = bundlePath + ".tmp";
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		if (!file.write(reinterpret_cast<const char *>(out.data()), out.size()))
+		{
+			std::cerr << "Falha ao gravar o pacote " << bundlePath << std::endl;
+			return false;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp, bundlePath, ec);
+	if (ec)
+	{
+		std::cerr << "Falha ao gravar o pacote " << bundlePath << std::endl;
+		std::filesystem::remove(temp, ec);
+		return false;
+	}
+
+	std::cout << "Pacote " << bundlePath << ": " << meshes.size() << " malha(s), " << curves.size() << " curva(s), "
+						<< geometries.size() << " geometria(s), " << textures.size() << " textura(s), "
+						<< out.size() / (1024.0 * 1024.0) << " MB" << std::endl;
+	return true;
+}
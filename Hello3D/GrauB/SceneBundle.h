@@ -0,0 +1,146 @@
+// SceneBundle.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <memory> // std::shared_ptr
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include "AssetCache.h"	 // AssetBlob / GeometryView / TextureView
+#include "Material.h"		 // Struct Material
+#include "SceneParser.h" // SceneGlobalDesc / SceneMeshDesc / SceneCurveDesc
+
+// Versão do formato do pacote; pacotes de outra versão são recusados (recompilar com --compile-scene)
+const unsigned int SCENE_BUNDLE_VERSION = 5;
+
+// Alinhamento (bytes) de cada tabela e de cada bloco de dados dentro do pacote
+const size_t SCENE_BUNDLE_ALIGNMENT = 16;
+
+// Índice ausente nas tabelas (malha sem geometria ou sem textura)
+const unsigned int BUNDLE_NONE = ~0u;
+
+/*
+ * Layout do arquivo (todos os offsets são absolutos, em bytes, e alinhados):
+ *   BundleHeader | BundleSection[sectionCount] | dados (meshlets, vértices, índices, mipmaps, pontos)
+ *   | tabelas "GCFG", "GEOM", "TEXR", "MESH", "CURV" | tabela de strings "STRS"
+ * As tabelas são arrays das structs abaixo; o leitor só valida os limites e aponta para
+ * dentro do mapeamento, sem converter nada.
+ */
+struct BundleHeader
+{
+	char magic[4];								// "SCNB"
+	unsigned int version;					// SCENE_BUNDLE_VERSION
+	unsigned int sectionCount;		// Entradas da tabela de seções
+	unsigned int vertexLayout;		// MeshVertexLayout::signature() dos vértices
+	unsigned long long fileSize;	// Tamanho total esperado
+};
+
+struct BundleSection
+{
+	char tag[4];									// "GCFG", "GEOM", ...
+	unsigned int count;						// Elementos da tabela (bytes para "STRS")
+	unsigned long long offset, size;
+};
+
+// Trecho da tabela de strings
+struct BundleString
+{
+	unsigned int offset, length;
+};
+
+struct BundleGlobal
+{
+	float lightPos[3], lightColor[3], cameraPos[3], cameraFront[3];
+	float fov, nearPlane, farPlane, sensitivity, cameraSpeed;
+	unsigned int reserved;
+};
+
+struct BundleGeometry
+{
+	BundleString path;																	 // .obj de origem (chave do GeometryRegistry)
+	unsigned int vertexCount, indexCount, indexSize, reserved; // Como em GeometryView
+	VertexBounds bounds;																 // Decodifica as posições quantizadas
+	BoundingSphere sphere;															 // Esfera envolvente
+	unsigned int lodCount, meshletCount;
+	MeshLod lods[MESH_LOD_MAX];													 // Trechos do index buffer
+	unsigned long long sourceHash;											 // hashAsset() do .obj
+	unsigned long long vertexOffset, indexOffset;				 // Vértices em MeshVertexLayout e índices de 16/32 bits
+	unsigned long long meshletOffset;										 // Meshlet[meshletCount]
+};
+
+struct BundleTexture
+{
+	BundleString path;													 // Imagem de origem (chave do TextureRegistry)
+	unsigned int width, height, channels, levelCount; // Como em TextureView
+	TextureFormat format;												 // Raw, BC1 ou BC3
+	unsigned int reserved;
+	unsigned long long sourceHash, pixelHash;		// hashAsset() do arquivo e hashTexturePixels()
+	unsigned long long levelsOffset;						// TextureLevel[levelCount] (offsets relativos aos pixels)
+	unsigned long long pixelsOffset, pixelsSize; // Todos os níveis, em sequência
+};
+
+struct BundleMesh
+{
+	BundleString name, objFilePath, mtlFilePath, textureName;
+	unsigned int geometry, texture; // Índices em "GEOM" e "TEXR" (BUNDLE_NONE = ausente)
+	float material[10];							// Ka, Kd, Ks (RGB) e Ns
+	float scale[3], position[3], rotation[3], angle[3];
+	unsigned int incrementalAngle, reserved;
+};
+
+struct BundleCurve
+{
+	BundleString name;
+	unsigned int pointsPerSegment, usingOrbit;
+	float color[4], orbit[3], radius;
+	unsigned int controlPointCount, curvePointCount;					 // glm::vec3 em cada bloco
+	unsigned long long controlPointsOffset, curvePointsOffset; // Curva já discretizada
+};
+
+// Pacote binário de uma cena inteira: configuração global, malhas, curvas já discretizadas,
+// geometrias e texturas no formato final de upload. Mapeado em memória; as views apontam
+// direto para o mapeamento, que fica vivo enquanto alguém segurar data().
+class SceneBundle
+{
+private:
+	std::shared_ptr<AssetBlob> blob; // Arquivo mapeado
+	const char *strings = nullptr;
+	size_t stringsSize = 0;
+	const BundleGlobal *global = nullptr;
+	const BundleGeometry *geometries = nullptr;
+	const BundleTexture *textures = nullptr;
+	const BundleMesh *meshes = nullptr;
+	const BundleCurve *curves = nullptr;
+	unsigned int geometryTotal = 0, textureTotal = 0, meshTotal = 0, curveTotal = 0;
+
+	std::string string(const BundleString &s) const { return std::string(strings + s.offset, s.length); }
+	const glm::vec3 *points(unsigned long long offset) const;
+	bool validate() const;
+
+public:
+	// Mapeia e valida o pacote (cabeçalho, versão e limites de todas as tabelas)
+	bool open(const std::string &path);
+
+	const std::shared_ptr<AssetBlob> &data() const { return blob; }
+
+	bool hasGlobalConfig() const { return global != nullptr; }
+	SceneGlobalDesc globalConfig() const;
+
+	unsigned int meshCount() const { return meshTotal; }
+	SceneMeshDesc meshDesc(unsigned int i) const;
+	Material meshMaterial(unsigned int i) const;
+
+	// Geometria / textura da malha i; false se a malha não tiver
+	bool meshGeometry(unsigned int i, std::string &objPath, unsigned long long &sourceHash, GeometryView &view) const;
+	bool meshTexture(unsigned int i, std::string &imagePath, unsigned long long &sourceHash,
+									 unsigned long long &pixelHash, TextureView &view) const;
+
+	unsigned int curveCount() const { return curveTotal; }
+	SceneCurveDesc curveDesc(unsigned int i) const; // controlPoints já com a órbita expandida
+	std::vector<glm::vec3> curvePoints(unsigned int i) const;
+};
+
+// true se o arquivo começa com a assinatura de um SceneBundle
+bool isSceneBundle(const std::string &path);
+
+// Lê o Scene.txt, carrega tudo o que ele referencia e grava o pacote em bundlePath
+bool compileSceneBundle(const std::string &scenePath, const std::string &bundlePath, bool compressTextures);
@@ -0,0 +1,252 @@
+// SceneLoader.cpp
+#include "SceneLoader.h"
+
+#include <iostream>			 // Mensagens de erro
+#include <limits>				 // std::numeric_limits
+#include <unordered_map> // Arquivos únicos por caminho canônico
+
+#include <glm/geometric.hpp> // glm::dot
+
+#include "Bezier.h"			 // generateCircleControlPoints / tessellateBezier
+#include "MappedFile.h"	 // Leitura dos .obj via mmap
+#include "SceneBundle.h" // isSceneBundle
+
+/*****************************************************************************************
+ *  start()
+ *  --------------------------------------------------------------------------------------
+ *  Dispara a tarefa inicial (leitura do Scene.txt). Pacotes binários não passam pelo
+ *  pipeline: já estão no formato final e são apenas mapeados na thread do OpenGL.
+ *****************************************************************************************/
+void SceneLoader::start(const std::string &path)
+{
+	scenePath = path;
+	bundle = isSceneBundle(path);
+	if (bundle)
+		return;
+
+	pending = 1; // A própria cena; os arquivos entram na conta quando ela chega
+	workers.submit([this]
+								 { parseJob(); });
+}
+
+/*****************************************************************************************
+ *  setCamera()
+ *****************************************************************************************/
+void SceneLoader::setCamera(const glm::vec3 &position)
+{
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	camera = position;
+}
+
+/*****************************************************************************************
+ *  parseJob()
+ *  --------------------------------------------------------------------------------------
+ *  Thread de trabalho: interpreta a cena, discretiza as curvas e agrupa os .obj / .mtl
+ *  referenciados (cada arquivo uma vez só). Entrega a cena primeiro e então enfileira uma
+ *  tarefa por arquivo; cada tarefa lê o arquivo pendente mais próximo da câmera.
+ *****************************************************************************************/
+void SceneLoader::parseJob()
+{
+	auto scene = std::make_shared<ParsedScene>();
+	LoadedScene &loaded = scene->scene;
+	scene->ok = parseSceneFile(scenePath, loaded.description);
+
+	std::vector<PendingFile> files;
+	if (scene->ok)
+	{
+		/* Arquivos únicos: caminhos diferentes para o mesmo arquivo são lidos uma vez */
+		std::unordered_map<std::string, unsigned int> objIndex, mtlIndex;
+		const std::vector<SceneMeshDesc> &meshes = loaded.description.meshes;
+		for (unsigned int m = 0; m < meshes.size(); ++m)
+		{
+			const SceneMeshDesc &desc = meshes[m];
+			auto obj = objIndex.emplace(canonicalPath(desc.objFilePath), (unsigned int)scene->objPaths.size());
+			if (obj.second)
+			{
+				scene->objPaths.push_back(desc.objFilePath);
+				scene->objMeshes.emplace_back();
+				files.push_back({ResultKind::Geometry, obj.first->second, {}});
+			}
+			scene->meshObj.push_back(obj.first->second);
+			scene->objMeshes[obj.first->second].push_back(m);
+
+			auto mtl = mtlIndex.emplace(canonicalPath(desc.mtlFilePath), (unsigned int)scene->mtlPaths.size());
+			if (mtl.second)
+			{
+				scene->mtlPaths.push_back(desc.mtlFilePath);
+				scene->mtlMeshes.emplace_back();
+				files.push_back({ResultKind::Material, mtl.first->second, {}});
+			}
+			scene->meshMtl.push_back(mtl.first->second);
+			scene->mtlMeshes[mtl.first->second].push_back(m);
+		}
+
+		/* Posições de todas as malhas que usam cada arquivo (a mais próxima define a prioridade) */
+		for (PendingFile &file : files)
+			for (unsigned int m : (file.kind == ResultKind::Geometry ? scene->objMeshes : scene->mtlMeshes)[file.index])
+				file.positions.push_back(meshes[m].position);
+
+		/* Curvas: se for curva orbital, gera pontos de controle automaticamente */
+		for (const SceneCurveDesc &desc : loaded.description.curves)
+		{
+			loaded.controlPoints.push_back(desc.usingOrbit ? generateCircleControlPoints(desc.orbit, desc.radius)
+																										 : desc.controlPoints);
+			loaded.curvePoints.push_back(tessellateBezier(loaded.controlPoints.back(), desc.pointsPerSegment));
+		}
+		loaded.geometries.assign(meshes.size(), INVALID_GEOMETRY);
+		loaded.materials.assign(meshes.size(), Material{});
+		loaded.textures.assign(meshes.size(), INVALID_TEXTURE);
+	}
+
+	/* Daqui em diante "scene" só é lida pelas tarefas abaixo e alterada pela thread do OpenGL
+	   em campos que as tarefas não usam (LoadedScene) */
+	size_t fileCount = files.size();
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		pendingFiles = std::move(files);
+	}
+
+	Result sceneResult{};
+	sceneResult.kind = ResultKind::Scene;
+	sceneResult.ok = scene->ok;
+	sceneResult.parsed = scene;
+	results.push(std::move(sceneResult));
+
+	for (size_t i = 0; i < fileCount; ++i)
+		workers.submit([this, scene]
+									 { loadNearestFile(*scene); });
+}
+
+/*****************************************************************************************
+ *  loadNearestFile()
+ *  --------------------------------------------------------------------------------------
+ *  Thread de trabalho: retira da lista o arquivo com a malha mais próxima da câmera (a
+ *  posição informada por último, não a do início da carga) e o lê.
+ *****************************************************************************************/
+void SceneLoader::loadNearestFile(const ParsedScene &scene)
+{
+	if (cancelled)
+		return;
+
+	PendingFile file;
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		size_t nearest = 0;
+		float nearestDistance = std::numeric_limits<float>::max(); // Ao quadrado
+		for (size_t f = 0; f < pendingFiles.size(); ++f)
+			for (const glm::vec3 &position : pendingFiles[f].positions)
+			{
+				float distance = glm::dot(position - camera, position - camera);
+				if (distance < nearestDistance)
+				{
+					nearest = f;
+					nearestDistance = distance;
+				}
+			}
+		file = std::move(pendingFiles[nearest]);
+		pendingFiles[nearest] = std::move(pendingFiles.back());
+		pendingFiles.pop_back();
+	}
+
+	Result result{};
+	result.kind = file.kind;
+	result.index = file.index;
+	if (file.kind == ResultKind::Geometry)
+	{
+		const std::string &path = scene.objPaths[file.index];
+		result.blob = std::make_shared<AssetBlob>();
+		MappedFile source(path);
+		if (source.isOpen())
+		{
+			result.sourceHash = hashAsset(source);
+			result.ok = loadGeometryAsset(source, result.sourceHash, path, *result.blob, result.geometry);
+		}
+		else
+			std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+	}
+	else
+	{
+		result.ok = true;
+		result.material = loadMaterialAsset(scene.mtlPaths[file.index]);
+	}
+	results.push(std::move(result));
+}
+
+/*****************************************************************************************
+ *  update()
+ *  --------------------------------------------------------------------------------------
+ *  Thread do OpenGL: recebe os resultados prontos sem esperar por nenhum. Cada geometria
+ *  vai para a GPU na chegada e cada material já pede a sua textura; uma malha fica completa
+ *  quando o seu .obj e o seu .mtl chegaram.
+ *****************************************************************************************/
+bool SceneLoader::update(GeometryRegistry &geometries, TextureRegistry &textures, std::vector<unsigned int> &readyMeshes)
+{
+	bool sceneArrived = false;
+	size_t uploaded = 0;
+	Result result;
+	while (pending > 0 && uploaded < SCENE_UPLOAD_BUDGET && results.pop(result))
+	{
+		--pending;
+		switch (result.kind)
+		{
+		case ResultKind::Scene:
+			parsed = result.parsed;
+			if (!result.ok)
+				break;
+			sceneArrived = true;
+			objIds.assign(parsed->objPaths.size(), INVALID_GEOMETRY);
+			objDone.assign(parsed->objPaths.size(), 0);
+			objUsed.assign(parsed->objPaths.size(), 0);
+			materials.resize(parsed->mtlPaths.size());
+			textureIds.assign(parsed->mtlPaths.size(), INVALID_TEXTURE);
+			mtlDone.assign(parsed->mtlPaths.size(), 0);
+			mtlUsed.assign(parsed->mtlPaths.size(), 0);
+			pending += parsed->objPaths.size() + parsed->mtlPaths.size();
+			break;
+		case ResultKind::Geometry:
+			if (result.ok)
+			{
+				objIds[result.index] = geometries.acquire(parsed->objPaths[result.index], result.sourceHash, result.geometry);
+				uploaded += result.geometry.vertexCount * MeshVertexLayout::stride +
+										(size_t)result.geometry.indexCount * result.geometry.indexSize;
+			}
+			objDone[result.index] = 1;
+			for (unsigned int m : parsed->objMeshes[result.index])
+				if (mtlDone[parsed->meshMtl[m]])
+					completeMesh(m, geometries, textures, readyMeshes);
+			break;
+		case ResultKind::Material:
+			materials[result.index] = result.material;
+			textureIds[result.index] = textures.acquire(result.material.textureName);
+			mtlDone[result.index] = 1;
+			for (unsigned int m : parsed->mtlMeshes[result.index])
+				if (objDone[parsed->meshObj[m]])
+					completeMesh(m, geometries, textures, readyMeshes);
+			break;
+		}
+	}
+	return sceneArrived;
+}
+
+/* A primeira malha de cada arquivo herda a referência do loader; as seguintes pedem outra */
+void SceneLoader::completeMesh(unsigned int mesh, GeometryRegistry &geometries, TextureRegistry &textures,
+															 std::vector<unsigned int> &readyMeshes)
+{
+	LoadedScene &scene = parsed->scene;
+	unsigned int obj = parsed->meshObj[mesh], mtl = parsed->meshMtl[mesh];
+
+	GeometryId geometryId = objIds[obj];
+	if (objUsed[obj] && geometryId != INVALID_GEOMETRY)
+		geometryId = geometries.acquire(parsed->objPaths[obj]); // Já registrado: só conta a referência
+	objUsed[obj] = 1;
+
+	TextureId textureId = textureIds[mtl];
+	if (mtlUsed[mtl])
+		textureId = textures.acquire(materials[mtl].textureName);
+	mtlUsed[mtl] = 1;
+
+	scene.geometries[mesh] = geometryId;
+	scene.materials[mesh] = materials[mtl];
+	scene.textures[mesh] = textureId;
+	readyMeshes.push_back(mesh);
+}
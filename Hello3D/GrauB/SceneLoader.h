@@ -0,0 +1,136 @@
+// SceneLoader.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <atomic> // Cancelamento das tarefas pendentes
+#include <memory> // std::shared_ptr
+#include <mutex>	// Fila de prioridade dos arquivos
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include "AssetCache.h"				// AssetBlob / GeometryView
+#include "GeometryRegistry.h" // GeometryId
+#include "LockFreeQueue.h"		// Resultados das threads de trabalho
+#include "Material.h"					// Struct Material
+#include "SceneParser.h"			// SceneDescription
+#include "TextureRegistry.h"	// TextureId
+#include "ThreadPool.h"				// Tarefas de carga
+
+// Bytes de geometria (VBO + EBO) enviados para a GPU por quadro durante a carga progressiva
+const size_t SCENE_UPLOAD_BUDGET = 4 * 1024 * 1024;
+
+// Cena em carga na thread do OpenGL: uma entrada por malha e por curva, na ordem do arquivo.
+// geometries / materials / textures são os handles de cada malha; ficam em INVALID_GEOMETRY
+// / INVALID_TEXTURE até os arquivos dela chegarem (ver SceneLoader::update()).
+struct LoadedScene
+{
+	SceneDescription description;
+	std::vector<GeometryId> geometries;											 // Por malha
+	std::vector<Material> materials;												 // Por malha
+	std::vector<TextureId> textures;												 // Por malha
+	std::vector<std::vector<glm::vec3>> controlPoints;			 // Por curva (órbitas expandidas)
+	std::vector<std::vector<glm::vec3>> curvePoints;				 // Por curva (já discretizada)
+};
+
+// Carga progressiva da cena, como um grafo de dependências:
+//   start():  [thread de trabalho] lê o Scene.txt -> uma tarefa por .obj e por .mtl únicos
+//   update(): [thread do OpenGL, uma vez por quadro] recebe pela LockFreeQueue o que ficou
+//             pronto: a cena (só dados), geometrias (enviadas para a GPU, até
+//             SCENE_UPLOAD_BUDGET por quadro) e materiais (que já pedem a sua textura).
+// Nada bloqueia a thread do OpenGL: o laço de renderização desenha cada malha assim que a
+// geometria e o material dela chegam. Cada tarefa de arquivo escolhe, no momento em que
+// roda, o arquivo pendente mais próximo da câmera (setCamera()).
+class SceneLoader
+{
+private:
+	// Cena interpretada + listas de arquivos únicos (produzida pela tarefa inicial)
+	struct ParsedScene
+	{
+		bool ok = false;
+		LoadedScene scene;
+		std::vector<std::string> objPaths, mtlPaths;								// Arquivos únicos (caminho como escrito na cena)
+		std::vector<unsigned int> meshObj, meshMtl;									// Por malha: índice em objPaths / mtlPaths
+		std::vector<std::vector<unsigned int>> objMeshes, mtlMeshes; // Por arquivo: malhas que o usam
+	};
+
+	enum class ResultKind
+	{
+		Scene,
+		Geometry,
+		Material
+	};
+
+	// Arquivo ainda não lido, com as posições das malhas que o usam (prioridade)
+	struct PendingFile
+	{
+		ResultKind kind;
+		unsigned int index;
+		std::vector<glm::vec3> positions;
+	};
+
+	// Resultado de uma tarefa, entregue à thread do OpenGL
+	struct Result
+	{
+		ResultKind kind;
+		unsigned int index;							 // Em objPaths / mtlPaths
+		bool ok;
+		unsigned long long sourceHash;	 // Geometry: hashAsset() do .obj
+		std::shared_ptr<AssetBlob> blob; // Geometry: mantém a view válida até o envio
+		GeometryView geometry;
+		Material material;
+		std::shared_ptr<ParsedScene> parsed; // Scene
+	};
+
+	std::string scenePath;
+	bool bundle = false; // O arquivo é um SceneBundle (carregado por inteiro na thread do OpenGL)
+
+	/* Thread do OpenGL */
+	std::shared_ptr<ParsedScene> parsed;					 // Nulo até a cena chegar
+	std::vector<GeometryId> objIds;								 // Por .obj (referência ainda do loader)
+	std::vector<Material> materials;							 // Por .mtl
+	std::vector<TextureId> textureIds;						 // Por .mtl (referência ainda do loader)
+	std::vector<unsigned char> objDone, mtlDone;	 // Resultado já recebido
+	std::vector<unsigned char> objUsed, mtlUsed;	 // Referência do loader já entregue a uma malha
+	size_t pending = 0;														 // Resultados ainda esperados
+
+	/* Compartilhado com as threads de trabalho */
+	std::mutex pendingMutex;					 // Protege pendingFiles e camera
+	std::vector<PendingFile> pendingFiles; // Arquivos ainda não lidos
+	glm::vec3 camera{};										 // Última posição informada por setCamera()
+	std::atomic<bool> cancelled{false};		 // Destrutor: tarefas restantes não leem nada
+	LockFreeQueue<Result> results;				 // Resultados ainda não recebidos por update()
+
+	// Último membro: é destruído primeiro, e as tarefas ainda na fila usam os membros acima
+	ThreadPool workers;
+
+	void parseJob();
+	void loadNearestFile(const ParsedScene &scene);
+	void completeMesh(unsigned int mesh, GeometryRegistry &geometries, TextureRegistry &textures,
+										std::vector<unsigned int> &readyMeshes);
+
+public:
+	SceneLoader() = default;
+	~SceneLoader() { cancelled = true; }
+
+	SceneLoader(const SceneLoader &) = delete;
+	SceneLoader &operator=(const SceneLoader &) = delete;
+
+	// Começa a carga em segundo plano (não precisa de contexto OpenGL)
+	void start(const std::string &path);
+
+	const std::string &path() const { return scenePath; }
+	bool isBundle() const { return bundle; }
+
+	// Posição atual da câmera: os próximos arquivos lidos são os das malhas mais próximas
+	void setCamera(const glm::vec3 &position);
+
+	// Thread do OpenGL, uma vez por quadro, sem bloquear. Acrescenta a readyMeshes as malhas
+	// (índices em scene().description.meshes) que ficaram completas. Devolve true no quadro
+	// em que a cena interpretada chega (a partir daí scene() é válida)
+	bool update(GeometryRegistry &geometries, TextureRegistry &textures, std::vector<unsigned int> &readyMeshes);
+
+	bool hasScene() const { return parsed && parsed->ok; }
+	const LoadedScene &scene() const { return parsed->scene; }
+
+	// true quando não há mais nada a receber (também se a cena não pôde ser lida)
+	bool done() const { return pending == 0; }
+};
@@ -0,0 +1,395 @@
+// SceneParser.cpp
+#include "SceneParser.h" // Inclui o arquivo de cabeçalho do leitor de cena
+
+#include <chrono>				// Medição de tempo do benchmark
+#include <cstring>			// memchr
+#include <iostream>			// Saída de dados no console
+#include <string_view>	// Tokens sem cópia
+#include <unordered_set> // Nomes já usados por malhas e curvas
+
+#include <glm/gtc/type_ptr.hpp> // glm::value_ptr
+
+#include "MappedFile.h" // Arquivo mapeado em memória
+#include "TextTokens.h" // isBlank / skipBlanks / skipToken / parseFloat
+
+// Palavras-chave reconhecidas (primeiro token da linha, ou tipo de bloco em "Type")
+enum class SceneKeyword
+{
+	Unknown,
+	Type,
+	End,
+	// Tipos de bloco
+	GlobalConfig,
+	Mesh,
+	BezierCurve,
+	// GlobalConfig
+	LightPos,
+	LightColor,
+	CameraPos,
+	CameraFront,
+	Fov,
+	NearPlane,
+	FarPlane,
+	Sensitivity,
+	CameraSpeed,
+	// Mesh
+	Obj,
+	Mtl,
+	Scale,
+	Position,
+	Rotation,
+	Angle,
+	IncrementalAngle,
+	// BezierCurve
+	ControlPoint,
+	PointsPerSegment,
+	Color,
+	Orbit,
+	Radius
+};
+
+/* FNV-1a de 32 bits; constexpr para servir de rótulo nos "case" abaixo */
+static constexpr unsigned int keywordHash(std::string_view token)
+{
+	unsigned int hash = 2166136261u;
+	for (char c : token)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/*****************************************************************************************
+ *  lookupKeyword()
+ *  --------------------------------------------------------------------------------------
+ *  Um único switch sobre o hash do token. Dois nomes com o mesmo hash gerariam "case"
+ *  duplicado e não compilariam, então o hash é perfeito para este conjunto; a
+ *  comparação final só descarta tokens desconhecidos que caiam no mesmo valor.
+ *****************************************************************************************/
+static SceneKeyword lookupKeyword(std::string_view token)
+{
+#define SCENE_KEYWORD(name)   \
+	case keywordHash(#name):    \
+		return token == #name ? SceneKeyword::name : SceneKeyword::Unknown;
+
+	switch (keywordHash(token))
+	{
+		SCENE_KEYWORD(Type)
+		SCENE_KEYWORD(End)
+		SCENE_KEYWORD(GlobalConfig)
+		SCENE_KEYWORD(Mesh)
+		SCENE_KEYWORD(BezierCurve)
+		SCENE_KEYWORD(LightPos)
+		SCENE_KEYWORD(LightColor)
+		SCENE_KEYWORD(CameraPos)
+		SCENE_KEYWORD(CameraFront)
+		SCENE_KEYWORD(Fov)
+		SCENE_KEYWORD(NearPlane)
+		SCENE_KEYWORD(FarPlane)
+		SCENE_KEYWORD(Sensitivity)
+		SCENE_KEYWORD(CameraSpeed)
+		SCENE_KEYWORD(Obj)
+		SCENE_KEYWORD(Mtl)
+		SCENE_KEYWORD(Scale)
+		SCENE_KEYWORD(Position)
+		SCENE_KEYWORD(Rotation)
+		SCENE_KEYWORD(Angle)
+		SCENE_KEYWORD(IncrementalAngle)
+		SCENE_KEYWORD(ControlPoint)
+		SCENE_KEYWORD(PointsPerSegment)
+		SCENE_KEYWORD(Color)
+		SCENE_KEYWORD(Orbit)
+		SCENE_KEYWORD(Radius)
+	default:
+		return SceneKeyword::Unknown;
+	}
+#undef SCENE_KEYWORD
+}
+
+/* Próximo token da linha (vazio no fim da linha) */
+static inline std::string_view nextToken(const char *&p, const char *end)
+{
+	p = skipBlanks(p, end);
+	const char *start = p;
+	p = skipToken(p, end);
+	return std::string_view(start, p - start);
+}
+
+/* Lê até "count" floats; valores ausentes no fim da linha ficam como estavam (como no istringstream) */
+static inline void readFloats(const char *p, const char *end, float *values, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		p = skipBlanks(p, end);
+		if (p == end)
+			return;
+		p = parseFloat(p, end, values[i]);
+	}
+}
+
+/* Lê um inteiro sem sinal; token inválido vira 0, token ausente mantém o valor */
+static inline void readUnsigned(const char *p, const char *end, unsigned int &value)
+{
+	p = skipBlanks(p, end);
+	if (p == end)
+		return;
+	if (std::from_chars(p, end, value).ec != std::errc())
+		value = 0;
+}
+
+/* Lê uma palavra (caminho de arquivo, nome); token ausente mantém o valor */
+static inline void readWord(const char *p, const char *end, std::string &value)
+{
+	std::string_view token = nextToken(p, end);
+	if (!token.empty())
+		value.assign(token.data(), token.size());
+}
+
+/*****************************************************************************************
+ *  parseScene()
+ *  --------------------------------------------------------------------------------------
+ *  Percorre o buffer uma única vez, linha a linha (memchr), sem istringstream e sem
+ *  alocar por token: o primeiro token vira uma SceneKeyword por lookupKeyword() e o
+ *  resto da linha é lido no lugar.
+ *  Os campos valem só dentro do tipo de bloco correspondente e, como no leitor antigo,
+ *  são acumulados entre blocos: um campo omitido herda o valor do bloco anterior do
+ *  mesmo tipo. Em "End" o bloco é copiado para a descrição; um bloco com o nome de outro
+ *  do mesmo tipo é informado e ignorado (as entidades são identificadas pelo nome).
+ *****************************************************************************************/
+void parseScene(const char *begin, const char *end, SceneDescription &scene)
+{
+	SceneKeyword objectType = SceneKeyword::Unknown; // Tipo do bloco atual
+	std::string name;																 // Nome do bloco atual
+	std::unordered_set<std::string> meshNames, curveNames; // Para rejeitar nomes repetidos
+
+	SceneGlobalDesc global;
+	SceneMeshDesc mesh{};
+	mesh.scale = glm::vec3(1.0f);
+	SceneCurveDesc curve{};
+	curve.color = glm::vec4(1.0f);
+	curve.radius = 1.0f;
+
+	for (const char *line = begin; line < end;)
+	{
+		const char *eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+		if (!eol)
+			eol = end;
+		++scene.lineCount;
+
+		const char *p = line;
+		SceneKeyword keyword = lookupKeyword(nextToken(p, eol));
+		line = eol + 1;
+
+		/* Campos de bloco: só valem dentro do tipo correspondente */
+		if (objectType == SceneKeyword::GlobalConfig)
+		{
+			switch (keyword)
+			{
+			case SceneKeyword::LightPos:
+				readFloats(p, eol, glm::value_ptr(global.lightPos), 3);
+				continue;
+			case SceneKeyword::LightColor:
+				readFloats(p, eol, glm::value_ptr(global.lightColor), 3);
+				continue;
+			case SceneKeyword::CameraPos:
+				readFloats(p, eol, glm::value_ptr(global.cameraPos), 3);
+				continue;
+			case SceneKeyword::CameraFront:
+				readFloats(p, eol, glm::value_ptr(global.cameraFront), 3);
+				continue;
+			case SceneKeyword::Fov:
+				readFloats(p, eol, &global.fov, 1);
+				continue;
+			case SceneKeyword::NearPlane:
+				readFloats(p, eol, &global.nearPlane, 1);
+				continue;
+			case SceneKeyword::FarPlane:
+				readFloats(p, eol, &global.farPlane, 1);
+				continue;
+			case SceneKeyword::Sensitivity:
+				readFloats(p, eol, &global.sensitivity, 1);
+				continue;
+			case SceneKeyword::CameraSpeed:
+				readFloats(p, eol, &global.cameraSpeed, 1);
+				continue;
+			default:
+				break;
+			}
+		}
+		else if (objectType == SceneKeyword::Mesh)
+		{
+			switch (keyword)
+			{
+			case SceneKeyword::Obj:
+				readWord(p, eol, mesh.objFilePath);
+				continue;
+			case SceneKeyword::Mtl:
+				readWord(p, eol, mesh.mtlFilePath);
+				continue;
+			case SceneKeyword::Scale:
+				readFloats(p, eol, glm::value_ptr(mesh.scale), 3);
+				continue;
+			case SceneKeyword::Position:
+				readFloats(p, eol, glm::value_ptr(mesh.position), 3);
+				continue;
+			case SceneKeyword::Rotation:
+				readFloats(p, eol, glm::value_ptr(mesh.rotation), 3);
+				continue;
+			case SceneKeyword::Angle:
+				readFloats(p, eol, glm::value_ptr(mesh.angle), 3);
+				continue;
+			case SceneKeyword::IncrementalAngle:
+				readUnsigned(p, eol, mesh.incrementalAngle);
+				continue;
+			default:
+				break;
+			}
+		}
+		else if (objectType == SceneKeyword::BezierCurve)
+		{
+			switch (keyword)
+			{
+			case SceneKeyword::ControlPoint:
+			{
+				glm::vec3 cp(0.0f);
+				readFloats(p, eol, glm::value_ptr(cp), 3);
+				curve.controlPoints.push_back(cp);
+				curve.usingOrbit = false; // Se definir pontos manualmente, desativa órbita
+				continue;
+			}
+			case SceneKeyword::PointsPerSegment:
+				readUnsigned(p, eol, curve.pointsPerSegment);
+				continue;
+			case SceneKeyword::Color:
+				readFloats(p, eol, glm::value_ptr(curve.color), 4);
+				continue;
+			case SceneKeyword::Orbit:
+				readFloats(p, eol, glm::value_ptr(curve.orbit), 3);
+				curve.usingOrbit = true; // Ativa modo de órbita (círculo automático)
+				continue;
+			case SceneKeyword::Radius:
+				readFloats(p, eol, &curve.radius, 1);
+				continue;
+			default:
+				break;
+			}
+		}
+
+		/* Início e fim de bloco */
+		if (keyword == SceneKeyword::Type)
+		{
+			objectType = lookupKeyword(nextToken(p, eol));
+			readWord(p, eol, name);
+		}
+		else if (keyword == SceneKeyword::End)
+		{
+			if (objectType == SceneKeyword::GlobalConfig)
+			{
+				scene.globalConfig = global;
+				scene.hasGlobalConfig = true;
+			}
+			else if (objectType == SceneKeyword::Mesh)
+			{
+				if (meshNames.insert(name).second)
+				{
+					mesh.name = name;
+					scene.meshes.push_back(mesh);
+				}
+				else
+					std::cerr << "Malha duplicada na linha " << scene.lineCount << ": " << name << " (ignorada)" << std::endl;
+			}
+			else if (objectType == SceneKeyword::BezierCurve)
+			{
+				if (curveNames.insert(name).second)
+				{
+					curve.name = name;
+					scene.curves.push_back(curve);
+				}
+				else
+					std::cerr << "Curva duplicada na linha " << scene.lineCount << ": " << name << " (ignorada)" << std::endl;
+				curve.controlPoints.clear(); // Limpa para o próximo bloco
+			}
+		}
+	}
+}
+
+/* Versão que lê o arquivo indicado (mapeado em memória) */
+bool parseSceneFile(const std::string path, SceneDescription &scene)
+{
+	MappedFile file(path);
+	if (!file.isOpen())
+	{
+		std::cerr << "Falha ao abrir o arquivo " << path << std::endl;
+		return false;
+	}
+	parseScene(file.data(), file.end(), scene);
+	return true;
+}
+
+/* Cena sintética com "entities" blocos (3 malhas para cada curva), no formato do Scene.txt */
+static std::string makeSyntheticScene(unsigned int entities)
+{
+	std::string text = "Type GlobalConfig Config\nLightPos 0.0 0.0 9.0\nLightColor 1.0 1.0 1.0\n"
+										 "CameraPos 0 7.0 30.0\nCameraFront 0.0 0.0 -1.0\nFov 45.0\nEnd\n";
+	text.reserve(entities * 200);
+	for (unsigned int i = 0; i < entities; ++i)
+	{
+		std::string id = std::to_string(i);
+		std::string x = std::to_string((i % 1000) * 0.25f), z = std::to_string((i / 1000) * -0.5f);
+		if (i % 4 != 3)
+			text += "--------------------\nType Mesh Objeto" + id + "\nObj ../../3D_Models/bola.obj\n"
+							"Mtl ../../3D_Models/bola.mtl\nScale 0.1 0.1 0.1\nPosition " + x + " 0.0 " + z +
+							"\nRotation 0.0 1.0 0.0\nAngle " + std::to_string(i % 360) + "\nEnd\n";
+		else
+			text += "--------------------\nType BezierCurve Curva" + id + "\nPointsPerSegment 100\n"
+							"Color 1.0 0.0 0.0 1.0\nOrbit " + x + " 0.0 " + z + "\nRadius 1.5\nEnd\n";
+	}
+	return text;
+}
+
+/*****************************************************************************************
+ *  benchmarkSceneParser()
+ *  --------------------------------------------------------------------------------------
+ *  Gera cenas sintéticas com 1.000, 10.000, ... até "maxEntities" blocos, interpreta
+ *  cada uma "repetitions" vezes direto da memória e imprime o melhor tempo, a vazão em
+ *  linhas/s e MB/s, e se a quantidade de malhas/curvas lidas confere.
+ *  Uso: Hello3D --bench-scene [entidades] [repetições]
+ *****************************************************************************************/
+int benchmarkSceneParser(unsigned int maxEntities, int repetitions)
+{
+	int status = 0;
+	for (unsigned int entities = 1000;; entities = (entities * 10 > maxEntities && entities != maxEntities) ? maxEntities : entities * 10)
+	{
+		if (entities > maxEntities)
+			entities = maxEntities;
+		std::string text = makeSyntheticScene(entities);
+
+		double best = 0.0;
+		SceneDescription scene;
+		for (int r = 0; r < repetitions; ++r)
+		{
+			scene = SceneDescription();
+			auto start = std::chrono::steady_clock::now();
+			parseScene(text.data(), text.data() + text.size(), scene);
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			if (r == 0 || elapsed.count() < best)
+				best = elapsed.count();
+		}
+
+		unsigned int curves = entities / 4;
+		bool complete = scene.meshes.size() == entities - curves && scene.curves.size() == curves && scene.hasGlobalConfig;
+		if (!complete)
+			status = -1;
+
+		double megabytes = text.size() / (1024.0 * 1024.0);
+		std::cout << "Cena sintetica: " << entities << " entidades, " << scene.lineCount << " linhas, " << megabytes
+							<< " MB, melhor de " << repetitions << ": " << best * 1000.0 << " ms ("
+							<< (best > 0.0 ? scene.lineCount / best / 1e6 : 0.0) << " M linhas/s, "
+							<< (best > 0.0 ? megabytes / best : 0.0) << " MB/s)" << (complete ? "" : "  CONTAGEM INCORRETA")
+							<< std::endl;
+		if (entities == maxEntities)
+			break;
+	}
+	return status;
+}
@@ -0,0 +1,57 @@
+// SceneParser.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+#include <glm/glm.hpp> // Tipos glm::vec3 / glm::vec4
+
+// Bloco "Type GlobalConfig": iluminação e câmera iniciais
+struct SceneGlobalDesc
+{
+	glm::vec3 lightPos{}, lightColor{};		// Posição e cor da luz principal
+	glm::vec3 cameraPos{}, cameraFront{}; // Posição e direção inicial da câmera
+	float fov{}, nearPlane{}, farPlane{};	// Projeção perspectiva
+	float sensitivity{}, cameraSpeed{};		// Sensibilidade do mouse e velocidade da câmera
+};
+
+// Bloco "Type Mesh": arquivos de origem e transformação inicial
+struct SceneMeshDesc
+{
+	std::string name;											// Identificador textual
+	std::string objFilePath, mtlFilePath; // Arquivos de origem
+	glm::vec3 scale, position, rotation;	// Transformações gerais
+	glm::vec3 angle;											// Ângulos iniciais (XYZ)
+	unsigned int incrementalAngle;				// Flag p/ rotação contínua
+};
+
+// Bloco "Type BezierCurve": pontos de controle explícitos ou órbita circular
+struct SceneCurveDesc
+{
+	std::string name;											// Identificador textual
+	std::vector<glm::vec3> controlPoints; // Linhas "ControlPoint" do bloco
+	unsigned int pointsPerSegment;				// Resolução por segmento
+	glm::vec4 color;											// Cor de renderização
+	glm::vec3 orbit;											// Centro da órbita
+	float radius;													// Raio da órbita
+	bool usingOrbit;											// true = gerar os pontos a partir de orbit/radius
+};
+
+// Conteúdo completo de um Scene.txt, sem nenhum recurso OpenGL
+struct SceneDescription
+{
+	bool hasGlobalConfig = false;				// Algum bloco GlobalConfig foi encontrado
+	SceneGlobalDesc globalConfig;				// Último bloco GlobalConfig do arquivo
+	std::vector<SceneMeshDesc> meshes;	// Na ordem do arquivo
+	std::vector<SceneCurveDesc> curves; // Na ordem do arquivo
+	size_t lineCount = 0;								// Linhas lidas (estatística)
+};
+
+// Interpreta o texto de um Scene.txt diretamente do buffer [begin, end), uma única passada
+void parseScene(const char *begin, const char *end, SceneDescription &scene);
+
+// Mapeia o arquivo em memória e o interpreta; false se não for possível abri-lo
+bool parseSceneFile(const std::string path, SceneDescription &scene);
+
+// Mede a vazão (linhas/s) do leitor de cena sobre cenas sintéticas de tamanho crescente
+int benchmarkSceneParser(unsigned int maxEntities, int repetitions);
@@ -5,10 +5,25 @@
 #include <fstream>	// Para operações de E/S de arquivos (ifstream)
 #include <sstream>	// Para usar std::stringstream (streams de string)
 #include <iostream> // Para entrada/saída padrão (std::cout)
+#include <algorithm> // std::sort / std::lower_bound
+
+// Insere o cabeçalho depois da linha #version; "#line 2" mantém os números de linha
+// dos erros de compilação iguais aos do arquivo
+static void insertHeader(std::string &code, const std::string &header)
+{
+	if (header.empty())
+		return;
+	size_t versionEnd = code.find('\n');
+	versionEnd = (versionEnd == std::string::npos) ? code.size() : versionEnd + 1;
+	code.insert(versionEnd, header + "#line 2\n");
+}
 
 // Construtor da classe Shader
 // Lê os códigos fonte do vertex e fragment shader de arquivos, compila-os e os vincula a um programa shader.
-Shader::Shader(const std::string vertexShaderPath, const std::string fragmentShaderPath)
+Shader::Shader(const std::string vertexShaderPath, const std::string fragmentShaderPath, const std::string vertexShaderHeader,
+							 const std::string fragmentShaderHeader)
+		: vertexPath(vertexShaderPath), fragmentPath(fragmentShaderPath), vertexHeader(vertexShaderHeader),
+			fragmentHeader(fragmentShaderHeader)
 {
 
 	std::string vertexCode;		 // String para armazenar o código do vertex shader
@@ -44,6 +59,9 @@ Shader::Shader(const std::string vertexShaderPath, const std::string fragmentSha
 		// Adicionar tratamento de erro mais robusto aqui, como lançar uma exceção ou definir um estado de erro.
 	}
 
+	insertHeader(vertexCode, vertexHeader);
+	insertHeader(fragmentCode, fragmentHeader);
+
 	const GLchar *vShaderCode = vertexCode.c_str();		// Converte o código do vertex shader para um array de caracteres C-style
 	const GLchar *fShaderCode = fragmentCode.c_str(); // Converte o código do fragment shader para um array de caracteres C-style
 
@@ -95,6 +113,131 @@ Shader::Shader(const std::string vertexShaderPath, const std::string fragmentSha
 	// Após a linkagem bem-sucedida, os objetos shader individuais não são mais necessários e podem ser deletados
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
+
+	reflectUniforms(); // Localizações lidas uma vez aqui, não a cada quadro
+}
+
+/*****************************************************************************************
+ *  reflectUniforms()
+ *  --------------------------------------------------------------------------------------
+ *  Lê todas as uniformes ativas (nome, tipo, tamanho e localização) e atualiza a
+ *  localização de cada alça já pedida. Membros de blocos uniformes (localização -1) ficam
+ *  de fora: são escritos pelo buffer do bloco, que volta a ser apontado para o seu
+ *  binding point.
+ *****************************************************************************************/
+void Shader::reflectUniforms()
+{
+	uniforms.clear();
+	GLint linked = 0, count = 0, maxLength = 0;
+	glGetProgramiv(id, GL_LINK_STATUS, &linked);
+	if (linked)
+	{
+		glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	}
+	std::vector<GLchar> name(std::max(maxLength, 1));
+	for (GLint i = 0; i < count; ++i)
+	{
+		ShaderUniform uniform;
+		GLsizei length = 0;
+		glGetActiveUniform(id, static_cast<GLuint>(i), maxLength, &length, &uniform.size, &uniform.type, name.data());
+		uniform.name.assign(name.data(), length);
+		uniform.location = glGetUniformLocation(id, uniform.name.c_str());
+		if (uniform.location < 0)
+			continue;
+		if (uniform.name.size() > 3 && uniform.name.compare(uniform.name.size() - 3, 3, "[0]") == 0)
+			uniform.name.resize(uniform.name.size() - 3);
+		uniforms.push_back(uniform);
+	}
+	std::sort(uniforms.begin(), uniforms.end(), [](const ShaderUniform &a, const ShaderUniform &b)
+						{ return a.name < b.name; });
+
+	for (size_t slot = 0; slot < slotNames.size(); ++slot)
+		slotLocations[slot] = uniformLocation(slotNames[slot]);
+	for (const ShaderBlockBinding &block : blocks)
+		applyBlockBinding(block);
+}
+
+void Shader::bindUniformBlock(const std::string &name, GLuint binding, GLint expectedSize)
+{
+	ShaderBlockBinding block{name, binding, expectedSize};
+	auto found = std::find_if(blocks.begin(), blocks.end(), [&](const ShaderBlockBinding &other)
+														{ return other.name == name; });
+	if (found != blocks.end())
+		*found = block;
+	else
+		blocks.push_back(block);
+	applyBlockBinding(block);
+}
+
+/* O binding do bloco é estado do programa: perdido em cada nova linkagem */
+void Shader::applyBlockBinding(const ShaderBlockBinding &block)
+{
+	GLint linked = 0;
+	glGetProgramiv(id, GL_LINK_STATUS, &linked);
+	GLuint index = linked ? glGetUniformBlockIndex(id, block.name.c_str()) : GL_INVALID_INDEX;
+	if (index == GL_INVALID_INDEX)
+		return;
+
+	glUniformBlockBinding(id, index, block.binding);
+	GLint size = 0;
+	glGetActiveUniformBlockiv(id, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+	if (size != block.expectedSize)
+		std::cout << "Bloco " << block.name << " em " << vertexPath << ": " << size << " bytes no shader, "
+							<< block.expectedSize << " no programa\n";
+}
+
+/* Uniforme ativa pelo nome (busca binária; nullptr se não existe) */
+static const ShaderUniform *findUniform(const std::vector<ShaderUniform> &uniforms, const std::string &name)
+{
+	auto it = std::lower_bound(uniforms.begin(), uniforms.end(), name, [](const ShaderUniform &uniform, const std::string &key)
+														 { return uniform.name < key; });
+	return (it != uniforms.end() && it->name == name) ? &*it : nullptr;
+}
+
+GLint Shader::uniformLocation(const std::string &name) const
+{
+	const ShaderUniform *uniform = findUniform(uniforms, name);
+	return uniform ? uniform->location : -1;
+}
+
+// Registra (ou reaproveita) a alça de "name" e confere o tipo declarado no shader
+int Shader::registerSlot(const std::string &name, GLenum type)
+{
+	auto found = std::find(slotNames.begin(), slotNames.end(), name);
+	int slot = static_cast<int>(found - slotNames.begin());
+	if (found == slotNames.end())
+	{
+		slotNames.push_back(name);
+		slotLocations.push_back(uniformLocation(name));
+	}
+
+	const ShaderUniform *uniform = findUniform(uniforms, name);
+	bool integer = uniform && (uniform->type == GL_INT || uniform->type == GL_BOOL || uniform->type == GL_SAMPLER_2D);
+	if (uniform && uniform->type != type && !(type == GL_INT && integer))
+		std::cout << "Uniforme " << name << " em " << fragmentPath << ": tipo no shader (0x" << std::hex << uniform->type
+							<< std::dec << ") difere do usado pelo programa\n";
+	return slot;
+}
+
+// Método para recompilar o programa (ex.: arquivo .vs/.fs alterado em disco)
+// Compila um programa novo e só troca o atual se a linkagem der certo.
+bool Shader::reload()
+{
+	Shader rebuilt(vertexPath, fragmentPath, vertexHeader, fragmentHeader); // Mesmo caminho de compilação do construtor
+
+	GLint success;
+	glGetProgramiv(rebuilt.id, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glDeleteProgram(rebuilt.id); // Mantém o programa anterior
+		return false;
+	}
+
+	glDeleteProgram(id);
+	id = rebuilt.id;
+	reflectUniforms(); // Mesmas alças, localizações do programa novo
+	return true;
 }
 
 // Método para definir a uniforme de textura (para a unidade de textura 0)
@@ -102,5 +245,5 @@ void Shader::setTextureUniform()
 {
 	// Define o valor da variável uniforme "tex" no shader para 0.
 	// Isso significa que a uniforme "tex" (do tipo sampler2D, por exemplo) usará a textura vinculada à GL_TEXTURE0.
-	glUniform1i(glGetUniformLocation(this->id, "tex"), 0);
+	glUniform1i(uniformLocation("tex"), 0);
 }
\ No newline at end of file
@@ -2,22 +2,142 @@
 #pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
 
 #include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
 
 #include <glad/glad.h> // Inclui a biblioteca GLAD para funcionalidades OpenGL (como GLuint)
+#include <glm/glm.hpp> // glm::vec3 / glm::vec4 / glm::mat4 (valores das uniformes)
+
+// Uniforme ativa do programa, lida com glGetActiveUniform depois da linkagem
+struct ShaderUniform
+{
+	std::string name; // Sem o sufixo "[0]" dos arrays
+	GLenum type;			// GL_FLOAT, GL_FLOAT_VEC3, GL_SAMPLER_2D...
+	GLint size;				// Elementos (1 fora de arrays)
+	GLint location;
+};
+
+// Bloco uniforme que o programa lê de um buffer (UniformBuffer) ligado a um binding point
+struct ShaderBlockBinding
+{
+	std::string name;
+	GLuint binding;
+	GLint expectedSize; // Bytes do struct C++ correspondente (conferido com o do shader)
+};
+
+// Alça tipada de uma uniforme: índice fixo na tabela do Shader, que guarda a localização
+// atual (refeita a cada reload()). Definir o valor não procura nomes nem chama o driver
+// para achar a localização
+template <typename T>
+struct Uniform
+{
+	int slot = -1;
+};
 
 // Declaração da classe Shader
 class Shader
 {
 private:
 	GLuint id; // Membro privado para armazenar o ID do programa shader OpenGL
+	std::string vertexPath, fragmentPath; // Arquivos de origem (para reload())
+	std::string vertexHeader;							// Código inserido no vertex shader após o #version
+	std::string fragmentHeader;						// Idem, no fragment shader
+
+	std::vector<ShaderUniform> uniforms;	 // Uniformes ativas, ordenadas por nome
+	std::vector<std::string> slotNames;		 // Uniformes pedidas por uniform<T>()
+	std::vector<GLint> slotLocations;			 // Localização de cada uma no programa atual (-1: inativa)
+	std::vector<ShaderBlockBinding> blocks; // Blocos pedidos por bindUniformBlock()
+
+	void reflectUniforms(); // Lê as uniformes ativas e refaz as localizações das alças e os blocos
+	void applyBlockBinding(const ShaderBlockBinding &block);
+	int registerSlot(const std::string &name, GLenum type);
 
 public:
-	// Construtor que recebe os caminhos para os arquivos de vertex e fragment shader
-	Shader(std::string vertexShaderPath, std::string fragmentShaderPath);
+	// Construtor que recebe os caminhos para os arquivos de vertex e fragment shader.
+	// vertexShaderHeader / fragmentShaderHeader (opcionais) são inseridos logo após a linha
+	// #version de cada um, ex.: as entradas geradas por um VertexLayout ou os #define de
+	// constantes que o C++ também usa
+	Shader(std::string vertexShaderPath, std::string fragmentShaderPath, std::string vertexShaderHeader = "",
+				 std::string fragmentShaderHeader = "");
 
 	// Método para configurar a uniforme de textura no shader (para a unidade de textura 0)
 	void setTextureUniform();
 
-	// Método getter para obter o ID do programa shader
+	// Uniformes ativas do programa atual
+	const std::vector<ShaderUniform> &getUniforms() const { return uniforms; }
+
+	// Localização de uma uniforme ativa (busca binária na tabela refletida; -1 se não existe)
+	GLint uniformLocation(const std::string &name) const;
+
+	// Alça para a uniforme "name" (a mesma se pedida de novo). Avisa no console se o tipo no
+	// shader não corresponde a T; uniformes inativas dão uma alça que não faz nada
+	template <typename T>
+	Uniform<T> uniform(const std::string &name);
+
+	// Aponta o bloco uniforme "name" para o binding point (refeito a cada reload()). Avisa no
+	// console se o tamanho do bloco no shader difere de expectedSize (layout diferente do
+	// struct C++); programas que não usam o bloco são ignorados
+	void bindUniformBlock(const std::string &name, GLuint binding, GLint expectedSize);
+
+	// Setters com alças: valem para o programa em uso (glUseProgram(getId()))
+	void set(Uniform<int> uniform, int value) const { glUniform1i(slotLocations[uniform.slot], value); }
+	void set(Uniform<float> uniform, float value) const { glUniform1f(slotLocations[uniform.slot], value); }
+	void set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const
+	{
+		glUniform3f(slotLocations[uniform.slot], value.x, value.y, value.z);
+	}
+	void set(Uniform<glm::vec3> uniform, const float *value) const { glUniform3fv(slotLocations[uniform.slot], 1, value); }
+	void set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const
+	{
+		glUniform4f(slotLocations[uniform.slot], value.x, value.y, value.z, value.w);
+	}
+	void set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const
+	{
+		glUniformMatrix4fv(slotLocations[uniform.slot], 1, GL_FALSE, &value[0][0]);
+	}
+
+	// Recompila a partir dos mesmos arquivos; se falhar, mantém o programa atual e devolve false.
+	// Os valores das uniformes não são preservados
+	bool reload();
+
+	// Métodos getter para obter o ID do programa shader e os arquivos de origem
 	GLuint getId() { return id; }
-};
\ No newline at end of file
+	const std::string &getVertexPath() const { return vertexPath; }
+	const std::string &getFragmentPath() const { return fragmentPath; }
+};
+
+// Tipo GLSL esperado para cada tipo de alça (int também aceita bool e samplers)
+template <typename T>
+struct UniformType;
+template <>
+struct UniformType<int>
+{
+	static const GLenum value = GL_INT;
+};
+template <>
+struct UniformType<float>
+{
+	static const GLenum value = GL_FLOAT;
+};
+template <>
+struct UniformType<glm::vec3>
+{
+	static const GLenum value = GL_FLOAT_VEC3;
+};
+template <>
+struct UniformType<glm::vec4>
+{
+	static const GLenum value = GL_FLOAT_VEC4;
+};
+template <>
+struct UniformType<glm::mat4>
+{
+	static const GLenum value = GL_FLOAT_MAT4;
+};
+
+template <typename T>
+Uniform<T> Shader::uniform(const std::string &name)
+{
+	Uniform<T> handle;
+	handle.slot = registerSlot(name, UniformType<T>::value);
+	return handle;
+}
\ No newline at end of file
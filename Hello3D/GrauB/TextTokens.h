@@ -0,0 +1,44 @@
+// TextTokens.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <charconv> // std::from_chars (conversão de float sem alocação e sem locale)
+
+/*****************************************************************************************
+ *  Funções auxiliares de tokenização (usadas pelos leitores de .obj e de Scene.txt)
+ *  --------------------------------------------------------------------------------------
+ *  Todas recebem um ponteiro para a posição atual e o fim do buffer, e devolvem a nova
+ *  posição. Nenhuma delas cria std::string ou depende do locale do processo.
+ *****************************************************************************************/
+inline bool isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char *skipBlanks(const char *p, const char *end)
+{
+	while (p < end && isBlank(*p))
+		++p;
+	return p;
+}
+
+inline const char *skipToken(const char *p, const char *end)
+{
+	while (p < end && !isBlank(*p))
+		++p;
+	return p;
+}
+
+/* Lê um float; em caso de erro devolve 0 (como o operator>> de um istringstream) */
+inline const char *parseFloat(const char *p, const char *end, float &out)
+{
+	p = skipBlanks(p, end);
+	if (p < end && *p == '+')
+		++p;
+	std::from_chars_result res = std::from_chars(p, end, out);
+	if (res.ec != std::errc())
+	{
+		out = 0.0f;
+		return res.ptr == p ? skipToken(p, end) : res.ptr;
+	}
+	return res.ptr;
+}
@@ -0,0 +1,321 @@
+// TextureCompressor.cpp
+#include "TextureCompressor.h" // Inclui o arquivo de cabeçalho do compressor de texturas
+
+#include <algorithm> // std::min / std::max
+#include <cmath>		 // std::sqrt / std::fabs
+#include <cstdlib>	 // std::abs
+
+size_t blockBytes(TextureFormat format)
+{
+	switch (format)
+	{
+	case TextureFormat::BC1:
+		return 8;
+	case TextureFormat::BC3:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+size_t levelBytes(TextureFormat format, unsigned int width, unsigned int height, unsigned int channels)
+{
+	if (format == TextureFormat::Raw)
+		return static_cast<size_t>(width) * height * channels;
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+/*****************************************************************************************
+ *  Funções auxiliares de cor 5:6:5
+ *****************************************************************************************/
+static inline unsigned short pack565(const float c[3])
+{
+	int r = static_cast<int>(std::min(255.0f, std::max(0.0f, c[0])) * 31.0f / 255.0f + 0.5f);
+	int g = static_cast<int>(std::min(255.0f, std::max(0.0f, c[1])) * 63.0f / 255.0f + 0.5f);
+	int b = static_cast<int>(std::min(255.0f, std::max(0.0f, c[2])) * 31.0f / 255.0f + 0.5f);
+	return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+}
+
+/* Expande 5:6:5 para 8 bits por canal, como o hardware faz ao decodificar */
+static inline void unpack565(unsigned short c, int out[3])
+{
+	int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+/* Paleta de 4 cores do modo opaco (color0 > color1) */
+static void buildPalette(unsigned short c0, unsigned short c1, int palette[4][3])
+{
+	unpack565(c0, palette[0]);
+	unpack565(c1, palette[1]);
+	for (int k = 0; k < 3; ++k)
+	{
+		palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+		palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+	}
+}
+
+/* Escolhe o índice mais próximo para cada texel; devolve os 32 bits de índices e o erro total */
+static unsigned int matchIndices(const unsigned char *rgba, const int palette[4][3], unsigned int *error)
+{
+	unsigned int indices = 0, total = 0;
+	for (int i = 0; i < 16; ++i)
+	{
+		const unsigned char *p = rgba + i * 4;
+		unsigned int best = 0, bestDistance = ~0u;
+		for (unsigned int k = 0; k < 4; ++k)
+		{
+			int dr = p[0] - palette[k][0], dg = p[1] - palette[k][1], db = p[2] - palette[k][2];
+			unsigned int distance = static_cast<unsigned int>(dr * dr + dg * dg + db * db);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				best = k;
+			}
+		}
+		indices |= best << (2 * i);
+		total += bestDistance;
+	}
+	*error = total;
+	return indices;
+}
+
+/*****************************************************************************************
+ *  encodeColorBlock()
+ *  --------------------------------------------------------------------------------------
+ *  Bloco de cor BC1 (também usado na metade de cor do BC3), sempre no modo de 4 cores:
+ *  1. Eixo principal das cores do bloco (covariância + iteração de potência).
+ *  2. Extremos = projeções mínima/máxima sobre o eixo, quantizados em 5:6:5.
+ *  3. Um refinamento por mínimos quadrados dos extremos a partir dos índices escolhidos;
+ *     mantém o resultado só se o erro diminuir.
+ *****************************************************************************************/
+static void encodeColorBlock(const unsigned char *rgba, unsigned char *out)
+{
+	float mean[3] = {0, 0, 0};
+	for (int i = 0; i < 16; ++i)
+		for (int k = 0; k < 3; ++k)
+			mean[k] += rgba[i * 4 + k];
+	for (int k = 0; k < 3; ++k)
+		mean[k] /= 16.0f;
+
+	float cov[6] = {0, 0, 0, 0, 0, 0}; // rr rg rb gg gb bb
+	for (int i = 0; i < 16; ++i)
+	{
+		float r = rgba[i * 4] - mean[0], g = rgba[i * 4 + 1] - mean[1], b = rgba[i * 4 + 2] - mean[2];
+		cov[0] += r * r;
+		cov[1] += r * g;
+		cov[2] += r * b;
+		cov[3] += g * g;
+		cov[4] += g * b;
+		cov[5] += b * b;
+	}
+
+	float axis[3] = {1.0f, 1.0f, 1.0f};
+	for (int iteration = 0; iteration < 8; ++iteration)
+	{
+		float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+		float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+		float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+		float length = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+		if (length < 1e-6f)
+			break; // Bloco de cor única: qualquer eixo serve
+		axis[0] = x / length;
+		axis[1] = y / length;
+		axis[2] = z / length;
+	}
+	float norm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+	for (int k = 0; k < 3; ++k)
+		axis[k] /= norm;
+
+	float minT = 0.0f, maxT = 0.0f;
+	for (int i = 0; i < 16; ++i)
+	{
+		float t = (rgba[i * 4] - mean[0]) * axis[0] + (rgba[i * 4 + 1] - mean[1]) * axis[1] +
+							(rgba[i * 4 + 2] - mean[2]) * axis[2];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	float e0[3], e1[3];
+	for (int k = 0; k < 3; ++k)
+	{
+		e0[k] = mean[k] + axis[k] * maxT;
+		e1[k] = mean[k] + axis[k] * minT;
+	}
+
+	unsigned short c0 = pack565(e0), c1 = pack565(e1);
+	int palette[4][3];
+	buildPalette(c0, c1, palette);
+	unsigned int error;
+	unsigned int indices = matchIndices(rgba, palette, &error);
+
+	/* Refinamento: cada texel é w*A + (1-w)*B, com w dado pelo índice escolhido */
+	static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+	float aa = 0, ab = 0, bb = 0, ax[3] = {0, 0, 0}, bx[3] = {0, 0, 0};
+	for (int i = 0; i < 16; ++i)
+	{
+		float w = weights[(indices >> (2 * i)) & 3], v = 1.0f - w;
+		aa += w * w;
+		ab += w * v;
+		bb += v * v;
+		for (int k = 0; k < 3; ++k)
+		{
+			ax[k] += w * rgba[i * 4 + k];
+			bx[k] += v * rgba[i * 4 + k];
+		}
+	}
+	float det = aa * bb - ab * ab;
+	if (std::fabs(det) > 1e-6f)
+	{
+		float a[3], b[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			a[k] = (ax[k] * bb - bx[k] * ab) / det;
+			b[k] = (bx[k] * aa - ax[k] * ab) / det;
+		}
+		unsigned short r0 = pack565(a), r1 = pack565(b);
+		int refined[4][3];
+		buildPalette(r0, r1, refined);
+		unsigned int refinedError;
+		unsigned int refinedIndices = matchIndices(rgba, refined, &refinedError);
+		if (refinedError < error)
+		{
+			c0 = r0;
+			c1 = r1;
+			indices = refinedIndices;
+		}
+	}
+
+	/* O modo de 4 cores exige color0 > color1: troca os extremos e remapeia 0<->1, 2<->3 */
+	if (c0 < c1)
+	{
+		std::swap(c0, c1);
+		indices ^= 0x55555555u;
+	}
+	else if (c0 == c1)
+		indices = 0;
+
+	out[0] = static_cast<unsigned char>(c0 & 0xFF);
+	out[1] = static_cast<unsigned char>(c0 >> 8);
+	out[2] = static_cast<unsigned char>(c1 & 0xFF);
+	out[3] = static_cast<unsigned char>(c1 >> 8);
+	for (int k = 0; k < 4; ++k)
+		out[4 + k] = static_cast<unsigned char>(indices >> (8 * k));
+}
+
+/*****************************************************************************************
+ *  encodeAlphaBlock()
+ *  --------------------------------------------------------------------------------------
+ *  Bloco de alfa do BC3: extremos = alfa máximo e mínimo (modo de 8 valores), índice de
+ *  3 bits do valor mais próximo para cada texel.
+ *****************************************************************************************/
+static void encodeAlphaBlock(const unsigned char *rgba, unsigned char *out)
+{
+	int a0 = 0, a1 = 255;
+	for (int i = 0; i < 16; ++i)
+	{
+		a0 = std::max(a0, static_cast<int>(rgba[i * 4 + 3]));
+		a1 = std::min(a1, static_cast<int>(rgba[i * 4 + 3]));
+	}
+
+	unsigned long long indices = 0;
+	if (a0 != a1)
+	{
+		int palette[8] = {a0, a1};
+		for (int k = 1; k < 7; ++k)
+			palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+		for (int i = 0; i < 16; ++i)
+		{
+			int alpha = rgba[i * 4 + 3], best = 0, bestDistance = 256;
+			for (int k = 0; k < 8; ++k)
+			{
+				int distance = std::abs(alpha - palette[k]);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = k;
+				}
+			}
+			indices |= static_cast<unsigned long long>(best) << (3 * i);
+		}
+	}
+
+	out[0] = static_cast<unsigned char>(a0);
+	out[1] = static_cast<unsigned char>(a1);
+	for (int k = 0; k < 6; ++k)
+		out[2 + k] = static_cast<unsigned char>(indices >> (8 * k));
+}
+
+void compressBlockBC1(const unsigned char *rgba, unsigned char *out)
+{
+	encodeColorBlock(rgba, out);
+}
+
+void compressBlockBC3(const unsigned char *rgba, unsigned char *out)
+{
+	encodeAlphaBlock(rgba, out);
+	encodeColorBlock(rgba, out + 8);
+}
+
+/*****************************************************************************************
+ *  compressTexture()
+ *  --------------------------------------------------------------------------------------
+ *  Percorre cada nível em blocos 4x4 (bordas repetem a última linha/coluna), monta o
+ *  bloco em RGBA e grava o resultado em um novo buffer com os mesmos níveis.
+ *****************************************************************************************/
+void compressTexture(TextureImage &image)
+{
+	if (image.format != TextureFormat::Raw || (image.channels != 3 && image.channels != 4))
+		return;
+
+	const TextureFormat format = (image.channels == 3) ? TextureFormat::BC1 : TextureFormat::BC3;
+	const size_t bytesPerBlock = blockBytes(format);
+	const unsigned int c = image.channels;
+
+	std::vector<TextureLevel> levels(image.levels.size());
+	size_t total = 0;
+	for (size_t l = 0; l < levels.size(); ++l)
+	{
+		levels[l].width = image.levels[l].width;
+		levels[l].height = image.levels[l].height;
+		levels[l].offset = total;
+		levels[l].size = levelBytes(format, levels[l].width, levels[l].height, c);
+		total += levels[l].size;
+	}
+
+	std::vector<unsigned char> blocks(total);
+	unsigned char rgba[64];
+	for (size_t l = 0; l < levels.size(); ++l)
+	{
+		const TextureLevel &src = image.levels[l];
+		const unsigned char *in = image.pixels.data() + src.offset;
+		unsigned char *out = blocks.data() + levels[l].offset;
+
+		for (unsigned int by = 0; by < src.height; by += 4)
+			for (unsigned int bx = 0; bx < src.width; bx += 4)
+			{
+				for (unsigned int y = 0; y < 4; ++y)
+					for (unsigned int x = 0; x < 4; ++x)
+					{
+						unsigned int sx = std::min(bx + x, src.width - 1), sy = std::min(by + y, src.height - 1);
+						const unsigned char *p = in + (static_cast<size_t>(sy) * src.width + sx) * c;
+						unsigned char *q = rgba + (y * 4 + x) * 4;
+						q[0] = p[0];
+						q[1] = p[1];
+						q[2] = p[2];
+						q[3] = (c == 4) ? p[3] : 255;
+					}
+
+				if (format == TextureFormat::BC1)
+					compressBlockBC1(rgba, out);
+				else
+					compressBlockBC3(rgba, out);
+				out += bytesPerBlock;
+			}
+	}
+
+	image.format = format;
+	image.levels.swap(levels);
+	image.pixels.swap(blocks);
+}
@@ -0,0 +1,21 @@
+// TextureCompressor.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+
+#include "TextureLoader.h" // TextureImage / TextureFormat
+
+// Bytes de um bloco 4x4 no formato indicado (0 para Raw)
+size_t blockBytes(TextureFormat format);
+
+// Bytes de um nível w x h no formato indicado (blocos parciais nas bordas contam inteiros)
+size_t levelBytes(TextureFormat format, unsigned int width, unsigned int height, unsigned int channels);
+
+// Comprime um bloco 4x4 RGBA (64 bytes, linha a linha) em BC1 (8 bytes, alfa ignorado)
+void compressBlockBC1(const unsigned char *rgba, unsigned char *out);
+
+// Comprime um bloco 4x4 RGBA (64 bytes, linha a linha) em BC3 (16 bytes: alfa + cor)
+void compressBlockBC3(const unsigned char *rgba, unsigned char *out);
+
+// Converte todos os níveis de uma imagem Raw: RGB -> BC1, RGBA -> BC3
+void compressTexture(TextureImage &image);
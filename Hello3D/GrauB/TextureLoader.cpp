@@ -0,0 +1,203 @@
+// TextureLoader.cpp
+
+// *** IMPLEMENTAÇÃO DA STB_IMAGE *** -----------------------------------------
+// Define que o arquivo stb_image.h incluirá apenas a implementação necessária
+// nesta tradução‑unit. Deve vir *antes* da inclusão do cabeçalho.
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../Common/include/stb_image.h"
+
+#include "TextureLoader.h" // Inclui o arquivo de cabeçalho do carregador de texturas
+
+#include <algorithm> // std::max
+#include <cstring>	 // memcpy
+#include <iostream>	 // Saída de dados no console
+#include <mutex>		 // std::call_once
+
+#include "MappedFile.h" // Leitura do arquivo de imagem
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // Intrínsecos SSE2
+#define TEXTURE_MIPS_SSE2
+#endif
+
+/*****************************************************************************************
+ *  decodeTexture()
+ *  --------------------------------------------------------------------------------------
+ *  Decodifica uma imagem (já em memória) com stb_image e preenche o nível 0 de "image".
+ *  Aceita imagens RGB ou RGBA (outros formatos são convertidos para RGBA); em seguida
+ *  gera a cadeia de mipmaps na CPU.
+ *****************************************************************************************/
+bool decodeTexture(const unsigned char *data, size_t size, const std::string &name, TextureImage &image)
+{
+	/* Ajusta origem da imagem; a flag é global na stb_image, então é escrita uma única vez
+	   (decodeTexture() roda em várias threads ao mesmo tempo) */
+	static std::once_flag flipOnce;
+	std::call_once(flipOnce, []
+								 { stbi_set_flip_vertically_on_load(true); });
+
+	int w, h, channels;
+	unsigned char *pixels = stbi_load_from_memory(data, static_cast<int>(size), &w, &h, &channels, 0);
+	if (pixels && channels != 3 && channels != 4)
+	{
+		stbi_image_free(pixels);
+		pixels = stbi_load_from_memory(data, static_cast<int>(size), &w, &h, &channels, 4);
+		channels = 4;
+	}
+	if (!pixels)
+	{
+		std::cerr << "Falha ao carregar a textura " << name << std::endl;
+		return false;
+	}
+
+	image.width = static_cast<unsigned int>(w);
+	image.height = static_cast<unsigned int>(h);
+	image.channels = static_cast<unsigned int>(channels);
+	size_t level0 = static_cast<size_t>(w) * h * channels;
+	image.pixels.assign(pixels, pixels + level0);
+	image.levels.assign(1, TextureLevel{image.width, image.height, 0, level0});
+	stbi_image_free(pixels);
+
+	buildMipChain(image);
+	return true;
+}
+
+/* Versão que lê o arquivo indicado (mapeado em memória) */
+bool decodeTexture(const std::string path, TextureImage &image)
+{
+	MappedFile file(path);
+	if (!file.isOpen())
+	{
+		std::cerr << "Falha ao carregar a textura " << path << std::endl;
+		return false;
+	}
+	return decodeTexture(reinterpret_cast<const unsigned char *>(file.data()), file.size(), path, image);
+}
+
+/*****************************************************************************************
+ *  downsampleRow()
+ *  --------------------------------------------------------------------------------------
+ *  Caso comum (largura de origem par): cada texel de saída é a média das colunas 2x e
+ *  2x+1 das linhas r0 e r1. Com SSE2 a soma vertical é feita 16 bytes por vez; em RGBA
+ *  a soma horizontal também (4 texels de saída por iteração). O arredondamento é o
+ *  mesmo do caminho escalar, (soma + 2) / 4, então o resultado é idêntico bit a bit.
+ *  "sums" é um rascunho com espaço para 2 * width * c valores.
+ *****************************************************************************************/
+static void downsampleRow(const unsigned char *r0, const unsigned char *r1, unsigned char *out,
+													unsigned int width, unsigned int c, unsigned short *sums)
+{
+	const unsigned int srcBytes = 2 * width * c;
+	unsigned int i = 0;
+#ifdef TEXTURE_MIPS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	if (c == 4)
+	{
+		const __m128i two = _mm_set1_epi16(2);
+		for (; i + 32 <= srcBytes; i += 32)
+		{
+			__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + i));
+			__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + i + 16));
+			__m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + i));
+			__m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + i + 16));
+
+			/* Soma vertical em 16 bits: cada registrador guarda 2 texels RGBA */
+			__m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero)); // texels 0, 1
+			__m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero)); // texels 2, 3
+			__m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero)); // texels 4, 5
+			__m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero)); // texels 6, 7
+
+			/* Soma horizontal: pares (0+1, 2+3) e (4+5, 6+7) */
+			__m128i h0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+			__m128i h1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+			h0 = _mm_srli_epi16(_mm_add_epi16(h0, two), 2);
+			h1 = _mm_srli_epi16(_mm_add_epi16(h1, two), 2);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2), _mm_packus_epi16(h0, h1));
+		}
+	}
+	else
+	{
+		for (; i + 16 <= srcBytes; i += 16)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(sums + i),
+											 _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(sums + i + 8),
+											 _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+		}
+		for (unsigned int k = i; k < srcBytes; ++k)
+			sums[k] = static_cast<unsigned short>(r0[k] + r1[k]);
+		for (unsigned int x = 0; x < width; ++x, out += c, sums += 2 * c)
+			for (unsigned int ch = 0; ch < c; ++ch)
+				out[ch] = static_cast<unsigned char>((sums[ch] + sums[c + ch] + 2) / 4);
+		return;
+	}
+#else
+	(void)sums;
+#endif
+	/* Escalar: o que sobrou (ou tudo, sem SSE2) */
+	for (unsigned int x = i / (2 * c); x < width; ++x)
+		for (unsigned int ch = 0; ch < c; ++ch)
+		{
+			unsigned int a = 2 * x * c + ch, b = a + c;
+			out[x * c + ch] = static_cast<unsigned char>((r0[a] + r0[b] + r1[a] + r1[b] + 2) / 4);
+		}
+}
+
+/*****************************************************************************************
+ *  buildMipChain()
+ *  --------------------------------------------------------------------------------------
+ *  Cada nível é a média 2x2 do anterior (dimensões ímpares repetem a última linha/
+ *  coluna), até chegar a 1x1. O mesmo resultado que glGenerateMipmap produziria, mas
+ *  calculado uma única vez e guardado junto com a textura. Níveis de largura par usam
+ *  downsampleRow() (SSE2); bordas ímpares caem no laço genérico com repetição.
+ *****************************************************************************************/
+void buildMipChain(TextureImage &image)
+{
+	const unsigned int c = image.channels;
+	image.levels.resize(1);
+
+	/* Reserva espaço para todos os níveis antes de escrever (evita realocações) */
+	size_t total = image.levels[0].size;
+	for (unsigned int w = image.width, h = image.height; w > 1 || h > 1;)
+	{
+		w = std::max(1u, w / 2);
+		h = std::max(1u, h / 2);
+		total += static_cast<size_t>(w) * h * c;
+	}
+	image.pixels.resize(total);
+	std::vector<unsigned short> sums(static_cast<size_t>(image.width) * c + 16);
+
+	while (image.levels.back().width > 1 || image.levels.back().height > 1)
+	{
+		const TextureLevel src = image.levels.back();
+		TextureLevel dst;
+		dst.width = std::max(1u, src.width / 2);
+		dst.height = std::max(1u, src.height / 2);
+		dst.offset = src.offset + src.size;
+		dst.size = static_cast<unsigned long long>(dst.width) * dst.height * c;
+
+		const unsigned char *in = image.pixels.data() + src.offset;
+		unsigned char *out = image.pixels.data() + dst.offset;
+		for (unsigned int y = 0; y < dst.height; ++y)
+		{
+			unsigned int y0 = std::min(2 * y, src.height - 1), y1 = std::min(2 * y + 1, src.height - 1);
+			if (src.width == 2 * dst.width)
+			{
+				downsampleRow(in + y0 * src.width * c, in + y1 * src.width * c, out + y * dst.width * c, dst.width, c,
+											sums.data());
+				continue;
+			}
+			for (unsigned int x = 0; x < dst.width; ++x)
+			{
+				unsigned int x0 = std::min(2 * x, src.width - 1), x1 = std::min(2 * x + 1, src.width - 1);
+				for (unsigned int k = 0; k < c; ++k)
+				{
+					unsigned int sum = in[(y0 * src.width + x0) * c + k] + in[(y0 * src.width + x1) * c + k] +
+														 in[(y1 * src.width + x0) * c + k] + in[(y1 * src.width + x1) * c + k];
+					out[(y * dst.width + x) * c + k] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+		image.levels.push_back(dst);
+	}
+}
@@ -0,0 +1,38 @@
+// TextureLoader.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <string> // Necessário para usar std::string
+#include <vector> // Necessário para usar std::vector
+
+// Um nível de mipmap dentro do bloco de pixels de uma textura
+struct TextureLevel
+{
+	unsigned int width, height;			// Dimensões do nível
+	unsigned long long offset, size; // Posição e tamanho (bytes) dentro de "pixels"
+};
+
+// Formato dos pixels de uma textura na CPU (e na GPU)
+enum class TextureFormat : unsigned int
+{
+	Raw = 0, // channels bytes por texel (GL_RGB / GL_RGBA)
+	BC1 = 1, // 8 bytes por bloco 4x4, sem alfa (GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+	BC3 = 3	 // 16 bytes por bloco 4x4, com alfa (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+};
+
+// Imagem decodificada na CPU com a cadeia de mipmaps completa, pronta para upload
+struct TextureImage
+{
+	unsigned int width = 0, height = 0, channels = 0;	// Dimensões do nível 0 e canais (3 = RGB, 4 = RGBA)
+	TextureFormat format = TextureFormat::Raw;				// Raw ou comprimida em blocos
+	std::vector<TextureLevel> levels;									// Nível 0 até 1x1
+	std::vector<unsigned char> pixels;								// Todos os níveis, em sequência
+};
+
+// Decodifica a imagem com stb_image (origem no canto inferior esquerdo) e gera os mipmaps
+bool decodeTexture(const std::string path, TextureImage &image);
+
+// Igual, a partir do conteúdo do arquivo já em memória ("name" só aparece em mensagens de erro)
+bool decodeTexture(const unsigned char *data, size_t size, const std::string &name, TextureImage &image);
+
+// Gera os níveis 1..N a partir do nível 0 com filtro de caixa 2x2
+void buildMipChain(TextureImage &image);
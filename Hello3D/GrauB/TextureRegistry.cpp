@@ -0,0 +1,465 @@
+// TextureRegistry.cpp
+#include "TextureRegistry.h" // Inclui o arquivo de cabeçalho do registro de texturas
+
+#include <algorithm> // std::min / std::remove_if
+#include <cstring>	 // memcpy
+#include <iostream>	 // Saída de dados no console
+#include <thread>		 // std::this_thread::yield
+
+#include "GLExtensions.h"			 // Formatos S3TC
+#include "MappedFile.h"				 // Leitura da imagem para calcular o hash
+#include "TextureCompressor.h" // Tamanho dos blocos BC1/BC3
+
+/* Formato interno OpenGL de uma textura comprimida */
+static GLenum compressedFormat(TextureFormat format)
+{
+	return (format == TextureFormat::BC1) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
+/*****************************************************************************************
+ *  allocateTexture()
+ *  --------------------------------------------------------------------------------------
+ *  Cria o objeto de textura com todos os níveis de mipmap alocados (sem dados); os
+ *  pixels chegam depois, em fatias, por uploadSlices(). Aceita imagens RGB ou RGBA,
+ *  cruas ou em blocos BC1/BC3; os mipmaps já vêm prontos da CPU, então não há
+ *  glGenerateMipmap. Com glTexStorage2D a cadeia é imutável e alocada de uma vez (o
+ *  driver não precisa revalidar a textura a cada nível); sem ele, um glTexImage2D por nível.
+ *  Deve ser chamada sem PBO vinculado (senão o ponteiro nulo viraria offset 0 do PBO).
+ *****************************************************************************************/
+static void allocateTexture(const TextureView &view, SharedTexture &texture)
+{
+	glGenTextures(1, &texture.texture);
+	glBindTexture(GL_TEXTURE_2D, texture.texture);
+
+	/* Parâmetros de wrapping e filtragem */
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	GLenum fmt = (view.channels == 3) ? GL_RGB : GL_RGBA;
+	texture.gpuBytes = 0;
+	for (unsigned int level = 0; level < view.levelCount; ++level)
+		texture.gpuBytes += view.levels[level].size;
+
+	if (ext_glTexStorage2D)
+	{
+		GLenum internalFormat = (view.channels == 3) ? GL_RGB8 : GL_RGBA8;
+		if (view.format != TextureFormat::Raw)
+			internalFormat = compressedFormat(view.format);
+		ext_glTexStorage2D(GL_TEXTURE_2D, view.levelCount, internalFormat, view.width, view.height);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return;
+	}
+
+	for (unsigned int level = 0; level < view.levelCount; ++level)
+	{
+		const TextureLevel &lv = view.levels[level];
+		if (view.format == TextureFormat::Raw)
+			glTexImage2D(GL_TEXTURE_2D, level, fmt, lv.width, lv.height, 0, fmt, GL_UNSIGNED_BYTE, nullptr);
+		else
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, compressedFormat(view.format), lv.width, lv.height, 0,
+														 static_cast<GLsizei>(lv.size), nullptr);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, view.levelCount - 1);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::reserve()
+ *  --------------------------------------------------------------------------------------
+ *  Caminho canônico já visto: só incrementa refCount (mesmo que ainda esteja carregando)
+ *  e devolve false. Caso contrário reserva um slot, que usa o placeholder até os pixels
+ *  chegarem, e devolve true. Caminho vazio (material sem textura): INVALID_TEXTURE.
+ *****************************************************************************************/
+bool TextureRegistry::reserve(const std::string &imagePath, TextureId &id)
+{
+	/* Material sem textura: nada a carregar nem a contar */
+	if (imagePath.empty())
+	{
+		id = INVALID_TEXTURE;
+		return false;
+	}
+
+	/* Placeholder 1x1 branco: a malha aparece só com a cor do material até a textura chegar */
+	if (placeholder == 0)
+	{
+		const unsigned char white[4] = {255, 255, 255, 255};
+		glGenTextures(1, &placeholder);
+		glBindTexture(GL_TEXTURE_2D, placeholder);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	std::string path = canonicalPath(imagePath);
+
+	auto pathIt = byPath.find(path);
+	if (pathIt != byPath.end())
+	{
+		++pathHits;
+		++entries[pathIt->second].refCount;
+		id = pathIt->second;
+		return false;
+	}
+
+	/* Reaproveita um slot liberado, se houver */
+	id = 0;
+	while (id < entries.size() && entries[id].refCount != 0)
+		++id;
+	if (id == entries.size())
+		entries.push_back(SharedTexture{});
+
+	SharedTexture &texture = entries[id];
+	unsigned int generation = texture.generation;
+	texture = SharedTexture{};
+	texture.path = path;
+	texture.state = TextureState::Decoding;
+	texture.alias = INVALID_TEXTURE;
+	texture.generation = generation;
+	texture.refCount = 1;
+	byPath[path] = id;
+	return true;
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::acquire()
+ *  --------------------------------------------------------------------------------------
+ *  1. reserve(): acerto por caminho ou um slot novo.
+ *  2. Slot novo: enfileira a decodificação. As buscas por hash do arquivo e dos pixels
+ *     acontecem quando o resultado chega, em finishDecode().
+ *****************************************************************************************/
+TextureId TextureRegistry::acquire(const std::string &imagePath)
+{
+	TextureId id;
+	if (!reserve(imagePath, id))
+		return id;
+	unsigned int generation = entries[id].generation;
+
+	/* Thread de trabalho: mapeia, calcula o hash e decodifica (ou lê do cache de assets) */
+	++inFlight;
+	workers.submit([this, id, generation, imagePath]
+								 {
+		Decoded result{id, generation, false, 0, 0, std::make_shared<AssetBlob>(), TextureView{}};
+		MappedFile source(imagePath);
+		if (source.isOpen())
+		{
+			result.sourceHash = hashAsset(source);
+			result.ok = loadTextureAsset(source, result.sourceHash, imagePath, *result.blob, result.view, compress);
+			if (result.ok)
+				result.pixelHash = hashTexturePixels(result.view);
+		}
+		else
+			std::cerr << "Falha ao carregar a textura " << imagePath << std::endl;
+
+		decoded.push(std::move(result)); });
+	return id;
+}
+
+/* Versão para pixels já prontos (ex.: pacote de cena): pula a decodificação, mas não a deduplicação */
+TextureId TextureRegistry::acquire(const std::string &imagePath, unsigned long long sourceHash,
+																	 unsigned long long pixelHash, const TextureView &view,
+																	 std::shared_ptr<AssetBlob> blob)
+{
+	TextureId id;
+	if (!reserve(imagePath, id))
+		return id;
+
+	Decoded result{id, entries[id].generation, true, sourceHash, pixelHash, std::move(blob), view};
+	finishDecode(result);
+	return id;
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::finishDecode()
+ *  --------------------------------------------------------------------------------------
+ *  Recebe uma decodificação concluída (thread do OpenGL):
+ *    - slot liberado/reusado nesse meio tempo -> descarta;
+ *    - mesmo arquivo ou mesmos pixels de uma textura existente -> vira apelido dela;
+ *    - caso contrário, entra na fila de envio para a GPU.
+ *****************************************************************************************/
+void TextureRegistry::finishDecode(Decoded &result)
+{
+	if (result.id >= entries.size())
+		return;
+	SharedTexture &texture = entries[result.id];
+	if (texture.refCount == 0 || texture.generation != result.generation)
+		return;
+
+	if (!result.ok)
+	{
+		texture.state = TextureState::Failed;
+		++failures;
+		return;
+	}
+	texture.sourceHash = result.sourceHash;
+	texture.pixelHash = result.pixelHash;
+
+	TextureId target = INVALID_TEXTURE;
+	auto sourceIt = bySource.find(result.sourceHash);
+	if (sourceIt != bySource.end())
+	{
+		++sourceHits;
+		target = sourceIt->second;
+	}
+	else
+	{
+		auto pixelIt = byPixels.find(result.pixelHash);
+		if (pixelIt != byPixels.end())
+		{
+			++pixelHits;
+			target = pixelIt->second;
+			bySource[result.sourceHash] = target;
+		}
+	}
+	if (target != INVALID_TEXTURE)
+	{
+		texture.alias = target; // O apelido segura uma referência do alvo
+		++entries[target].refCount;
+		return;
+	}
+
+	++misses;
+	texture.width = result.view.width;
+	texture.height = result.view.height;
+	texture.state = TextureState::Uploading;
+	bySource[result.sourceHash] = result.id;
+	byPixels[result.pixelHash] = result.id;
+	uploads.push_back(Upload{result.id, result.blob, result.view, 0, 0});
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::uploadSlices()
+ *  --------------------------------------------------------------------------------------
+ *  Copia até TEXTURE_UPLOAD_BUDGET bytes de linhas pendentes (de uma ou mais texturas,
+ *  na ordem da fila) para o PBO e emite um glTexSubImage2D por fatia. Em texturas
+ *  comprimidas a "linha" é uma fileira de blocos 4x4 (glCompressedTexSubImage2D). O PBO é "órfão" a
+ *  cada quadro (glBufferData com nullptr), então a cópia nunca espera a GPU terminar de
+ *  ler o quadro anterior; o driver faz a transferência de forma assíncrona.
+ *****************************************************************************************/
+void TextureRegistry::uploadSlices()
+{
+	if (uploads.empty())
+		return;
+
+	/* Aloca as texturas que vão receber dados (antes de vincular o PBO) */
+	for (Upload &upload : uploads)
+		if (entries[upload.id].texture == 0)
+			allocateTexture(upload.view, entries[upload.id]);
+
+	struct Slice
+	{
+		GLuint texture;
+		GLint level, y;
+		GLsizei width, height;
+		TextureFormat format;
+		GLenum glFormat;
+		size_t offset, size;
+	};
+	std::vector<Slice> slices;
+
+	if (pbo == 0)
+		glGenBuffers(1, &pbo);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, TEXTURE_UPLOAD_BUDGET, nullptr, GL_STREAM_DRAW);
+	unsigned char *staging = static_cast<unsigned char *>(
+			glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, TEXTURE_UPLOAD_BUDGET,
+											 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	if (!staging)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return;
+	}
+
+	size_t used = 0;
+	while (!uploads.empty())
+	{
+		Upload &upload = uploads.front();
+		SharedTexture &texture = entries[upload.id];
+		const TextureLevel &lv = upload.view.levels[upload.level];
+		const TextureFormat format = upload.view.format;
+		const bool raw = (format == TextureFormat::Raw);
+		const unsigned int rowHeight = raw ? 1 : 4;					// Linhas de texels por "linha" copiada
+		const unsigned int rowCount = (lv.height + rowHeight - 1) / rowHeight;
+		const size_t rowBytes = levelBytes(format, lv.width, rowHeight, upload.view.channels);
+		unsigned int rows = static_cast<unsigned int>(
+				std::min<size_t>(rowCount - upload.row, (TEXTURE_UPLOAD_BUDGET - used) / rowBytes));
+		if (rows == 0)
+			break; // Orçamento do quadro esgotado
+
+		std::memcpy(staging + used, upload.view.pixels + lv.offset + upload.row * rowBytes, rows * rowBytes);
+		unsigned int y = upload.row * rowHeight;
+		slices.push_back(Slice{texture.texture, static_cast<GLint>(upload.level), static_cast<GLint>(y),
+													 static_cast<GLsizei>(lv.width), static_cast<GLsizei>(std::min(rows * rowHeight, lv.height - y)),
+													 format, raw ? (upload.view.channels == 3 ? GLenum(GL_RGB) : GLenum(GL_RGBA)) : compressedFormat(format),
+													 used, rows * rowBytes});
+		used += rows * rowBytes;
+		upload.row += rows;
+
+		if (upload.row == rowCount)
+		{
+			upload.row = 0;
+			if (++upload.level == upload.view.levelCount)
+			{
+				texture.state = TextureState::Ready; // Os comandos abaixo precedem qualquer desenho
+				uploads.pop_front();								 // Libera os pixels da CPU
+			}
+		}
+	}
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Linhas RGB não são múltiplas de 4 bytes
+	for (const Slice &slice : slices)
+	{
+		glBindTexture(GL_TEXTURE_2D, slice.texture);
+		if (slice.format == TextureFormat::Raw)
+			glTexSubImage2D(GL_TEXTURE_2D, slice.level, 0, slice.y, slice.width, slice.height, slice.glFormat,
+											GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid *>(slice.offset));
+		else
+			glCompressedTexSubImage2D(GL_TEXTURE_2D, slice.level, 0, slice.y, slice.width, slice.height, slice.glFormat,
+																static_cast<GLsizei>(slice.size), reinterpret_cast<const GLvoid *>(slice.offset));
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::update()
+ *****************************************************************************************/
+bool TextureRegistry::update()
+{
+	Decoded result;
+	while (decoded.pop(result))
+	{
+		--inFlight;
+		finishDecode(result);
+	}
+
+	uploadSlices();
+	return inFlight == 0 && uploads.empty();
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::texture()
+ *****************************************************************************************/
+TextureId TextureRegistry::resolve(TextureId id) const
+{
+	while (entries[id].alias != INVALID_TEXTURE)
+		id = entries[id].alias;
+	return id;
+}
+
+GLuint TextureRegistry::texture(TextureId id) const
+{
+	if (id >= entries.size() || entries[id].refCount == 0)
+		return 0;
+
+	const SharedTexture &texture = entries[resolve(id)];
+	switch (texture.state)
+	{
+	case TextureState::Ready:
+		return texture.texture;
+	case TextureState::Failed:
+		return 0;
+	default:
+		return placeholder;
+	}
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::release()
+ *****************************************************************************************/
+void TextureRegistry::release(TextureId id)
+{
+	if (id >= entries.size() || entries[id].refCount == 0)
+		return;
+
+	SharedTexture &texture = entries[id];
+	if (--texture.refCount != 0)
+		return;
+
+	TextureId alias = texture.alias;
+	if (texture.texture != 0)
+		glDeleteTextures(1, &texture.texture);
+
+	/* Cancela um envio em andamento e remove caminhos/hashes que apontavam para este slot */
+	uploads.erase(std::remove_if(uploads.begin(), uploads.end(), [id](const Upload &upload)
+															 { return upload.id == id; }),
+								uploads.end());
+	for (auto it = byPath.begin(); it != byPath.end();)
+		it = (it->second == id) ? byPath.erase(it) : std::next(it);
+	for (auto it = bySource.begin(); it != bySource.end();)
+		it = (it->second == id) ? bySource.erase(it) : std::next(it);
+	for (auto it = byPixels.begin(); it != byPixels.end();)
+		it = (it->second == id) ? byPixels.erase(it) : std::next(it);
+
+	/* Nova geração: uma decodificação ainda em andamento para este slot será descartada */
+	unsigned int generation = texture.generation + 1;
+	texture = SharedTexture{};
+	texture.generation = generation;
+
+	if (alias != INVALID_TEXTURE)
+		release(alias);
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::invalidate()
+ *****************************************************************************************/
+void TextureRegistry::invalidate(const std::string &imagePath)
+{
+	byPath.erase(canonicalPath(imagePath));
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::clear()
+ *  --------------------------------------------------------------------------------------
+ *  Espera as decodificações ainda nas threads de trabalho e descarta os resultados: assim
+ *  inFlight volta a zero e nenhum resultado antigo chega a um update() posterior.
+ *****************************************************************************************/
+void TextureRegistry::clear()
+{
+	Decoded result;
+	while (inFlight != 0)
+	{
+		if (decoded.pop(result))
+			--inFlight;
+		else
+			std::this_thread::yield();
+	}
+
+	for (SharedTexture &texture : entries)
+		if (texture.texture != 0)
+			glDeleteTextures(1, &texture.texture);
+	if (placeholder != 0)
+		glDeleteTextures(1, &placeholder);
+	if (pbo != 0)
+		glDeleteBuffers(1, &pbo);
+	placeholder = pbo = 0;
+
+	uploads.clear();
+	entries.clear();
+	byPath.clear();
+	bySource.clear();
+	byPixels.clear();
+}
+
+/*****************************************************************************************
+ *  TextureRegistry::printStats()
+ *****************************************************************************************/
+void TextureRegistry::printStats() const
+{
+	unsigned int unique = 0;
+	size_t bytes = 0;
+	for (const SharedTexture &texture : entries)
+		if (texture.refCount != 0 && texture.texture != 0)
+		{
+			++unique;
+			bytes += texture.gpuBytes;
+		}
+
+	std::cout << "Texturas: " << pathHits + sourceHits + pixelHits << " acerto(s) (" << pathHits << " caminho, "
+						<< sourceHits << " arquivo, " << pixelHits << " pixels), " << misses << " falta(s), " << failures
+						<< " falha(s), " << unique << " unica(s), " << bytes / (1024.0 * 1024.0) << " MB na GPU" << std::endl;
+}
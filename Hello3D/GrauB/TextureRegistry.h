@@ -0,0 +1,136 @@
+// TextureRegistry.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <deque>				 // Fila de envios para a GPU
+#include <memory>				 // std::shared_ptr
+#include <string>				 // Necessário para usar std::string
+#include <unordered_map> // Índices por caminho e por conteúdo
+#include <vector>				 // Necessário para usar std::vector
+
+#include <glad/glad.h> // Tipos OpenGL (GLuint, GLenum...)
+
+#include "AssetCache.h"		 // AssetBlob / TextureView
+#include "LockFreeQueue.h" // Resultados das threads de trabalho
+#include "ThreadPool.h"		 // Decodificação fora da thread do OpenGL
+
+// Bytes copiados para o PBO (e enviados com glTex[Compressed]SubImage2D) por quadro, somando todas as texturas
+const size_t TEXTURE_UPLOAD_BUDGET = 4 * 1024 * 1024;
+
+// Estado de uma textura registrada
+enum class TextureState
+{
+	Decoding,	 // Na fila / decodificando em uma thread de trabalho (usa o placeholder)
+	Uploading, // Pixels prontos, sendo enviados em fatias via PBO (usa o placeholder)
+	Ready,		 // Textura completa na GPU
+	Failed		 // Imagem não pôde ser lida (textura 0)
+};
+
+// Textura compartilhada por todos os materiais que usam a mesma imagem
+struct SharedTexture
+{
+	std::string path;							 // Caminho canônico da imagem
+	unsigned long long sourceHash; // Hash do arquivo (bytes do PNG/JPG)
+	unsigned long long pixelHash;	 // Hash dos pixels decodificados (nível 0)
+	TextureState state;						 // Etapa da carga assíncrona
+	unsigned int alias;						 // Outro slot com o mesmo conteúdo (~0u = nenhum)
+	unsigned int generation;			 // Muda a cada reuso do slot (descarta resultados antigos)
+	GLuint texture;								 // Objeto de textura OpenGL (0 até o envio começar)
+	unsigned int width, height;		 // Dimensões do nível 0
+	size_t gpuBytes;							 // Tamanho de todos os níveis de mipmap
+	unsigned int refCount;				 // Malhas que ainda usam esta textura (0 = slot livre)
+};
+
+// Identificador de uma textura registrada (índice estável enquanto refCount > 0)
+typedef unsigned int TextureId;
+const TextureId INVALID_TEXTURE = ~0u;
+
+// Registro de texturas: cada imagem vira um único objeto de textura na GPU. A busca é feita,
+// em ordem, pelo caminho canônico, pelo hash do arquivo e pelo hash dos pixels decodificados
+// (a mesma imagem salva em outro formato ou com outros metadados).
+//
+// A carga é assíncrona: acquire() só registra o pedido; a decodificação roda no ThreadPool e
+// update(), chamado uma vez por quadro na thread do OpenGL, envia os pixels em fatias de até
+// TEXTURE_UPLOAD_BUDGET bytes por um PBO. Até lá, texture() devolve uma textura placeholder.
+class TextureRegistry
+{
+private:
+	// Resultado de uma decodificação, entregue pela thread de trabalho
+	struct Decoded
+	{
+		TextureId id;
+		unsigned int generation;
+		bool ok;
+		unsigned long long sourceHash, pixelHash;
+		std::shared_ptr<AssetBlob> blob; // Mantém os pixels vivos até o fim do envio
+		TextureView view;
+	};
+
+	// Envio em andamento: próxima linha do próximo nível a copiar
+	struct Upload
+	{
+		TextureId id;
+		std::shared_ptr<AssetBlob> blob;
+		TextureView view;
+		unsigned int level, row;
+	};
+
+	std::vector<SharedTexture> entries;												 // Slots (reaproveitados após liberação)
+	std::unordered_map<std::string, TextureId> byPath;				 // Caminho canônico -> slot
+	std::unordered_map<unsigned long long, TextureId> bySource; // Hash do arquivo -> slot
+	std::unordered_map<unsigned long long, TextureId> byPixels; // Hash dos pixels -> slot
+	unsigned int pathHits = 0, sourceHits = 0, pixelHits = 0, misses = 0, failures = 0;
+	bool compress; // Envia blocos BC1/BC3 em vez de texels crus
+
+	LockFreeQueue<Decoded> decoded; // Resultados ainda não processados pela thread do OpenGL
+	unsigned int inFlight = 0;			// Tarefas enviadas e ainda não processadas
+	std::deque<Upload> uploads;			// Envios em andamento (FIFO)
+	GLuint placeholder = 0, pbo = 0; // Textura 1x1 branca e pixel buffer object de streaming
+
+	// Último membro: é destruído primeiro, e as tarefas ainda na fila usam os membros acima
+	ThreadPool workers; // Decodificação (stb_image / cache de assets)
+
+	TextureId resolve(TextureId id) const;
+	bool reserve(const std::string &imagePath, TextureId &id);
+	void finishDecode(Decoded &result);
+	void uploadSlices();
+
+public:
+	// compress = true: texturas em BC1/BC3 (só se o contexto suportar S3TC; ver hasGLExtension)
+	explicit TextureRegistry(bool compress = false) : compress(compress) {}
+	~TextureRegistry() { clear(); }
+
+	// Os objetos OpenGL pertencem ao registro: não pode ser copiado
+	TextureRegistry(const TextureRegistry &) = delete;
+	TextureRegistry &operator=(const TextureRegistry &) = delete;
+
+	// Registra o uso da imagem e incrementa a contagem de referências. Não bloqueia: a
+	// decodificação é enfileirada e a textura fica disponível em algum update() futuro.
+	// Caminho vazio (material sem map_Kd) devolve INVALID_TEXTURE sem carregar nada
+	TextureId acquire(const std::string &imagePath);
+
+	// Igual, para pixels já decodificados (ex.: de um SceneBundle): entra direto na fila de
+	// envio, com a mesma deduplicação. "blob" mantém "view" válida até o fim do envio
+	TextureId acquire(const std::string &imagePath, unsigned long long sourceHash, unsigned long long pixelHash,
+										const TextureView &view, std::shared_ptr<AssetBlob> blob);
+
+	// Decrementa a contagem de referências; a última liberação apaga a textura
+	void release(TextureId id);
+
+	// Esquece o caminho (a imagem mudou no disco): o próximo acquire() a decodifica de novo.
+	// Quem já tem a textura antiga continua com ela até liberá-la
+	void invalidate(const std::string &imagePath);
+
+	// Textura a ser usada agora: a real, o placeholder (ainda carregando) ou 0 (falha)
+	GLuint texture(TextureId id) const;
+
+	// Processa decodificações concluídas e envia a próxima fatia de pixels para a GPU.
+	// Devolve true quando não há mais nada pendente
+	bool update();
+
+	// Espera e descarta as decodificações pendentes e apaga todas as texturas, o placeholder e
+	// o PBO (chamar antes de destruir o contexto OpenGL)
+	void clear();
+
+	// Imprime acertos por caminho / arquivo / pixels, faltas e memória de GPU ocupada
+	void printStats() const;
+};
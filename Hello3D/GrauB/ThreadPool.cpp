@@ -0,0 +1,54 @@
+// ThreadPool.cpp
+#include "ThreadPool.h" // Inclui o arquivo de cabeçalho do conjunto de threads
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+	if (threadCount == 0)
+	{
+		unsigned cores = std::thread::hardware_concurrency();
+		threadCount = cores > 1 ? cores - 1 : 1;
+	}
+
+	workers.reserve(threadCount);
+	for (unsigned t = 0; t < threadCount; ++t)
+		workers.emplace_back(&ThreadPool::run, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	available.notify_all();
+	for (std::thread &worker : workers)
+		worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	available.notify_one();
+}
+
+/* Laço de cada thread: pega a próxima tarefa ou dorme até haver uma */
+void ThreadPool::run()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			available.wait(lock, [this]
+										 { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return; // stopping e nada mais a fazer
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,39 @@
+// ThreadPool.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <condition_variable> // Espera por tarefas
+#include <deque>							// Fila de tarefas
+#include <functional>					// std::function
+#include <mutex>							// Proteção da fila
+#include <thread>							// Threads de trabalho
+#include <vector>							// Necessário para usar std::vector
+
+// Conjunto fixo de threads que executam tarefas em ordem de chegada (FIFO).
+// Usado para trabalho de CPU que não toca no contexto OpenGL (decodificar imagens, etc.).
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;					 // Threads de trabalho
+	std::deque<std::function<void()>> tasks;	 // Tarefas ainda não iniciadas
+	std::mutex mutex;													 // Protege "tasks" e "stopping"
+	std::condition_variable available;				 // Sinaliza nova tarefa (ou encerramento)
+	bool stopping = false;										 // true no destrutor
+
+	void run();
+
+public:
+	// threadCount = 0: uma thread a menos que o número de núcleos (mínimo 1), deixando
+	// um núcleo livre para a thread do OpenGL
+	explicit ThreadPool(unsigned threadCount = 0);
+
+	// Conclui as tarefas já enfileiradas e encerra as threads
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// Enfileira uma tarefa; ela roda em alguma thread de trabalho assim que houver uma livre
+	void submit(std::function<void()> task);
+
+	unsigned size() const { return static_cast<unsigned>(workers.size()); }
+};
@@ -0,0 +1,32 @@
+// UniformBuffer.cpp
+#include "UniformBuffer.h" // Inclui o arquivo de cabeçalho dos buffers de blocos uniformes
+
+void UniformBuffer::create(GLuint bindingPoint, GLsizeiptr bytes, const void *data, GLenum bufferTarget)
+{
+	release();
+	target = bufferTarget;
+	binding = bindingPoint;
+	size = bytes;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(target, buffer);
+	glBufferData(target, size, data, GL_DYNAMIC_DRAW);
+	glBindBuffer(target, 0);
+	glBindBufferBase(target, binding, buffer);
+}
+
+/* glBufferSubData sobre o mesmo buffer: o driver copia os dados e os desenhos do quadro
+   anterior que ainda leem o conteúdo antigo não são afetados */
+void UniformBuffer::update(const void *data, GLsizeiptr bytes, GLintptr offset)
+{
+	glBindBuffer(target, buffer);
+	glBufferSubData(target, offset, bytes, data);
+	glBindBuffer(target, 0);
+}
+
+void UniformBuffer::release()
+{
+	if (buffer != 0)
+		glDeleteBuffers(1, &buffer);
+	buffer = 0;
+	size = 0;
+}
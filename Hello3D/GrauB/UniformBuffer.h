@@ -0,0 +1,52 @@
+// UniformBuffer.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <glad/glad.h> // Tipos OpenGL (GLuint, GLsizeiptr...)
+#include <glm/glm.hpp> // glm::vec3 / glm::mat4
+
+// Binding points fixos dos blocos uniformes, os mesmos em todos os programas
+const GLuint FRAME_UNIFORMS_BINDING = 0;
+
+// Bloco "FrameUniforms" dos shaders (layout std140): câmera e luz, escritas uma vez por
+// quadro e lidas por todos os programas. Cada vec3 começa em um múltiplo de 16 bytes; o
+// float seguinte ocuparia os 4 bytes restantes, aqui só preenchimento
+struct FrameUniforms
+{
+	glm::mat4 view;				 // Deslocamento 0
+	glm::mat4 projection;	 // 64
+	glm::vec3 cameraPos;	 // 128
+	float padding0;
+	glm::vec3 lightPos;		 // 144
+	float padding1;
+	glm::vec3 lightColor;	 // 160
+	float padding2;
+};
+static_assert(sizeof(FrameUniforms) == 176, "FrameUniforms deve seguir o layout std140 do bloco nos shaders");
+
+// Buffer de um bloco uniforme (ou de armazenamento, com target = GL_SHADER_STORAGE_BUFFER)
+// ligado a um binding point fixo. O buffer fica ligado ao binding point enquanto existir; os
+// programas só precisam apontar o bloco para o mesmo binding (Shader::bindUniformBlock, ou
+// layout(binding) nos blocos de armazenamento). Sem destrutor: release() é chamado com o
+// contexto OpenGL ainda ativo
+class UniformBuffer
+{
+private:
+	GLuint buffer = 0;
+	GLenum target = GL_UNIFORM_BUFFER;
+	GLuint binding = 0;
+	GLsizeiptr size = 0;
+
+public:
+	// Cria o buffer com size bytes (conteúdo inicial opcional) e o liga a binding
+	// (glBindBufferBase); um buffer anterior é apagado
+	void create(GLuint bindingPoint, GLsizeiptr bytes, const void *data = nullptr, GLenum bufferTarget = GL_UNIFORM_BUFFER);
+
+	// Substitui os bytes [offset, offset + bytes) do buffer
+	void update(const void *data, GLsizeiptr bytes, GLintptr offset = 0);
+
+	void release();
+
+	GLuint getId() const { return buffer; }
+	GLuint getBinding() const { return binding; }
+	GLsizeiptr getSize() const { return size; }
+};
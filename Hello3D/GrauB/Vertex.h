@@ -0,0 +1,11 @@
+// Vertex.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+// Vértice em float, como sai dos carregadores. Na GPU ele é empacotado conforme
+// MeshVertexLayout (VertexLayout.h)
+struct Vertex
+{
+	float x, y, z;		// Posição do vértice
+	float s, t;				// Coordenadas de textura
+	float nx, ny, nz; // Vetor normal
+};
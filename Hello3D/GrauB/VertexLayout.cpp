@@ -0,0 +1,109 @@
+// VertexLayout.cpp
+#include "VertexLayout.h" // Inclui o arquivo de cabeçalho dos layouts de vértice
+
+#include <algorithm> // std::min / std::max
+#include <cmath>		 // std::fabs
+#include <cstring>	 // std::memcpy
+#include <iostream>	 // Avisos no console
+
+#include <glm/gtc/packing.hpp> // packUnorm1x16 / packSnorm1x16 / packHalf1x16
+
+/*****************************************************************************************
+ *  computeVertexBounds()
+ *****************************************************************************************/
+VertexBounds computeVertexBounds(const Vertex *vertices, size_t count)
+{
+	VertexBounds bounds{};
+	if (count == 0)
+		return bounds;
+
+	float lo[3] = {vertices[0].x, vertices[0].y, vertices[0].z};
+	float hi[3] = {lo[0], lo[1], lo[2]};
+	for (size_t i = 1; i < count; ++i)
+	{
+		const float p[3] = {vertices[i].x, vertices[i].y, vertices[i].z};
+		for (int a = 0; a < 3; ++a)
+		{
+			lo[a] = std::min(lo[a], p[a]);
+			hi[a] = std::max(hi[a], p[a]);
+		}
+	}
+	for (int a = 0; a < 3; ++a)
+	{
+		bounds.offset[a] = lo[a];
+		bounds.scale[a] = hi[a] - lo[a];
+	}
+	return bounds;
+}
+
+void reportUnusedAttribute(const char *name, const std::string &label)
+{
+	std::cout << "Aviso: o atributo \"" << name << "\" do layout de vertice nao e usado por " << label
+						<< " (ocupa o VBO sem necessidade)" << std::endl;
+}
+
+/* Copia "count" componentes de 16 bits para "out" (que pode estar desalinhado) */
+static void store16(unsigned char *out, const unsigned short *values, size_t count)
+{
+	std::memcpy(out, values, count * sizeof(unsigned short));
+}
+
+/*****************************************************************************************
+ *  Codificações
+ *****************************************************************************************/
+void PositionFloat::encode(const Vertex &vertex, const VertexBounds &, unsigned char *out)
+{
+	const float p[3] = {vertex.x, vertex.y, vertex.z};
+	std::memcpy(out, p, sizeof(p));
+}
+
+void PositionUnorm16::encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out)
+{
+	const float p[3] = {vertex.x, vertex.y, vertex.z};
+	unsigned short q[4] = {0, 0, 0, 0}; // O quarto é só alinhamento
+	for (int a = 0; a < 3; ++a)
+		if (bounds.scale[a] > 0.0f)
+			q[a] = glm::packUnorm1x16((p[a] - bounds.offset[a]) / bounds.scale[a]);
+	store16(out, q, 4);
+}
+
+void TexCoordFloat::encode(const Vertex &vertex, const VertexBounds &, unsigned char *out)
+{
+	const float uv[2] = {vertex.s, vertex.t};
+	std::memcpy(out, uv, sizeof(uv));
+}
+
+void TexCoordHalf::encode(const Vertex &vertex, const VertexBounds &, unsigned char *out)
+{
+	const unsigned short uv[2] = {glm::packHalf1x16(vertex.s), glm::packHalf1x16(vertex.t)};
+	store16(out, uv, 2);
+}
+
+void NormalFloat::encode(const Vertex &vertex, const VertexBounds &, unsigned char *out)
+{
+	const float n[3] = {vertex.nx, vertex.ny, vertex.nz};
+	std::memcpy(out, n, sizeof(n));
+}
+
+/* Normal -> octaedro |x|+|y|+|z| = 1; o hemisfério z < 0 é dobrado para fora do losango.
+   Normal nula (.obj sem "vn") vira (0, 0), que decodifica como +Z */
+void NormalOct16::encode(const Vertex &vertex, const VertexBounds &, unsigned char *out)
+{
+	float length = std::fabs(vertex.nx) + std::fabs(vertex.ny) + std::fabs(vertex.nz);
+	float x = 0.0f, y = 0.0f;
+	if (length > 0.0f)
+	{
+		x = vertex.nx / length;
+		y = vertex.ny / length;
+		if (vertex.nz < 0.0f)
+		{
+			float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = fx;
+			y = fy;
+		}
+	}
+	const unsigned short e[2] = {static_cast<unsigned short>(glm::packSnorm1x16(x)),
+															 static_cast<unsigned short>(glm::packSnorm1x16(y))};
+	store16(out, e, 2);
+}
@@ -0,0 +1,221 @@
+// VertexLayout.h
+#pragma once // Garante que este arquivo de cabeçalho seja incluído apenas uma vez durante a compilação
+
+#include <cstddef> // size_t
+#include <string>	 // Necessário para usar std::string
+
+#include <glad/glad.h> // glVertexAttribPointer / tipos OpenGL
+
+#include "Vertex.h" // Vértice em float (formato dos carregadores)
+
+// Caixa envolvente das posições de uma geometria: posições quantizadas são frações dela
+struct VertexBounds
+{
+	float offset[3]; // Canto mínimo
+	float scale[3];	 // Tamanho em cada eixo (0 = geometria achatada nesse eixo)
+};
+
+// Caixa envolvente de "count" vértices (tudo zero se não houver nenhum)
+VertexBounds computeVertexBounds(const Vertex *vertices, size_t count);
+
+// Aviso de VertexLayout::reportUnused() (fora do template para não repetir o texto em cada layout)
+void reportUnusedAttribute(const char *name, const std::string &label);
+
+/*
+ * Codificações de atributo. Cada uma define:
+ *   size                     bytes no VBO (múltiplo de 4, mantém os atributos alinhados)
+ *   type / count / normalized  argumentos de glVertexAttribPointer
+ *   name / glslType          entrada do vertex shader
+ *   glslDecode               entradas extras e função GLSL que devolvem o valor em float
+ *   encode()                 conversão a partir do Vertex
+ * O vertex shader só usa vertexPosition(), vertexTexCoord() e vertexNormal(): trocar a
+ * codificação não exige mexer no .vs.
+ */
+struct PositionFloat
+{
+	static constexpr unsigned id = 1;
+	static constexpr size_t size = 12;
+	static constexpr GLenum type = GL_FLOAT;
+	static constexpr GLint count = 3;
+	static constexpr GLboolean normalized = GL_FALSE;
+	static constexpr const char *name = "position";
+	static constexpr const char *glslType = "vec3";
+	static constexpr const char *glslDecode = "vec3 vertexPosition() { return position; }\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+// 3 x unorm16 relativos à caixa envolvente (+2 bytes de alinhamento)
+struct PositionUnorm16
+{
+	static constexpr unsigned id = 2;
+	static constexpr size_t size = 8;
+	static constexpr GLenum type = GL_UNSIGNED_SHORT;
+	static constexpr GLint count = 3;
+	static constexpr GLboolean normalized = GL_TRUE;
+	static constexpr const char *name = "position";
+	static constexpr const char *glslType = "vec3";
+	static constexpr const char *glslDecode =
+			"layout (location = 9) in vec3 positionOffset;\n"	// Por instância: INSTANCE_BOUNDS_LOCATION
+			"layout (location = 10) in vec3 positionScale;\n"	// (InstanceBuffer.h), a caixa da geometria
+			"vec3 vertexPosition() { return positionOffset + positionScale * position; }\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+struct TexCoordFloat
+{
+	static constexpr unsigned id = 3;
+	static constexpr size_t size = 8;
+	static constexpr GLenum type = GL_FLOAT;
+	static constexpr GLint count = 2;
+	static constexpr GLboolean normalized = GL_FALSE;
+	static constexpr const char *name = "texCoord";
+	static constexpr const char *glslType = "vec2";
+	static constexpr const char *glslDecode = "vec2 vertexTexCoord() { return texCoord; }\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+// 2 x half float (aceita coordenadas fora de [0, 1], ex.: texturas repetidas)
+struct TexCoordHalf
+{
+	static constexpr unsigned id = 4;
+	static constexpr size_t size = 4;
+	static constexpr GLenum type = GL_HALF_FLOAT;
+	static constexpr GLint count = 2;
+	static constexpr GLboolean normalized = GL_FALSE;
+	static constexpr const char *name = "texCoord";
+	static constexpr const char *glslType = "vec2";
+	static constexpr const char *glslDecode = "vec2 vertexTexCoord() { return texCoord; }\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+struct NormalFloat
+{
+	static constexpr unsigned id = 5;
+	static constexpr size_t size = 12;
+	static constexpr GLenum type = GL_FLOAT;
+	static constexpr GLint count = 3;
+	static constexpr GLboolean normalized = GL_FALSE;
+	static constexpr const char *name = "normal";
+	static constexpr const char *glslType = "vec3";
+	static constexpr const char *glslDecode = "vec3 vertexNormal() { return normal; }\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+// Octaedro em 2 x snorm16: a esfera unitária é projetada no octaedro e desdobrada no quadrado
+struct NormalOct16
+{
+	static constexpr unsigned id = 6;
+	static constexpr size_t size = 4;
+	static constexpr GLenum type = GL_SHORT;
+	static constexpr GLint count = 2;
+	static constexpr GLboolean normalized = GL_TRUE;
+	static constexpr const char *name = "normal";
+	static constexpr const char *glslType = "vec2";
+	static constexpr const char *glslDecode =
+			"vec3 vertexNormal() {\n"
+			"    vec3 n = vec3(normal, 1.0 - abs(normal.x) - abs(normal.y));\n"
+			"    float t = max(-n.z, 0.0);\n"
+			"    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);\n"
+			"    return normalize(n);\n"
+			"}\n";
+	static void encode(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out);
+};
+
+// Um atributo do layout: posição no shader (location) + codificação
+template <GLuint Location, typename Encoding>
+struct VertexAttribute
+{
+	static constexpr GLuint location = Location;
+	typedef Encoding Format;
+
+	static_assert(Encoding::size % 4 == 0, "atributos devem manter o alinhamento de 4 bytes");
+};
+
+// Layout intercalado de um VBO, descrito em tempo de compilação. A mesma lista de atributos
+// gera os vértices empacotados (pack), as chamadas glVertexAttribPointer (enable) e as
+// entradas do vertex shader (glsl), então os três não têm como divergir. Atributos fora da
+// lista simplesmente não existem no VBO.
+template <typename... Attributes>
+class VertexLayout
+{
+private:
+	template <typename Attribute>
+	static void enableAttribute(size_t &offset)
+	{
+		typedef typename Attribute::Format F;
+		glVertexAttribPointer(Attribute::location, F::count, F::type, F::normalized, static_cast<GLsizei>(stride),
+													reinterpret_cast<GLvoid *>(offset));
+		glEnableVertexAttribArray(Attribute::location);
+		offset += F::size;
+	}
+
+	template <typename Attribute>
+	static void packAttribute(const Vertex &vertex, const VertexBounds &bounds, unsigned char *out, size_t &offset)
+	{
+		Attribute::Format::encode(vertex, bounds, out + offset);
+		offset += Attribute::Format::size;
+	}
+
+	template <typename Attribute>
+	static void declareAttribute(std::string &out)
+	{
+		typedef typename Attribute::Format F;
+		out += "layout (location = " + std::to_string(Attribute::location) + ") in " + F::glslType + " " + F::name + ";\n";
+		out += F::glslDecode;
+	}
+
+public:
+	// Bytes por vértice
+	static constexpr size_t stride = (Attributes::Format::size + ...);
+
+	// Identifica o layout nos arquivos (cache / pacote): outro layout = outros bytes
+	static constexpr unsigned int signature()
+	{
+		unsigned int hash = 2166136261u;
+		((hash = (hash ^ (Attributes::location * 16 + Attributes::Format::id)) * 16777619u), ...);
+		return hash;
+	}
+
+	// Converte "count" vértices para o layout (out precisa de count * stride bytes)
+	static void pack(const Vertex *vertices, size_t count, const VertexBounds &bounds, unsigned char *out)
+	{
+		for (size_t i = 0; i < count; ++i, out += stride)
+		{
+			size_t offset = 0;
+			(packAttribute<Attributes>(vertices[i], bounds, out, offset), ...);
+		}
+	}
+
+	// Configura os atributos no VAO e no GL_ARRAY_BUFFER vinculados
+	static void enable()
+	{
+		size_t offset = 0;
+		(enableAttribute<Attributes>(offset), ...);
+	}
+
+	// Entradas e funções de decodificação, inseridas no vertex shader logo após o #version
+	static std::string glsl()
+	{
+		std::string out;
+		(declareAttribute<Attributes>(out), ...);
+		return out;
+	}
+
+	// Imprime um aviso para cada atributo que o programa não usa (ocupa o VBO à toa)
+	static void reportUnused(GLuint program, const std::string &label)
+	{
+		const char *names[] = {Attributes::Format::name...};
+		for (const char *name : names)
+			if (glGetAttribLocation(program, name) < 0)
+				reportUnusedAttribute(name, label);
+	}
+};
+
+// Layout dos VBOs das malhas: 16 bytes por vértice (posição 8, texcoord 4, normal 4).
+// Em float seria VertexLayout<VertexAttribute<0, PositionFloat>, VertexAttribute<1,
+// TexCoordFloat>, VertexAttribute<2, NormalFloat>> (32 bytes). A cor do Vertex antigo nenhum
+// material usava: não faz parte do layout.
+typedef VertexLayout<VertexAttribute<0, PositionUnorm16>,
+										 VertexAttribute<1, TexCoordHalf>,
+										 VertexAttribute<2, NormalOct16>>
+		MeshVertexLayout;
@@ -2,8 +2,14 @@
 
 layout(location = 0) in vec3 position;
 
-uniform mat4 view;
-uniform mat4 projection;
+// Constantes do quadro: o mesmo bloco do Object.vs
+layout(std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPos;
+    vec3 lightPos;
+    vec3 lightColor;
+};
 
 void main() {
 	gl_Position = projection * view * vec4(position, 1.0f);
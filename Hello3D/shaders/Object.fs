@@ -2,19 +2,32 @@
 
 in vec3 fragPos;
 in vec2 finalTexCoord;
-in vec4 finalColor;
 in vec3 scaledNormal;
+flat in vec3 extraColor;
+flat in int materialIndex;
+flat in int skipLighting;
 
 uniform sampler2D tex;
-uniform float kaR, kaG, kaB;
-uniform float kdR, kdG, kdB;
-uniform float ksR, ksG, ksB;
-uniform float ns;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 cameraPos;
-uniform vec3 extraColor;
-uniform int skipLighting;
+
+// Constantes do quadro: o mesmo bloco do Object.vs
+layout(std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPos;
+    vec3 lightPos;
+    vec3 lightColor;
+};
+
+// Todos os materiais da cena (GpuMaterial em MaterialTable.h): xyz = Ka / Kd / Ks, specular.w = Ns.
+// MATERIAL_TABLE_BINDING vem do C++ (materialTableGlsl()); o array cresce com a cena
+struct MaterialData {
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+};
+layout(std430, binding = MATERIAL_TABLE_BINDING) readonly buffer MaterialTable {
+    MaterialData materials[];
+};
 
 out vec4 color;
 
@@ -24,16 +37,17 @@ void main() {
         color = vec4(mix(vec3(finalTexture), extraColor, 0.2), 1.0); 
     }
     else {
-        vec3 ambient = vec3(kaR, kaG, kaB) * lightColor;
+        MaterialData material = materials[materialIndex];
+        vec3 ambient = material.ambient.xyz * lightColor;
         vec3 N = normalize(scaledNormal);
         vec3 L = normalize(lightPos - fragPos);
         float diff = max(dot(N, L), 0.0);
-        vec3 diffuse = vec3(kdR, kdG, kdB) * diff * lightColor;
+        vec3 diffuse = material.diffuse.xyz * diff * lightColor;
         vec3 V = normalize(cameraPos - fragPos);
         vec3 R = normalize(reflect(-L, N));
         float spec = max(dot(R, V), 0.0);
-        spec = pow(spec, ns);
-        vec3 specular = vec3(ksR, ksG, ksB) * spec * lightColor;
+        spec = pow(spec, material.specular.w);
+        vec3 specular = material.specular.xyz * spec * lightColor;
         vec4 finalTexture = texture(tex, finalTexCoord);
         vec3 result = (ambient + diffuse) * vec3(finalTexture) + specular;
         color = vec4(mix(result, extraColor, 0.2), 1.0);
@@ -1,23 +1,37 @@
 #version 450 core
 
-layout (location = 0) in vec3 position;
-layout (location = 1) in vec2 texCoord;
-layout (location = 2) in vec3 color;
-layout (location = 3) in vec3 normal;
+// As entradas e as funcoes vertexPosition(), vertexTexCoord() e vertexNormal() sao inseridas
+// pelo programa logo apos o #version, geradas a partir de MeshVertexLayout (VertexLayout.h)
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Por instancia (InstanceData em InstanceBuffer.h): um objeto de um desenho instanciado
+layout(location = 3) in mat4 model;
+layout(location = 7) in vec3 instanceColor;
+layout(location = 8) in ivec2 instanceFlags; // Indice do material, sem iluminacao
+
+// Constantes do quadro (FrameUniforms em UniformBuffer.h, binding FRAME_UNIFORMS_BINDING):
+// escritas uma vez por quadro e compartilhadas por todos os programas
+layout(std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPos;
+    vec3 lightPos;
+    vec3 lightColor;
+};
 
 out vec3 fragPos;
-out vec4 finalColor;
 out vec2 finalTexCoord;
 out vec3 scaledNormal;
+flat out vec3 extraColor;
+flat out int materialIndex;
+flat out int skipLighting;
 
 void main() {
-    gl_Position = projection * view * model * vec4(position, 1.0);
-    fragPos = vec3(model * vec4(position, 1.0));
-    finalColor = vec4(color, 1.0);
-    finalTexCoord = texCoord;
-    scaledNormal = mat3(transpose(inverse(model))) * normal;
+    vec3 localPosition = vertexPosition();
+    gl_Position = projection * view * model * vec4(localPosition, 1.0);
+    fragPos = vec3(model * vec4(localPosition, 1.0));
+    finalTexCoord = vertexTexCoord();
+    scaledNormal = mat3(transpose(inverse(model))) * vertexNormal();
+    extraColor = instanceColor;
+    materialIndex = instanceFlags.x;
+    skipLighting = instanceFlags.y;
 }
\ No newline at end of file